@@ -0,0 +1,125 @@
+// Decoder for messages from the Rocket League GameStatePlugin.
+// Layout and ids are defined in plugin/src/WireProtocol.h.
+
+// Sec-WebSocket-Protocol tokens offered by the plugin
+const BINARY_PROTOCOL = 'gamestate.bin.v1';
+const JSON_PROTOCOL = 'gamestate.json.v1';          // states only
+const JSON_EVENTS_PROTOCOL = 'gamestate.json.v2';   // states, events and perf
+
+const WIRE_MAGIC = 0x47;
+const WIRE_VERSION = 1;
+const WIRE_HEADER_SIZE = 6;
+
+const MESSAGE_STATE = 1;
+const MESSAGE_EVENT = 2;
+
+// Event ids (WireEventId in the plugin)
+const EVENT_PHASE = 1;
+
+// Index = state id (GameState enum order in the plugin)
+const STATE_NAMES = ['inMenu', 'inGame', 'inReplay', 'gamePaused', 'unknown'];
+
+// Index = phase id (MatchPhase enum order, plugin/src/MatchPhase.h)
+const PHASE_NAMES = [
+  'menu', 'countdown', 'kickoff', 'live', 'overtime',
+  'goalScored', 'replay', 'paused', 'postGame', 'unknown'
+];
+
+// Pick a subprotocol for the plugin's offer. Pass as `handleProtocols`
+// to a `ws` WebSocketServer: (protocols: Set<string>) => string | false
+function selectGameStateProtocol(protocols) {
+  if (protocols.has(BINARY_PROTOCOL)) return BINARY_PROTOCOL;
+  if (protocols.has(JSON_EVENTS_PROTOCOL)) return JSON_EVENTS_PROTOCOL;
+  if (protocols.has(JSON_PROTOCOL)) return JSON_PROTOCOL;
+  return false;
+}
+
+// LEB128 varint at `offset`; returns { value, offset } (value as a BigInt
+// only when it exceeds Number.MAX_SAFE_INTEGER)
+function readVarint(buf, offset) {
+  let value = 0n;
+  let shift = 0n;
+  for (;;) {
+    if (offset >= buf.length) throw new Error('Truncated varint');
+    const byte = buf[offset++];
+    value |= BigInt(byte & 0x7f) << shift;
+    if ((byte & 0x80) === 0) break;
+    shift += 7n;
+    if (shift > 63n) throw new Error('Varint too long');
+  }
+  const asNumber = value <= BigInt(Number.MAX_SAFE_INTEGER) ? Number(value) : value;
+  return { value: asNumber, offset };
+}
+
+function decodeBinary(buf) {
+  if (buf.length < WIRE_HEADER_SIZE) throw new Error('Message shorter than header');
+  if (buf[0] !== WIRE_MAGIC) throw new Error('Bad magic byte');
+  if (buf[1] !== WIRE_VERSION) throw new Error(`Unsupported version ${buf[1]}`);
+
+  const type = buf[2];
+  const sequence = buf[4] | (buf[5] << 8);
+  let offset = WIRE_HEADER_SIZE;
+
+  if (type === MESSAGE_STATE) {
+    const stateId = readVarint(buf, offset);
+    const timestamp = readVarint(buf, stateId.offset);
+    return {
+      type: 'state',
+      sequence,
+      state: STATE_NAMES[stateId.value] || 'unknown',
+      timestamp: timestamp.value
+    };
+  }
+
+  if (type === MESSAGE_EVENT) {
+    const eventId = readVarint(buf, offset);
+    const timestamp = readVarint(buf, eventId.offset);
+    const raw = readVarint(buf, timestamp.offset);
+    const zigzag = BigInt(raw.value);
+    const signed = (zigzag >> 1n) ^ -(zigzag & 1n);
+    const event = {
+      type: 'event',
+      sequence,
+      eventId: eventId.value,
+      timestamp: timestamp.value,
+      value: Number(signed)
+    };
+    if (event.eventId === EVENT_PHASE) event.phase = PHASE_NAMES[event.value] || 'unknown';
+    return event;
+  }
+
+  throw new Error(`Unknown message type ${type}`);
+}
+
+// Decode one WebSocket message from the plugin into
+//   { type: 'state', state, timestamp[, sequence] } or
+//   { type: 'event', eventId | event, value, timestamp[, sequence][, phase] } or
+//   { type: 'perf', sites: [{ site, kind, calls, p50Ns, p99Ns, maxNs }], windowMs, timestamp }
+// Perf messages (per-hook CPU cost, perf_stats_interval_ms) are always JSON.
+// `isBinary` is the flag `ws` passes to the 'message' handler.
+function decodeGameStateMessage(data, isBinary) {
+  if (isBinary) {
+    return decodeBinary(Buffer.isBuffer(data) ? data : Buffer.from(data));
+  }
+
+  const msg = JSON.parse(data.toString());
+  if (msg.perf !== undefined) {
+    return { type: 'perf', sites: msg.perf, windowMs: msg.windowMs, timestamp: msg.timestamp };
+  }
+  if (msg.event !== undefined) {
+    const event = { type: 'event', event: msg.event, value: msg.value, timestamp: msg.timestamp };
+    if (msg.event === 'phase') event.phase = PHASE_NAMES[msg.value] || 'unknown';
+    return event;
+  }
+  return { type: 'state', state: msg.state, timestamp: msg.timestamp };
+}
+
+module.exports = {
+  BINARY_PROTOCOL,
+  JSON_PROTOCOL,
+  JSON_EVENTS_PROTOCOL,
+  STATE_NAMES,
+  PHASE_NAMES,
+  selectGameStateProtocol,
+  decodeGameStateMessage
+};
@@ -0,0 +1,263 @@
+#pragma once
+
+// Minimal loopback WebSocket server used by the transport benchmarks.
+// Serves a single client on an ephemeral port from a background thread.
+
+#include "NetPlatform.h"
+#include "WebSocketHandshake.h"
+#include "Logger.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Route the client's log lines to /dev/null through the real logger, so
+// benchmarks pay the same logging cost as the plugin without the noise
+inline void quietClientLogs() {
+    Logger::start("/dev/null", false);
+}
+
+class BenchServer {
+public:
+    enum class Mode {
+        Echo,   // send every data frame back unmasked
+        Sink,   // count frames, never reply
+        Silent  // complete the handshake, then never read or write again (no pongs)
+    };
+
+    explicit BenchServer(Mode mode)
+        : mode(mode), listenSock(INVALID_SOCKET), clientSock(INVALID_SOCKET),
+          port(0), running(false), framesReceived(0), payloadBytesReceived(0) {
+        initSocketLibrary();
+    }
+
+    ~BenchServer() {
+        stop();
+    }
+
+    // Bind to 127.0.0.1 on an ephemeral port and start serving
+    bool start() {
+        listenSock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (listenSock == INVALID_SOCKET) return false;
+
+        int reuse = 1;
+        setsockopt(listenSock, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        if (bind(listenSock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) return false;
+        if (listen(listenSock, 1) != 0) return false;
+
+        socklen_t len = sizeof(addr);
+        getsockname(listenSock, reinterpret_cast<sockaddr*>(&addr), &len);
+        port = ntohs(addr.sin_port);
+
+        running = true;
+        thread = std::thread(&BenchServer::serve, this);
+        return true;
+    }
+
+    void stop() {
+        running = false;
+        if (clientSock != INVALID_SOCKET) {
+            shutdown(clientSock, 2);
+        }
+        if (listenSock != INVALID_SOCKET) {
+            shutdown(listenSock, 2);
+            closesocket(listenSock);
+            listenSock = INVALID_SOCKET;
+        }
+        if (thread.joinable()) {
+            thread.join();
+        }
+        if (clientSock != INVALID_SOCKET) {
+            closesocket(clientSock);
+            clientSock = INVALID_SOCKET;
+        }
+    }
+
+    std::string url() const {
+        return "ws://127.0.0.1:" + std::to_string(port) + "/";
+    }
+
+    // Called on the server thread with each unmasked data frame payload
+    // (set before start)
+    void setFrameCallback(std::function<void(const char* payload, size_t length)> callback) {
+        onFrame = std::move(callback);
+    }
+
+    // Subprotocol to select in the handshake response (none by default)
+    void setSubprotocol(const std::string& protocol) { subprotocol = protocol; }
+
+    std::uint64_t getFramesReceived() const { return framesReceived.load(); }
+    std::uint64_t getPayloadBytesReceived() const { return payloadBytesReceived.load(); }
+
+private:
+    Mode mode;
+    SocketHandle listenSock;
+    SocketHandle clientSock;
+    unsigned short port;
+    std::atomic<bool> running;
+    std::atomic<std::uint64_t> framesReceived;
+    std::atomic<std::uint64_t> payloadBytesReceived;
+    std::thread thread;
+    std::string subprotocol;
+    std::function<void(const char*, size_t)> onFrame;
+
+    std::vector<char> inbound;
+    size_t inboundOffset = 0;
+
+    bool readMore() {
+        char chunk[64 * 1024];
+        int n = recv(clientSock, chunk, sizeof(chunk), 0);
+        if (n <= 0) return false;
+        if (inboundOffset > 0) {
+            inbound.erase(inbound.begin(), inbound.begin() + inboundOffset);
+            inboundOffset = 0;
+        }
+        inbound.insert(inbound.end(), chunk, chunk + n);
+        return true;
+    }
+
+    bool ensure(size_t count) {
+        while (inbound.size() - inboundOffset < count) {
+            if (!running || !readMore()) return false;
+        }
+        return true;
+    }
+
+    bool sendAll(const char* data, size_t length) {
+        while (length > 0) {
+            int n = send(clientSock, data, (int)length, kSocketSendFlags);
+            if (n <= 0) return false;
+            data += n;
+            length -= (size_t)n;
+        }
+        return true;
+    }
+
+    bool handshake() {
+        std::string request;
+        while (request.find("\r\n\r\n") == std::string::npos) {
+            if (!readMore()) return false;
+            request.assign(inbound.begin(), inbound.end());
+        }
+        size_t headerEnd = request.find("\r\n\r\n") + 4;
+        inboundOffset = headerEnd;
+
+        std::string key;
+        size_t keyPos = request.find("Sec-WebSocket-Key: ");
+        if (keyPos != std::string::npos) {
+            keyPos += 19;
+            key = request.substr(keyPos, request.find("\r\n", keyPos) - keyPos);
+        }
+
+        std::string response =
+            "HTTP/1.1 101 Switching Protocols\r\n"
+            "Upgrade: websocket\r\n"
+            "Connection: Upgrade\r\n"
+            "Sec-WebSocket-Accept: " + computeWebSocketAccept(key) + "\r\n";
+        if (!subprotocol.empty()) {
+            response += "Sec-WebSocket-Protocol: " + subprotocol + "\r\n";
+        }
+        response += "\r\n";
+        return sendAll(response.data(), response.size());
+    }
+
+    void serve() {
+        clientSock = accept(listenSock, nullptr, nullptr);
+        if (clientSock == INVALID_SOCKET) return;
+        setSocketNoDelay(clientSock);
+
+        if (!handshake()) return;
+
+        if (mode == Mode::Silent) {
+            // Models a hung desktop app: the connection stays open until stop()
+            while (running) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            return;
+        }
+
+        std::string reply;
+        while (running) {
+            if (!ensure(2)) return;
+            const unsigned char* h = reinterpret_cast<const unsigned char*>(inbound.data() + inboundOffset);
+            unsigned char opcode = h[0] & 0x0F;
+            bool masked = (h[1] & 0x80) != 0;
+            std::uint64_t length = h[1] & 0x7F;
+            size_t headerSize = 2;
+
+            if (length == 126) {
+                if (!ensure(4)) return;
+                h = reinterpret_cast<const unsigned char*>(inbound.data() + inboundOffset);
+                length = ((std::uint64_t)h[2] << 8) | h[3];
+                headerSize = 4;
+            } else if (length == 127) {
+                if (!ensure(10)) return;
+                h = reinterpret_cast<const unsigned char*>(inbound.data() + inboundOffset);
+                length = 0;
+                for (int i = 0; i < 8; ++i) length = (length << 8) | h[2 + i];
+                headerSize = 10;
+            }
+
+            size_t maskOffset = headerSize;
+            if (masked) headerSize += 4;
+            if (!ensure(headerSize + (size_t)length)) return;
+
+            char* frame = inbound.data() + inboundOffset;
+            char* payload = frame + headerSize;
+            if (masked) {
+                const char* key = frame + maskOffset;
+                for (std::uint64_t i = 0; i < length; ++i) payload[i] ^= key[i & 3];
+            }
+            inboundOffset += headerSize + (size_t)length;
+
+            if (opcode == 0x8) {
+                // Answer the close with the client's status code, then hang up
+                reply.assign(1, (char)0x88);
+                reply.push_back((char)(length >= 2 ? 2 : 0));
+                reply.append(payload, length >= 2 ? 2 : 0);
+                sendAll(reply.data(), reply.size());
+                return;
+            }
+
+            if (opcode == 0x9) {
+                // Answer heartbeats with the same payload (control frames are < 126 bytes)
+                reply.assign(1, (char)0x8A);
+                reply.push_back((char)length);
+                reply.append(payload, (size_t)length);
+                if (!sendAll(reply.data(), reply.size())) return;
+                continue;
+            }
+            if (opcode == 0xA) continue;
+
+            if (onFrame) onFrame(payload, (size_t)length);
+            framesReceived.fetch_add(1);
+            payloadBytesReceived.fetch_add(length);
+
+            if (mode == Mode::Echo) {
+                reply.clear();
+                reply.push_back((char)(0x80 | opcode));
+                if (length < 126) {
+                    reply.push_back((char)length);
+                } else if (length < 65536) {
+                    reply.push_back((char)126);
+                    reply.push_back((char)((length >> 8) & 0xFF));
+                    reply.push_back((char)(length & 0xFF));
+                } else {
+                    reply.push_back((char)127);
+                    for (int i = 7; i >= 0; --i) reply.push_back((char)((length >> (i * 8)) & 0xFF));
+                }
+                reply.append(payload, (size_t)length);
+                if (!sendAll(reply.data(), reply.size())) return;
+            }
+        }
+    }
+};
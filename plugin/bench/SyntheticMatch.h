@@ -0,0 +1,90 @@
+#pragma once
+
+// Synthetic match for the telemetry benchmarks: a bouncing, spinning ball
+// and six cars driving circles at 120 Hz, jumping now and then.
+
+#include "TelemetryRing.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+constexpr int kSyntheticTicksPerSecond = 120;
+constexpr size_t kSyntheticCars = 6;
+
+inline void setSyntheticYaw(TelemetryBody& body, float yaw) {
+    body.quaternion[0] = std::cos(yaw / 2);
+    body.quaternion[1] = 0.0f;
+    body.quaternion[2] = 0.0f;
+    body.quaternion[3] = std::sin(yaw / 2);
+}
+
+inline std::vector<TelemetryFrame> makeSyntheticMatch(int seconds, std::uint64_t firstPhysicsFrame = 5000) {
+    std::vector<TelemetryFrame> frames((size_t)seconds * kSyntheticTicksPerSecond);
+    const float dt = 1.0f / kSyntheticTicksPerSecond;
+
+    float ball[3] = {0, 0, 93}, ballVelocity[3] = {900, -1300, 1200}, spin[3] = {2.0f, -1.5f, 3.0f};
+    float roll = 0.0f, pitch = 0.0f;
+    float jumpHeight[kSyntheticCars] = {}, jumpVelocity[kSyntheticCars] = {};
+
+    for (size_t n = 0; n < frames.size(); ++n) {
+        TelemetryFrame& frame = frames[n];
+        float t = n * dt;
+        frame.physicsFrame = firstPhysicsFrame + n;
+        frame.physicsTime = 40.0f + t;
+
+        // Ball: gravity, bounces off floor, walls and ceiling
+        ballVelocity[2] -= 650.0f * dt;
+        for (int axis = 0; axis < 3; ++axis) ball[axis] += ballVelocity[axis] * dt;
+        const float lo[3] = {-4000, -5000, 93}, hi[3] = {4000, 5000, 1950};
+        for (int axis = 0; axis < 3; ++axis) {
+            if (ball[axis] < lo[axis] || ball[axis] > hi[axis]) {
+                ball[axis] = std::min(std::max(ball[axis], lo[axis]), hi[axis]);
+                ballVelocity[axis] *= -0.6f;
+                spin[axis] = -spin[axis] * 0.8f;
+                if (axis == 2 && std::fabs(ballVelocity[2]) < 300.0f) ballVelocity[2] = 1400.0f;
+            }
+        }
+        roll += spin[0] * dt;
+        pitch += spin[1] * dt;
+
+        TelemetryBody& ballBody = frame.bodies[kTelemetryBall];
+        std::copy(ball, ball + 3, ballBody.location);
+        std::copy(ballVelocity, ballVelocity + 3, ballBody.velocity);
+        std::copy(spin, spin + 3, ballBody.angularVelocity);
+        ballBody.quaternion[0] = std::cos(roll / 2) * std::cos(pitch / 2);
+        ballBody.quaternion[1] = std::sin(roll / 2) * std::cos(pitch / 2);
+        ballBody.quaternion[2] = std::cos(roll / 2) * std::sin(pitch / 2);
+        ballBody.quaternion[3] = -std::sin(roll / 2) * std::sin(pitch / 2);
+        frame.flags[kTelemetryBall] = kTelemetryPresent;
+
+        // Cars: circles of different radius and speed
+        for (size_t car = 0; car < kSyntheticCars; ++car) {
+            size_t entity = 1 + car;
+            float radius = 800.0f + 250.0f * car;
+            float speed = 1100.0f + 150.0f * car;
+            float angle = speed / radius * t + car;
+            float centre[2] = {-2000.0f + 800.0f * car, (car % 2 ? 1500.0f : -1500.0f)};
+
+            if ((n + car * 97) % (3 * kSyntheticTicksPerSecond) == 0) jumpVelocity[car] = 600.0f;
+            jumpVelocity[car] -= 650.0f * dt;
+            jumpHeight[car] = std::max(0.0f, jumpHeight[car] + jumpVelocity[car] * dt);
+            if (jumpHeight[car] == 0.0f) jumpVelocity[car] = 0.0f;
+
+            TelemetryBody& body = frame.bodies[entity];
+            body.location[0] = centre[0] + radius * std::cos(angle);
+            body.location[1] = centre[1] + radius * std::sin(angle);
+            body.location[2] = 17.0f + jumpHeight[car];
+            body.velocity[0] = -speed * std::sin(angle);
+            body.velocity[1] = speed * std::cos(angle);
+            body.velocity[2] = jumpVelocity[car];
+            body.angularVelocity[2] = speed / radius;
+            setSyntheticYaw(body, angle + 1.5707963f);
+
+            frame.boost[entity] = 100.0f * (0.5f + 0.5f * std::sin(t * 0.3f + car));
+            frame.flags[entity] = kTelemetryPresent | (jumpHeight[car] == 0.0f ? kTelemetryOnGround : 0);
+            frame.ids[entity] = 1000 + (std::uint32_t)car;
+        }
+    }
+    return frames;
+}
@@ -0,0 +1,183 @@
+// Deterministic checks and cost numbers for SignalDebouncer and TimerWheel.
+// Every scenario runs on a VirtualClock stepped 1 ms at a time, so the
+// emitted sequence is exact and the run is repeatable; any mismatch is
+// printed and the program exits non-zero.
+//
+// Usage: debounce_sim [timers]
+
+#include "Clock.h"
+#include "TimerWheel.h"
+#include "SignalDebouncer.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using std::chrono::milliseconds;
+using BenchClock = std::chrono::steady_clock;
+
+struct Sample {
+    long long timeMs;
+    long long value;
+    bool operator==(const Sample& other) const { return timeMs == other.timeMs && value == other.value; }
+};
+
+static int failures = 0;
+
+// Feed `inputs` (time, value) to one signal and record what comes out
+static std::vector<Sample> run(const DebouncePolicy& policy, const std::vector<Sample>& inputs, long long endMs) {
+    VirtualClock clock;
+    TimerWheel wheel(clock.now());
+    std::vector<Sample> emitted;
+    SignalDebouncer debouncer(wheel, [&](SignalDebouncer::SignalId, std::int64_t value) {
+        emitted.push_back({ (long long)clock.now().count(), (long long)value });
+    });
+    debouncer.setDefaultPolicy(policy);
+
+    size_t next = 0;
+    for (long long t = 0; t <= endMs; ++t) {
+        wheel.advance(clock.now());
+        while (next < inputs.size() && inputs[next].timeMs == t) {
+            debouncer.update(0, inputs[next].value);
+            ++next;
+        }
+        clock.advance(milliseconds(1));
+    }
+    return emitted;
+}
+
+static void expect(const char* name, const std::vector<Sample>& actual, const std::vector<Sample>& expected) {
+    bool ok = actual == expected;
+    std::printf("%-44s %s\n", name, ok ? "ok" : "FAILED");
+    if (!ok) {
+        ++failures;
+        std::printf("    expected:");
+        for (const Sample& s : expected) std::printf(" %lld@%lld", s.value, s.timeMs);
+        std::printf("\n    actual:  ");
+        for (const Sample& s : actual) std::printf(" %lld@%lld", s.value, s.timeMs);
+        std::printf("\n");
+    }
+}
+
+static DebouncePolicy policy(long long dwellMs, DebounceEdge edge) {
+    DebouncePolicy p;
+    p.minDwell = milliseconds(dwellMs);
+    p.edge = edge;
+    return p;
+}
+
+static void scenarios() {
+    // Goal replay flapping between inGame (1) and inReplay (2), then a pause (3)
+    const std::vector<Sample> burst = { {0, 1}, {10, 2}, {20, 1}, {30, 2}, {300, 3} };
+
+    expect("leading: first change, then last after dwell",
+           run(policy(100, DebounceEdge::leading), burst, 600),
+           { {0, 1}, {100, 2}, {300, 3} });
+
+    expect("trailing: only the settled value",
+           run(policy(100, DebounceEdge::trailing), burst, 600),
+           { {130, 2}, {400, 3} });
+
+    expect("leading: flap back to the emitted value",
+           run(policy(100, DebounceEdge::leading), { {0, 1}, {10, 2}, {20, 1} }, 400),
+           { {0, 1} });
+
+    expect("trailing: flap back to the emitted value",
+           run(policy(100, DebounceEdge::trailing), { {0, 1}, {200, 2}, {210, 1} }, 600),
+           { {100, 1} });
+
+    expect("zero dwell passes every change through",
+           run(policy(0, DebounceEdge::leading), { {0, 1}, {1, 1}, {2, 2}, {3, 1} }, 10),
+           { {0, 1}, {2, 2}, {3, 1} });
+
+    // A second of 10 ms flapping that stops on 2: at most one change per
+    // window, and the last value always comes out
+    std::vector<Sample> flapping;
+    for (long long t = 0; t < 1000; t += 10) {
+        flapping.push_back({ t, (t / 10) % 2 == 0 ? 1 : 2 });
+    }
+    flapping.push_back({ 1000, 2 });
+    std::vector<Sample> throttled = run(policy(100, DebounceEdge::leading), flapping, 1500);
+    bool spaced = true;
+    for (size_t i = 1; i < throttled.size(); ++i) {
+        spaced = spaced && throttled[i].timeMs - throttled[i - 1].timeMs >= 100;
+    }
+    bool endsOnLast = !throttled.empty() && throttled.back().value == 2;
+    std::printf("%-44s %s (%zu changes out of %zu)\n", "leading: sustained flapping is rate limited",
+                spaced && endsOnLast ? "ok" : "FAILED", throttled.size(), flapping.size());
+    if (!spaced || !endsOnLast) ++failures;
+
+    // Signals keep their own windows and policies
+    {
+        VirtualClock clock;
+        TimerWheel wheel(clock.now());
+        std::vector<Sample> emitted;
+        SignalDebouncer debouncer(wheel, [&](SignalDebouncer::SignalId signal, std::int64_t value) {
+            emitted.push_back({ (long long)clock.now().count(), (long long)(signal * 100 + value) });
+        });
+        debouncer.setPolicy(1, policy(50, DebounceEdge::trailing));
+        debouncer.update(0, 1);
+        debouncer.update(1, 1);
+        for (int t = 0; t < 200; ++t) {
+            clock.advance(milliseconds(1));
+            wheel.advance(clock.now());
+            if (t == 20) debouncer.update(0, 2);
+        }
+        expect("independent signals and policies", emitted, { {0, 1}, {50, 101}, {100, 2} });
+    }
+}
+
+static void wheelCost(int timerCount) {
+    VirtualClock clock;
+    TimerWheel wheel(clock.now());
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> delay(1, 5000);
+    std::vector<TimerWheel::TimerId> ids;
+    ids.reserve(timerCount);
+    size_t fired = 0;
+
+    auto start = BenchClock::now();
+    for (int i = 0; i < timerCount; ++i) {
+        ids.push_back(wheel.addTimer(milliseconds(delay(rng)), [&fired] { ++fired; }));
+    }
+    double addNs = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count() / timerCount;
+
+    start = BenchClock::now();
+    for (int i = 0; i < timerCount; i += 2) {
+        wheel.cancelTimer(ids[i]);
+    }
+    double cancelNs = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count() / (timerCount / 2);
+
+    // Advance in 16 ms frames, like the game thread
+    start = BenchClock::now();
+    int frames = 0;
+    while (wheel.getPendingCount() > 0) {
+        clock.advance(milliseconds(16));
+        wheel.advance(clock.now());
+        ++frames;
+    }
+    double advanceNs = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+
+    std::printf("timer wheel, %d timers: add %.1f ns, cancel %.1f ns, %zu fired over %d frames, %.1f ns per fired timer\n",
+                timerCount, addNs, cancelNs, fired, frames, advanceNs / (fired ? fired : 1));
+    if (fired != (size_t)(timerCount / 2)) {
+        std::printf("    FAILED: expected %d to fire\n", timerCount / 2);
+        ++failures;
+    }
+}
+
+int main(int argc, char** argv) {
+    int timerCount = argc > 1 ? std::atoi(argv[1]) : 100000;
+    if (timerCount < 2) timerCount = 2;
+
+    scenarios();
+    wheelCost(timerCount);
+
+    if (failures) {
+        std::printf("%d check(s) FAILED\n", failures);
+        return 1;
+    }
+    std::printf("all checks passed\n");
+    return 0;
+}
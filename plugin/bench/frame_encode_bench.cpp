@@ -0,0 +1,111 @@
+// Frame encoder microbenchmark: the original per-byte std::string builder
+// versus encodeClientFrame, across payload sizes from 16 B to 64 KB.
+//
+// Usage: frame_encode_bench [min_total_bytes_per_size]
+
+#include "WebSocketFrame.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using BenchClock = std::chrono::steady_clock;
+
+// The encoder WebSocketClient::sendMessage used before: appends one char at
+// a time, masks with i % 4 and draws the key from rand()
+static std::string legacyEncode(const std::string& message) {
+    std::string frame;
+    frame += (char)0x81;
+
+    unsigned char maskKey[4];
+    for (int i = 0; i < 4; ++i) {
+        maskKey[i] = rand() % 256;
+    }
+
+    size_t payloadLen = message.length();
+    if (payloadLen < 126) {
+        frame += (char)(0x80 | payloadLen);
+    } else if (payloadLen < 65536) {
+        frame += (char)(0x80 | 126);
+        frame += (char)((payloadLen >> 8) & 0xFF);
+        frame += (char)(payloadLen & 0xFF);
+    } else {
+        frame += (char)(0x80 | 127);
+        for (int i = 7; i >= 0; --i) {
+            frame += (char)((payloadLen >> (i * 8)) & 0xFF);
+        }
+    }
+
+    frame.append((char*)maskKey, 4);
+    for (size_t i = 0; i < message.size(); i++) {
+        frame += (char)(message[i] ^ maskKey[i % 4]);
+    }
+    return frame;
+}
+
+// Unmask an encoded client frame and compare it with the original payload
+static bool roundTrips(const std::string& frame, const std::string& payload) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(frame.data());
+    size_t length = p[1] & 0x7F;
+    size_t pos = 2;
+    if (length == 126) {
+        length = ((size_t)p[2] << 8) | p[3];
+        pos = 4;
+    } else if (length == 127) {
+        length = 0;
+        for (int i = 0; i < 8; ++i) length = (length << 8) | p[2 + i];
+        pos = 10;
+    }
+    if (length != payload.size() || frame.size() != pos + 4 + length) return false;
+
+    const unsigned char* key = p + pos;
+    for (size_t i = 0; i < length; ++i) {
+        if ((char)(p[pos + 4 + i] ^ key[i & 3]) != payload[i]) return false;
+    }
+    return true;
+}
+
+// Prevent the optimizer from discarding encoded frames
+static volatile unsigned char sink;
+
+int main(int argc, char** argv) {
+    const size_t bytesPerSize = argc > 1 ? (size_t)std::atoll(argv[1]) : (size_t)256 * 1024 * 1024;
+    const size_t sizes[] = { 16, 64, 125, 256, 1024, 4096, 16384, 65535, 65536 };
+
+    std::printf("%8s %12s %12s %10s %12s\n", "payload", "legacy ns", "new ns", "speedup", "new GB/s");
+
+    for (size_t size : sizes) {
+        std::string payload(size, '\0');
+        for (size_t i = 0; i < size; ++i) payload[i] = (char)(i * 31 + 7);
+
+        std::string frame;
+        encodeClientFrame(frame, WebSocketOpcode::Text, payload.data(), payload.size());
+        if (!roundTrips(frame, payload) || !roundTrips(legacyEncode(payload), payload)) {
+            std::fprintf(stderr, "encoding mismatch at %zu bytes\n", size);
+            return 1;
+        }
+
+        const size_t iterations = bytesPerSize / size < 1000 ? 1000 : bytesPerSize / size;
+
+        auto start = BenchClock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            std::string legacy = legacyEncode(payload);
+            sink = (unsigned char)legacy[legacy.size() - 1];
+        }
+        double legacyNs = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count() / iterations;
+
+        start = BenchClock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            encodeClientFrame(frame, WebSocketOpcode::Text, payload.data(), payload.size());
+            sink = (unsigned char)frame[frame.size() - 1];
+        }
+        double newNs = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count() / iterations;
+
+        std::printf("%8zu %12.1f %12.1f %9.1fx %12.2f\n",
+            size, legacyNs, newNs, legacyNs / newNs, (double)size / newNs);
+    }
+
+    return 0;
+}
@@ -0,0 +1,137 @@
+// JSON writer benchmark: heap allocations and time per outgoing state
+// message, for the old stringstream formatting, for JsonWriter alone, and
+// end to end through WebSocketClient::sendJsonMessage to a loopback server.
+// Allocations are counted by replacing the global operator new.
+//
+// Usage: json_writer_bench [messages]
+
+#include "WebSocketClient.h"
+#include "JsonWriter.h"
+#include "BenchServer.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using BenchClock = std::chrono::steady_clock;
+
+// Allocations made by any thread since start-up
+static std::atomic<std::uint64_t> allocationCount(0);
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+static const char* kStateNames[] = { "inMenu", "inGame", "inReplay", "gamePaused" };
+
+// Keeps the optimizer from discarding formatted output
+static volatile size_t sink;
+
+struct Measurement {
+    double nsPerMessage;
+    double allocationsPerMessage;
+};
+
+template <typename Body>
+static Measurement measure(int messages, Body body) {
+    std::uint64_t allocationsBefore = allocationCount.load();
+    auto start = BenchClock::now();
+    for (int i = 0; i < messages; ++i) {
+        body(i);
+    }
+    double ns = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+    std::uint64_t allocations = allocationCount.load() - allocationsBefore;
+    return { ns / messages, (double)allocations / messages };
+}
+
+static void report(const char* name, const Measurement& m) {
+    std::printf("%-28s %8.1f ns/msg  %6.3f allocations/msg\n", name, m.nsPerMessage, m.allocationsPerMessage);
+}
+
+int main(int argc, char** argv) {
+    const int messages = argc > 1 ? std::atoi(argv[1]) : 200000;
+    const long long timestamp = 1700000000LL;
+
+    // The client logs connection events; keep the benchmark output readable
+    quietClientLogs();
+
+    // The previous sendJsonMessage: gameStateToString() returned a fresh
+    // std::string and the message went through a stringstream
+    Measurement legacy = measure(messages, [&](int i) {
+        std::string state = kStateNames[i & 3];
+        std::stringstream jsonStream;
+        jsonStream << "{\"state\":\"" << state << "\",\"timestamp\":" << (timestamp + i) << "}";
+        sink = jsonStream.str().size();
+    });
+
+    Measurement writer = measure(messages, [&](int i) {
+        char buffer[256];
+        JsonWriter json(buffer, sizeof(buffer));
+        json.beginObject();
+        json.field("state", kStateNames[i & 3]);
+        json.field("timestamp", timestamp + i);
+        json.endObject();
+        sink = json.size();
+    });
+
+    // Full path: format, encode into a queue slot, wake and write on the
+    // network thread. Warm up first so queue slots and buffers have grown.
+    BenchServer server(BenchServer::Mode::Sink);
+    if (!server.start()) {
+        std::fprintf(stderr, "failed to start sink server\n");
+        return 1;
+    }
+
+    WebSocketClient client(server.url());
+    client.setOfferBinaryProtocol(false);
+    client.connect();
+    auto deadline = BenchClock::now() + std::chrono::seconds(5);
+    while (!client.isConnected() && BenchClock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (!client.isConnected()) {
+        std::fprintf(stderr, "failed to connect to %s\n", server.url().c_str());
+        return 1;
+    }
+
+    auto sendAll = [&](int count) {
+        std::uint64_t target = server.getFramesReceived() + (std::uint64_t)count;
+        for (int i = 0; i < count; ++i) {
+            while (!client.sendJsonMessage(kStateNames[i & 3], timestamp + i)) {
+                std::this_thread::yield();  // queue full; let the writer drain it
+            }
+        }
+        while (server.getFramesReceived() < target && BenchClock::now() < deadline + std::chrono::seconds(30)) {
+            std::this_thread::yield();
+        }
+    };
+
+    sendAll(4096);
+    std::uint64_t allocationsBefore = allocationCount.load();
+    auto start = BenchClock::now();
+    sendAll(messages);
+    double ns = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+    // Counts every thread, the sink server's included; its receive buffer
+    // has stopped growing after the warm-up
+    Measurement endToEnd = { ns / messages, (double)(allocationCount.load() - allocationsBefore) / messages };
+    client.disconnect();
+
+    report("stringstream (before)", legacy);
+    report("JsonWriter", writer);
+    report("sendJsonMessage end to end", endToEnd);
+    return 0;
+}
@@ -0,0 +1,70 @@
+// Logger benchmark: caller-side cost of one log line, for the old
+// `std::cout << ... << std::endl` pattern (here an ofstream, so the flush
+// really reaches a file), for GS_LOG_INFO through the async logger, and
+// for GS_LOG_DEBUG as compiled in this build. Lines are logged in bursts
+// with pauses in between, the way the plugin logs; only the calls are
+// timed.
+//
+// Usage: logger_bench [bursts]
+
+#include "Logger.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+
+using BenchClock = std::chrono::steady_clock;
+
+static const int kLinesPerBurst = 64;
+static const char* kLogPath = "logger_bench.log";
+
+template <typename Body>
+static double measure(int bursts, Body body) {
+    double totalNs = 0;
+    for (int burst = 0; burst < bursts; ++burst) {
+        auto start = BenchClock::now();
+        for (int i = 0; i < kLinesPerBurst; ++i) {
+            body(burst * kLinesPerBurst + i);
+        }
+        totalNs += std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return totalNs / ((double)bursts * kLinesPerBurst);
+}
+
+int main(int argc, char** argv) {
+    const int bursts = argc > 1 ? std::atoi(argv[1]) : 200;
+    const std::string url = "ws://localhost:8080";
+
+    std::ofstream stream(kLogPath, std::ios::app);
+    double endlNs = measure(bursts, [&](int i) {
+        stream << "WebSocketClient: Reconnecting in " << (i * 10) << " ms (attempt " << i << ") " << url << std::endl;
+    });
+    stream.close();
+
+    if (!Logger::start(kLogPath, true)) {
+        std::fprintf(stderr, "failed to open %s\n", kLogPath);
+        return 1;
+    }
+    double infoNs = measure(bursts, [&](int i) {
+        GS_LOG_INFO("WebSocketClient: Reconnecting in %d ms (attempt %d) %s", i * 10, i, url.c_str());
+    });
+    double debugNs = measure(bursts, [&](int i) {
+        GS_LOG_DEBUG("GameStateDetector: probe %d returned %d", i, i & 3);
+    });
+    Logger::stop();
+    std::remove(kLogPath);
+
+#ifdef GAMESTATE_DEBUG_LOGGING
+    const char* debugLabel = "GS_LOG_DEBUG (compiled in)";
+#else
+    const char* debugLabel = "GS_LOG_DEBUG (compiled out)";
+#endif
+    std::printf("%-30s %8.1f ns/line\n", "ofstream << std::endl", endlNs);
+    std::printf("%-30s %8.1f ns/line\n", "GS_LOG_INFO", infoNs);
+    std::printf("%-30s %8.1f ns/line\n", debugLabel, debugNs);
+    std::printf("lines dropped: %llu\n", (unsigned long long)Logger::getDropped());
+    return 0;
+}
@@ -0,0 +1,107 @@
+// Session recorder benchmark: records a synthetic season (sessions of
+// five-minute matches, ball plus six cars at 120 Hz, with phase and score
+// events) and reports the game-thread cost per frame and the bytes on disk.
+// Scan the output with session_scan to time the reader.
+//
+// Usage: session_record_bench [output_dir] [sessions] [matches_per_session]
+
+#include "SessionRecorder.h"
+#include "MatchPhase.h"
+#include "SyntheticMatch.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+using BenchClock = std::chrono::steady_clock;
+
+static const int kMatchSeconds = 300;
+static const std::int64_t kSeasonStartMs = 1790000000000LL;
+
+int main(int argc, char** argv) {
+    std::string dir = argc > 1 ? argv[1] : "session_bench_out";
+    int sessions = argc > 2 ? std::atoi(argv[2]) : 10;
+    int matchesPerSession = argc > 3 ? std::atoi(argv[3]) : 6;
+    std::filesystem::create_directories(dir);
+
+    std::printf("Recording %d sessions x %d matches of %d s (ball + %zu cars, %d Hz) into %s\n",
+                sessions, matchesPerSession, kMatchSeconds, kSyntheticCars, kSyntheticTicksPerSecond, dir.c_str());
+
+    std::vector<TelemetryFrame> match = makeSyntheticMatch(kMatchSeconds);
+    const std::int64_t frameMs = 1000 / kSyntheticTicksPerSecond;
+
+    std::vector<std::uint64_t> frameCosts;
+    frameCosts.reserve(match.size() * matchesPerSession);
+    std::uint64_t totalFrames = 0, totalBytes = 0, droppedChunks = 0;
+    std::int64_t clockMs = kSeasonStartMs;
+    auto wallStart = BenchClock::now();
+
+    for (int session = 0; session < sessions; ++session) {
+        char name[64];
+        std::snprintf(name, sizeof(name), "/session-%03d.gsr", session);
+
+        SessionRecorder recorder;
+        if (!recorder.open(dir + name, clockMs)) {
+            std::fprintf(stderr, "cannot create %s%s\n", dir.c_str(), name);
+            return 1;
+        }
+
+        for (int m = 0; m < matchesPerSession; ++m) {
+            recorder.recordEvent(SessionEventKind::phase, (int)MatchPhase::countdown, clockMs);
+            recorder.recordScore(0, 0, clockMs);
+
+            int blue = 0, orange = 0;
+            for (size_t n = 0; n < match.size(); ++n) {
+                clockMs += (n % 3 == 2) ? frameMs + 1 : frameMs;   // 8.33 ms average
+
+                // A goal every 70 s or so, alternating sides
+                if (n > 0 && n % (70 * kSyntheticTicksPerSecond) == 0) {
+                    (n / (70 * kSyntheticTicksPerSecond) + m) % 2 ? ++blue : ++orange;
+                    recorder.recordEvent(SessionEventKind::phase, (int)MatchPhase::goalScored, clockMs);
+                    recorder.recordScore(blue, orange, clockMs);
+                    recorder.recordEvent(SessionEventKind::phase, (int)MatchPhase::kickoff, clockMs + 1);
+                    recorder.recordEvent(SessionEventKind::phase, (int)MatchPhase::live, clockMs + 2);
+                }
+
+                auto start = BenchClock::now();
+                recorder.recordFrame(match[n], clockMs);
+                frameCosts.push_back((std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    BenchClock::now() - start).count());
+
+                // The game hands over a chunk every ~8 s; give the writer
+                // thread a moment per chunk so a single-core box keeps up
+                if (n % kSessionChunkFrames == kSessionChunkFrames - 1) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                }
+            }
+
+            recorder.recordEvent(SessionEventKind::phase, (int)MatchPhase::postGame, clockMs + 1);
+            clockMs += 30000;
+            recorder.recordEvent(SessionEventKind::phase, (int)MatchPhase::menu, clockMs);
+            clockMs += 60000;
+        }
+
+        totalFrames += recorder.getFramesRecorded();
+        recorder.close();
+        totalBytes += recorder.getBytesWritten();
+        droppedChunks += recorder.getChunksDropped();
+    }
+    double wallMs = std::chrono::duration<double, std::milli>(BenchClock::now() - wallStart).count();
+
+    std::sort(frameCosts.begin(), frameCosts.end());
+    auto percentile = [&](double q) { return frameCosts[(size_t)(q * (frameCosts.size() - 1))]; };
+
+    std::printf("\nframes           %llu\n", (unsigned long long)totalFrames);
+    std::printf("on disk          %.1f MB, %.1f B/frame (raw floats: 439 B/frame)\n",
+                totalBytes / (1024.0 * 1024.0), (double)totalBytes / totalFrames);
+    std::printf("recordFrame      p50 %llu ns, p99 %llu ns, p99.9 %llu ns, max %llu ns (game thread)\n",
+                (unsigned long long)percentile(0.50), (unsigned long long)percentile(0.99),
+                (unsigned long long)percentile(0.999), (unsigned long long)frameCosts.back());
+    std::printf("chunks dropped   %llu\n", (unsigned long long)droppedChunks);
+    std::printf("wall             %.0f ms\n\nNext: session_scan %s\n", wallMs, dir.c_str());
+    return droppedChunks ? 1 : 0;
+}
@@ -0,0 +1,158 @@
+// Shared-memory transport benchmark: one-way latency of ShmRingWriter ->
+// ShmRingReader (futex doorbell) versus WebSocketClient -> loopback server,
+// at paced rates of 1k, 10k and 100k messages per second. Every message
+// carries its steady-clock send time; the receiving side records the
+// difference.
+//
+// Usage: shm_latency_bench [seconds_per_rate]
+
+#include "WebSocketClient.h"
+#include "ShmRingWriter.h"
+#include "ShmRingReader.h"
+#include "LatencyHistogram.h"
+#include "BenchServer.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+using BenchClock = std::chrono::steady_clock;
+
+// Same size as a binary state message
+static const size_t kMessageSize = 12;
+static const char* kRegionName = "GameStateShmBench";
+
+static std::uint64_t nowNs() {
+    return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        BenchClock::now().time_since_epoch()).count();
+}
+
+static void recordLatency(LatencyHistogram& histogram, const char* payload, size_t length) {
+    if (length < sizeof(std::uint64_t)) return;
+    std::uint64_t sentAt;
+    std::memcpy(&sentAt, payload, sizeof(sentAt));
+    histogram.record(nowNs() - sentAt);
+}
+
+// Open-loop pacing: message i goes out at start + i * period, whatever the
+// receiver is doing
+template <typename Send>
+static void sendPaced(int rate, int count, Send send) {
+    char message[kMessageSize] = {};
+    auto period = std::chrono::nanoseconds(1000000000LL / rate);
+    auto next = BenchClock::now();
+    for (int i = 0; i < count; ++i) {
+        // Yield rather than spin so the receiver gets the CPU on small machines
+        while (BenchClock::now() < next) {
+            std::this_thread::yield();
+        }
+        std::uint64_t sentAt = nowNs();
+        std::memcpy(message, &sentAt, sizeof(sentAt));
+        send(message, sizeof(message));
+        next += period;
+    }
+}
+
+static bool waitForCount(const LatencyHistogram& histogram, int count) {
+    auto deadline = BenchClock::now() + std::chrono::seconds(10);
+    while (histogram.getCount() < (std::uint64_t)count) {
+        if (BenchClock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+static bool runShm(int rate, int count, LatencyHistogram& histogram) {
+    ShmRingWriter writer;
+    if (!writer.create(kRegionName, 256 * 1024)) return false;
+
+    ShmRingReader reader;
+    if (!reader.open(kRegionName)) return false;
+
+    std::atomic<bool> stop(false);
+    std::thread consumer([&]() {
+        while (!stop.load(std::memory_order_relaxed)) {
+            reader.poll([&](std::string_view message) {
+                recordLatency(histogram, message.data(), message.size());
+            });
+            reader.wait(10);
+        }
+    });
+
+    sendPaced(rate, count, [&](const char* message, size_t length) {
+        writer.write(message, length);
+    });
+
+    bool complete = waitForCount(histogram, count);
+    stop = true;
+    consumer.join();
+    return complete;
+}
+
+static bool runWebSocket(int rate, int count, LatencyHistogram& histogram) {
+    BenchServer server(BenchServer::Mode::Sink);
+    server.setFrameCallback([&](const char* payload, size_t length) {
+        recordLatency(histogram, payload, length);
+    });
+    if (!server.start()) return false;
+
+    WebSocketClient client(server.url());
+    HeartbeatPolicy heartbeat;
+    heartbeat.intervalMs = 0;
+    client.setHeartbeatPolicy(heartbeat);
+    client.connect();
+    auto deadline = BenchClock::now() + std::chrono::seconds(5);
+    while (!client.isConnected()) {
+        if (BenchClock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    std::string frame(kMessageSize, '\0');
+    sendPaced(rate, count, [&](const char* message, size_t length) {
+        frame.assign(message, length);
+        client.sendMessage(frame);
+    });
+
+    bool complete = waitForCount(histogram, count);
+    client.disconnect();
+    return complete;
+}
+
+static void report(const char* transport, int rate, const LatencyHistogram& histogram) {
+    std::printf("%-9s %6d msgs/s: p50 %7.2f us  p99 %7.2f us  p99.9 %7.2f us  max %8.2f us\n",
+                transport, rate,
+                histogram.percentile(0.50) / 1000.0, histogram.percentile(0.99) / 1000.0,
+                histogram.percentile(0.999) / 1000.0, histogram.getMax() / 1000.0);
+}
+
+int main(int argc, char** argv) {
+    const double seconds = argc > 1 ? std::atof(argv[1]) : 1.0;
+
+    // The client logs connection events; keep the benchmark output readable
+    quietClientLogs();
+
+    const int rates[] = { 1000, 10000, 100000 };
+    for (int rate : rates) {
+        int count = (int)(rate * seconds);
+        if (count < 100) count = 100;
+
+        // Histograms here hold nanoseconds
+        LatencyHistogram shm;
+        if (!runShm(rate, count, shm)) {
+            std::fprintf(stderr, "shared memory run at %d msgs/s failed\n", rate);
+            return 1;
+        }
+        report("shm", rate, shm);
+
+        LatencyHistogram websocket;
+        if (!runWebSocket(rate, count, websocket)) {
+            std::fprintf(stderr, "WebSocket run at %d msgs/s failed\n", rate);
+            return 1;
+        }
+        report("websocket", rate, websocket);
+    }
+    return 0;
+}
@@ -0,0 +1,170 @@
+// State board torn-read stress: one thread publishes snapshots as fast as
+// it can while reader threads copy the board and check that every field
+// belongs to the same publish. Each field is derived from publishCount, so
+// a copy mixing two publishes is detected.
+//
+// Runs twice: once through StateBoardReader (seqlock, must see zero torn
+// copies) and once copying the words without the sequence check, to show
+// the stress actually produces tearing on this machine.
+//
+// Usage: state_board_stress [seconds] [readers]
+// Exits non-zero if the seqlock reader returned a torn snapshot.
+
+#include "StateBoardWriter.h"
+#include "StateBoardReader.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+static const char* kBoardName = "GameStateBoardStress";
+
+static StateBoardSnapshot makeSnapshot(std::uint64_t n) {
+    StateBoardSnapshot snapshot = {};
+    snapshot.state = (std::uint32_t)(n % 5);
+    snapshot.lastEvent = (std::uint32_t)(n % 4);
+    snapshot.stateSinceMs = (std::int64_t)(n * 3);
+    snapshot.updatedAtMs = (std::int64_t)(n * 5);
+    snapshot.lastEventAtMs = (std::int64_t)(n * 7);
+    snapshot.blueScore = (std::int32_t)(n & 0xFFFF);
+    snapshot.orangeScore = -(std::int32_t)(n & 0xFFFF);
+    snapshot.secondsRemaining = (std::int32_t)(n % 300);
+    snapshot.flags = (std::uint32_t)(n & 1);
+    snapshot.phase = (std::uint32_t)(n % 10);
+    return snapshot;
+}
+
+static bool isConsistent(const StateBoardSnapshot& snapshot) {
+    StateBoardSnapshot expected = makeSnapshot(snapshot.publishCount);
+    expected.publishCount = snapshot.publishCount;
+    return std::memcmp(&expected, &snapshot, sizeof(snapshot)) == 0;
+}
+
+// Copy the words without the sequence check (what a naive reader would do)
+static void loadUnguarded(const StateBoardPage& page, StateBoardSnapshot& snapshot) {
+    std::uint64_t copy[kStateBoardWords];
+    for (size_t i = 0; i < kStateBoardWords; ++i) {
+        copy[i] = page.words[i].load(std::memory_order_relaxed);
+        // Widen the race window a little so tearing shows up quickly
+        if (i == kStateBoardWords / 2) std::this_thread::yield();
+    }
+    std::memcpy(&snapshot, copy, sizeof(copy));
+}
+
+struct ReaderResult {
+    std::uint64_t reads = 0;
+    std::uint64_t failedReads = 0;
+    std::uint64_t torn = 0;
+    std::uint64_t wentBackwards = 0;
+};
+
+static ReaderResult runReader(const std::atomic<bool>& running, bool guarded) {
+    ReaderResult result;
+    StateBoardReader reader;
+    if (!reader.open(kBoardName)) {
+        std::fprintf(stderr, "reader: could not open %s\n", kBoardName);
+        return result;
+    }
+
+    // The unguarded variant maps the same page to bypass the seqlock
+    SharedMemoryRegion raw;
+    const StateBoardPage* page = nullptr;
+    if (!guarded) {
+        raw.open(kBoardName);
+        page = static_cast<const StateBoardPage*>(raw.data());
+    }
+
+    std::uint64_t lastSeen = 0;
+    StateBoardSnapshot snapshot;
+    while (running.load(std::memory_order_relaxed)) {
+        if (guarded) {
+            if (!reader.read(snapshot)) {
+                ++result.failedReads;
+                std::this_thread::yield();
+                continue;
+            }
+        } else {
+            loadUnguarded(*page, snapshot);
+        }
+
+        ++result.reads;
+        if (snapshot.publishCount == 0) continue;   // nothing published yet
+        if (!isConsistent(snapshot)) {
+            ++result.torn;
+        } else if (snapshot.publishCount < lastSeen) {
+            ++result.wentBackwards;
+        } else {
+            lastSeen = snapshot.publishCount;
+        }
+    }
+    return result;
+}
+
+static ReaderResult runRound(bool guarded, double seconds, int readerCount, std::uint64_t& published) {
+    StateBoardWriter writer;
+    if (!writer.create(kBoardName)) {
+        std::fprintf(stderr, "could not create state board %s\n", kBoardName);
+        std::exit(1);
+    }
+
+    std::atomic<bool> running(true);
+    std::vector<ReaderResult> results(readerCount);
+    std::vector<std::thread> readers;
+    for (int i = 0; i < readerCount; ++i) {
+        readers.emplace_back([&, i] { results[i] = runReader(running, guarded); });
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds);
+    std::uint64_t n = 0;
+    while (std::chrono::steady_clock::now() < deadline) {
+        // publish() stamps publishCount = n + 1
+        writer.publish(makeSnapshot(++n));
+        if ((n & 1023) == 0) std::this_thread::yield();
+    }
+    running.store(false);
+    for (std::thread& reader : readers) reader.join();
+    published = writer.getPublishCount();
+
+    ReaderResult total;
+    for (const ReaderResult& r : results) {
+        total.reads += r.reads;
+        total.failedReads += r.failedReads;
+        total.torn += r.torn;
+        total.wentBackwards += r.wentBackwards;
+    }
+    return total;
+}
+
+static void printRound(const char* label, const ReaderResult& r, std::uint64_t published) {
+    std::printf("%-10s published %10llu  reads %10llu  retries exhausted %6llu  torn %8llu  backwards %llu\n",
+                label, (unsigned long long)published, (unsigned long long)r.reads,
+                (unsigned long long)r.failedReads, (unsigned long long)r.torn,
+                (unsigned long long)r.wentBackwards);
+}
+
+int main(int argc, char** argv) {
+    double seconds = argc > 1 ? std::atof(argv[1]) : 2.0;
+    int readerCount = argc > 2 ? std::atoi(argv[2]) : 3;
+    if (seconds <= 0) seconds = 2.0;
+    if (readerCount < 1) readerCount = 1;
+
+    std::printf("state board stress: %.1f s per round, %d readers, %zu-byte snapshot\n",
+                seconds, readerCount, sizeof(StateBoardSnapshot));
+
+    std::uint64_t published = 0;
+    ReaderResult guarded = runRound(true, seconds, readerCount, published);
+    printRound("seqlock", guarded, published);
+
+    ReaderResult unguarded = runRound(false, seconds, readerCount, published);
+    printRound("unguarded", unguarded, published);
+
+    if (guarded.torn != 0 || guarded.wentBackwards != 0) {
+        std::printf("FAIL: seqlock reader returned inconsistent snapshots\n");
+        return 1;
+    }
+    std::printf("OK: no torn snapshots through the seqlock\n");
+    return 0;
+}
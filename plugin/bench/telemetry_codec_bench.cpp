@@ -0,0 +1,141 @@
+// Telemetry codec benchmark: bytes per frame and encode/decode cost per
+// entity for a synthetic match (ball plus six cars at 120 Hz), against the
+// raw float layout, with the worst round-trip error per field.
+//
+// Usage: telemetry_codec_bench [seconds_of_play]
+
+#include "SyntheticMatch.h"
+#include "TelemetryCodec.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using BenchClock = std::chrono::steady_clock;
+
+// Frame layout if every field were sent as is: frame number and time, then
+// 14 floats, flags and id per entity
+static const size_t kRawHeaderBytes = sizeof(std::uint64_t) + sizeof(float);
+static const size_t kRawEntityBytes = 14 * sizeof(float) + 1 + sizeof(std::uint32_t);
+
+struct CodecResult {
+    double bytesPerFrame;
+    double keyframeBytes;
+    double deltaBytes;
+    double encodeNsPerEntity;
+    double decodeNsPerEntity;
+    float maxLocationError;
+    float maxVelocityError;
+    float maxAngleErrorDeg;
+    bool ok;
+};
+
+static CodecResult run(const std::vector<TelemetryFrame>& frames, int keyframeInterval) {
+    CodecResult result = {};
+    result.ok = true;
+    const size_t entities = 1 + kSyntheticCars;
+
+    // Encode once to collect the stream and sizes
+    std::vector<std::vector<char>> encoded(frames.size());
+    TelemetryEncoder encoder(keyframeInterval);
+    size_t total = 0, keyTotal = 0, keyCount = 0;
+    char buffer[kMaxTelemetryFrameSize];
+    for (size_t n = 0; n < frames.size(); ++n) {
+        size_t length = encoder.encode(frames[n], buffer);
+        encoded[n].assign(buffer, buffer + length);
+        total += length;
+        if ((TelemetryFrameKind)buffer[0] == TelemetryFrameKind::keyframe) {
+            keyTotal += length;
+            ++keyCount;
+        }
+    }
+    result.bytesPerFrame = (double)total / frames.size();
+    result.keyframeBytes = keyCount ? (double)keyTotal / keyCount : 0.0;
+    result.deltaBytes = frames.size() > keyCount ? (double)(total - keyTotal) / (frames.size() - keyCount) : 0.0;
+
+    // Timed passes
+    const int reps = 20;
+    auto start = BenchClock::now();
+    for (int rep = 0; rep < reps; ++rep) {
+        TelemetryEncoder timed(keyframeInterval);
+        for (const TelemetryFrame& frame : frames) {
+            timed.encode(frame, buffer);
+        }
+    }
+    double encodeNs = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+    result.encodeNsPerEntity = encodeNs / ((double)reps * frames.size() * entities);
+
+    TelemetryFrame decoded;
+    start = BenchClock::now();
+    for (int rep = 0; rep < reps; ++rep) {
+        TelemetryDecoder decoder;
+        for (const std::vector<char>& message : encoded) {
+            decoder.decode(message.data(), message.size(), decoded);
+        }
+    }
+    double decodeNs = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+    result.decodeNsPerEntity = decodeNs / ((double)reps * frames.size() * entities);
+
+    // Round-trip error
+    TelemetryDecoder decoder;
+    for (size_t n = 0; n < frames.size(); ++n) {
+        if (!decoder.decode(encoded[n].data(), encoded[n].size(), decoded) ||
+            decoded.physicsFrame != frames[n].physicsFrame) {
+            result.ok = false;
+            break;
+        }
+        for (size_t entity = 0; entity < entities; ++entity) {
+            const TelemetryBody& a = frames[n].bodies[entity];
+            const TelemetryBody& b = decoded.bodies[entity];
+
+            for (int axis = 0; axis < 3; ++axis) {
+                result.maxLocationError = std::max(result.maxLocationError, std::fabs(a.location[axis] - b.location[axis]));
+                result.maxVelocityError = std::max(result.maxVelocityError, std::fabs(a.velocity[axis] - b.velocity[axis]));
+            }
+            // Rotation angle between the two; chord length is stable where
+            // acos(dot) drowns in float rounding near 1
+            double same = 0.0, flipped = 0.0;
+            for (int i = 0; i < 4; ++i) {
+                same += ((double)a.quaternion[i] - b.quaternion[i]) * ((double)a.quaternion[i] - b.quaternion[i]);
+                flipped += ((double)a.quaternion[i] + b.quaternion[i]) * ((double)a.quaternion[i] + b.quaternion[i]);
+            }
+            double chord = std::sqrt(std::min(same, flipped));
+            double angle = 4.0 * std::asin(std::min(1.0, chord / 2.0)) * 57.29578;
+            result.maxAngleErrorDeg = std::max(result.maxAngleErrorDeg, (float)angle);
+            if (decoded.flags[entity] != frames[n].flags[entity] || decoded.ids[entity] != frames[n].ids[entity]) {
+                result.ok = false;
+            }
+        }
+    }
+    return result;
+}
+
+int main(int argc, char** argv) {
+    int seconds = argc > 1 ? std::atoi(argv[1]) : 60;
+    std::vector<TelemetryFrame> frames = makeSyntheticMatch(seconds);
+    const size_t rawBytes = kRawHeaderBytes + (1 + kSyntheticCars) * kRawEntityBytes;
+
+    std::printf("Telemetry codec, ball + %zu cars, %d s at %d Hz (%zu frames)\n",
+                kSyntheticCars, seconds, kSyntheticTicksPerSecond, frames.size());
+    std::printf("raw floats: %zu B/frame, %.1f KB/s\n\n", rawBytes, rawBytes * kSyntheticTicksPerSecond / 1024.0);
+    std::printf("%-22s %9s %9s %9s %9s %10s %10s %10s %10s %10s\n", "keyframe interval", "B/frame", "KB/s",
+                "key B", "delta B", "enc ns/e", "dec ns/e", "loc err", "vel err", "rot err");
+
+    bool allOk = true;
+    const int intervals[] = {1, 30, 120, 600};
+    for (int interval : intervals) {
+        CodecResult r = run(frames, interval);
+        allOk = allOk && r.ok;
+        char label[32];
+        std::snprintf(label, sizeof(label), interval == 1 ? "every frame (no delta)" : "%d", interval);
+        std::printf("%-22s %9.1f %9.1f %9.1f %9.1f %10.1f %10.1f %10.3f %10.3f %9.4f%s\n", label,
+                    r.bytesPerFrame, r.bytesPerFrame * kSyntheticTicksPerSecond / 1024.0, r.keyframeBytes, r.deltaBytes,
+                    r.encodeNsPerEntity, r.decodeNsPerEntity, r.maxLocationError, r.maxVelocityError,
+                    r.maxAngleErrorDeg, r.ok ? "" : "  ROUND TRIP FAILED");
+    }
+
+    std::printf("\nErrors: location uu, velocity uu/s, rotation degrees\n");
+    return allOk ? 0 : 1;
+}
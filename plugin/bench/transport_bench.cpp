@@ -0,0 +1,128 @@
+// Transport benchmark: drives WebSocketClient against a loopback echo
+// server with no game running.
+//
+// Usage: transport_bench [messages] [payload_bytes]
+
+#include "WebSocketClient.h"
+#include "BenchServer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+using BenchClock = std::chrono::steady_clock;
+
+// Echoed messages decoded by the client's frame parser
+static std::atomic<std::uint64_t> messagesReceived(0);
+
+// Wait until `target` echoes have been decoded or the timeout expires
+static bool waitForMessages(std::uint64_t target, std::chrono::seconds timeout) {
+    auto deadline = BenchClock::now() + timeout;
+    while (messagesReceived.load(std::memory_order_acquire) < target) {
+        if (BenchClock::now() > deadline) return false;
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    const int messages = argc > 1 ? std::atoi(argv[1]) : 10000;
+    const size_t payloadSize = argc > 2 ? (size_t)std::atoll(argv[2]) : 64;
+
+    // The client logs connection events; keep the benchmark output readable
+    quietClientLogs();
+
+    BenchServer server(BenchServer::Mode::Echo);
+    if (!server.start()) {
+        std::fprintf(stderr, "failed to start echo server\n");
+        return 1;
+    }
+
+    WebSocketClient client(server.url());
+    // Fast heartbeat so the pong RTT histogram fills while the load runs
+    HeartbeatPolicy heartbeat;
+    heartbeat.intervalMs = 5;
+    client.setHeartbeatPolicy(heartbeat);
+    client.setMessageCallback([](std::string_view, bool) {
+        messagesReceived.fetch_add(1, std::memory_order_release);
+    });
+    // connect() only starts the attempt; wait for the handshake to finish
+    client.connect();
+    auto connectDeadline = BenchClock::now() + std::chrono::seconds(5);
+    while (!client.isConnected() && BenchClock::now() < connectDeadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (!client.isConnected()) {
+        std::fprintf(stderr, "failed to connect to %s\n", server.url().c_str());
+        return 1;
+    }
+    std::printf("connect latency: %d ms\n", client.getLastConnectLatencyMs());
+
+    const std::string payload(payloadSize, 'x');
+
+    // Round trip latency: one message in flight at a time
+    const int pingPongRounds = std::min(messages, 1000);
+    std::vector<double> rttUs;
+    rttUs.reserve(pingPongRounds);
+    std::uint64_t expected = 0;
+
+    for (int i = 0; i < pingPongRounds; ++i) {
+        auto start = BenchClock::now();
+        client.sendMessage(payload);
+        expected += 1;
+        if (!waitForMessages(expected, std::chrono::seconds(5))) {
+            std::fprintf(stderr, "timed out waiting for echo %d\n", i);
+            return 1;
+        }
+        rttUs.push_back(std::chrono::duration<double, std::micro>(BenchClock::now() - start).count());
+    }
+
+    std::sort(rttUs.begin(), rttUs.end());
+    std::printf("round trip  (%d msgs, %zu B): p50 %.1f us  p99 %.1f us  max %.1f us\n",
+        pingPongRounds, payloadSize,
+        rttUs[rttUs.size() / 2], rttUs[rttUs.size() * 99 / 100], rttUs.back());
+
+    // Throughput: send everything, then wait for all echoes. A full queue is
+    // retried so every message makes it; the retries show up as drops.
+    WebSocketStats before = client.getStats();
+    double enqueueNs = 0;
+    auto start = BenchClock::now();
+    for (int i = 0; i < messages; ++i) {
+        auto enqueueStart = BenchClock::now();
+        while (!client.sendMessage(payload)) {
+            std::this_thread::yield();
+        }
+        enqueueNs += std::chrono::duration<double, std::nano>(BenchClock::now() - enqueueStart).count();
+    }
+    expected += (std::uint64_t)messages;
+    if (!waitForMessages(expected, std::chrono::seconds(30))) {
+        std::fprintf(stderr, "timed out waiting for throughput echoes\n");
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(BenchClock::now() - start).count();
+
+    std::printf("throughput  (%d msgs, %zu B): %.0f msgs/s  %.1f MB/s\n",
+        messages, payloadSize, messages / seconds,
+        (double)payloadSize * messages / seconds / (1024.0 * 1024.0));
+
+    WebSocketStats after = client.getStats();
+    std::uint64_t sent = after.framesSent - before.framesSent;
+    std::uint64_t calls = after.sendCalls - before.sendCalls;
+    std::printf("send queue  : %.0f ns/enqueue  %.1f frames/send()  %llu full-queue retries  depth %zu/%zu\n",
+        enqueueNs / messages, calls ? (double)sent / calls : 0.0,
+        (unsigned long long)(after.framesDropped - before.framesDropped),
+        after.queueDepth, after.queueCapacity);
+
+    const LatencyHistogram& rtt = client.getRttHistogram();
+    std::printf("heartbeat   (%llu pongs): p50 %llu us  p99 %llu us  max %llu us\n",
+        (unsigned long long)rtt.getCount(), (unsigned long long)rtt.percentile(0.50),
+        (unsigned long long)rtt.percentile(0.99), (unsigned long long)rtt.getMax());
+
+    client.disconnect();
+    server.stop();
+    return 0;
+}
@@ -0,0 +1,123 @@
+// Unload latency benchmark: how long WebSocketClient::disconnect() (what
+// the plugin's onUnload waits on) takes against a server that never sends
+// anything, one that answers the close frame, and while the client is
+// waiting out a reconnect backoff.
+//
+// Usage: unload_latency_bench [iterations]
+// Exits non-zero if any disconnect() took longer than kMaxUnloadMs.
+
+#include "WebSocketClient.h"
+#include "BenchServer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+using BenchClock = std::chrono::steady_clock;
+
+// The silent server costs the client's 100 ms close-handshake wait; the
+// rest is slack for a loaded machine. A blocking recv would hang forever.
+static const double kMaxUnloadMs = 500.0;
+
+static double elapsedMs(BenchClock::time_point start) {
+    return std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+}
+
+static bool waitForConnected(WebSocketClient& client) {
+    auto deadline = BenchClock::now() + std::chrono::seconds(5);
+    while (!client.isConnected()) {
+        if (BenchClock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+// Print p50/max; false if the slowest run exceeded kMaxUnloadMs
+static bool report(const char* name, std::vector<double>& samples) {
+    std::sort(samples.begin(), samples.end());
+    std::printf("%-24s (%zu runs): p50 %.2f ms  max %.2f ms\n", name, samples.size(),
+                samples[samples.size() / 2], samples.back());
+    return samples.back() <= kMaxUnloadMs;
+}
+
+// Connect to a fresh server, let the network thread go idle in the poller,
+// then time disconnect()
+static bool measureConnected(BenchServer::Mode mode, int iterations, std::vector<double>& samples) {
+    for (int i = 0; i < iterations; ++i) {
+        BenchServer server(mode);
+        if (!server.start()) return false;
+
+        WebSocketClient client(server.url());
+        client.connect();
+        if (!waitForConnected(client)) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        auto start = BenchClock::now();
+        client.disconnect();
+        samples.push_back(elapsedMs(start));
+    }
+    return true;
+}
+
+// Nothing is listening: the client fails its first attempt and sits in a
+// long backoff timer when disconnect() arrives
+static bool measureBackoff(int iterations, std::vector<double>& samples) {
+    std::string url;
+    {
+        BenchServer server(BenchServer::Mode::Sink);
+        if (!server.start()) return false;
+        url = server.url();
+    }
+
+    for (int i = 0; i < iterations; ++i) {
+        WebSocketClient client(url);
+        ReconnectPolicy policy;
+        policy.baseDelayMs = 60000;
+        client.setReconnectPolicy(policy);
+        client.connect();
+
+        auto deadline = BenchClock::now() + std::chrono::seconds(5);
+        while (client.getState() != WebSocketClient::ConnectionState::Reconnecting) {
+            if (BenchClock::now() > deadline) return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        auto start = BenchClock::now();
+        client.disconnect();
+        samples.push_back(elapsedMs(start));
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 20;
+
+    // The client logs connection events; keep the benchmark output readable
+    quietClientLogs();
+
+    std::vector<double> silent, answering, backoff;
+    if (!measureConnected(BenchServer::Mode::Silent, iterations, silent)) {
+        std::fprintf(stderr, "silent server run failed\n");
+        return 1;
+    }
+    if (!measureConnected(BenchServer::Mode::Sink, iterations, answering)) {
+        std::fprintf(stderr, "answering server run failed\n");
+        return 1;
+    }
+    if (!measureBackoff(iterations, backoff)) {
+        std::fprintf(stderr, "backoff run failed\n");
+        return 1;
+    }
+
+    bool ok = report("silent server", silent);
+    ok = report("server answers close", answering) && ok;
+    ok = report("reconnect backoff", backoff) && ok;
+    if (!ok) {
+        std::fprintf(stderr, "FAIL: disconnect() took longer than %.0f ms\n", kMaxUnloadMs);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,103 @@
+// Wire format benchmark: the JSON state message built by sendJsonMessage
+// versus the binary encoding from WireProtocol.h, in payload bytes, bytes on
+// the wire and encode time. Also checks that the binary format is negotiated
+// end to end against the loopback server.
+//
+// Usage: wire_protocol_bench [iterations]
+
+#include "WebSocketClient.h"
+#include "WebSocketFrame.h"
+#include "WireProtocol.h"
+#include "JsonWriter.h"
+#include "BenchServer.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+using BenchClock = std::chrono::steady_clock;
+
+static const char* kStateNames[] = { "inMenu", "inGame", "inReplay", "gamePaused" };
+
+// Keeps the optimizer from discarding encoded output
+static volatile size_t sink;
+
+// The JSON path as WebSocketClient::sendJsonMessage formats it
+static std::string_view encodeJson(char* buffer, size_t capacity, const char* state, long long timestamp) {
+    JsonWriter json(buffer, capacity);
+    json.beginObject();
+    json.field("state", state);
+    json.field("timestamp", timestamp);
+    json.endObject();
+    return std::string_view(json.data(), json.size());
+}
+
+static bool checkNegotiation() {
+    BenchServer server(BenchServer::Mode::Sink);
+    server.setSubprotocol(kBinaryWireProtocol);
+    if (!server.start()) return false;
+
+    WebSocketClient client(server.url());
+    client.setOfferBinaryProtocol(true);
+    client.connect();
+    auto deadline = BenchClock::now() + std::chrono::seconds(5);
+    while (!client.isConnected() && BenchClock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (!client.isConnected() || client.getWireFormat() != WireFormat::Binary) return false;
+
+    const int messages = 100;
+    for (int i = 0; i < messages; ++i) {
+        client.sendStateMessage((std::uint32_t)(i % 4), kStateNames[i % 4], 1700000000LL + i);
+    }
+    while (server.getFramesReceived() < (std::uint64_t)messages && BenchClock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return server.getFramesReceived() == (std::uint64_t)messages;
+}
+
+int main(int argc, char** argv) {
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    const long long timestamp = 1700000000LL;
+
+    // The client logs connection events; keep the benchmark output readable
+    quietClientLogs();
+
+    // Encode cost
+    char jsonBuffer[256];
+    auto start = BenchClock::now();
+    for (int i = 0; i < iterations; ++i) {
+        sink = encodeJson(jsonBuffer, sizeof(jsonBuffer), kStateNames[i & 3], timestamp + i).size();
+    }
+    double jsonNs = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count() / iterations;
+
+    char message[kMaxWireMessageSize];
+    start = BenchClock::now();
+    for (int i = 0; i < iterations; ++i) {
+        sink = encodeStateMessage(message, (std::uint16_t)i, (std::uint32_t)(i & 3), (std::uint64_t)(timestamp + i));
+    }
+    double binaryNs = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count() / iterations;
+
+    // Size, as payload and as a masked client frame
+    std::string_view json = encodeJson(jsonBuffer, sizeof(jsonBuffer), "gamePaused", timestamp);
+    size_t binarySize = encodeStateMessage(message, 0, 3, (std::uint64_t)timestamp);
+
+    std::string frame;
+    encodeClientFrame(frame, WebSocketOpcode::Text, json.data(), json.size());
+    size_t jsonWire = frame.size();
+    encodeClientFrame(frame, WebSocketOpcode::Binary, message, binarySize);
+    size_t binaryWire = frame.size();
+
+    std::printf("json    state message: %3zu B payload  %3zu B on the wire  %7.1f ns/encode\n",
+                json.size(), jsonWire, jsonNs);
+    std::printf("binary  state message: %3zu B payload  %3zu B on the wire  %7.1f ns/encode\n",
+                binarySize, binaryWire, binaryNs);
+
+    if (!checkNegotiation()) {
+        std::fprintf(stderr, "binary subprotocol negotiation failed\n");
+        return 1;
+    }
+    std::printf("negotiation: server selected %s, 100 binary frames delivered\n", kBinaryWireProtocol);
+    return 0;
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "bakkesmod/wrappers/WrapperStructs.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class CanvasWrapper;
+class GameWrapper;
+
+// Game objects behind the SDK stub. Wrappers hold pointers to these in
+// memory_address, so an object must stay put while the plugin can see it:
+// resize FakeServer::cars only between ticks.
+// What RBActorWrapper reads, for the ball and cars alike
+struct FakeBody {
+    RBState state = {};
+    int physicsFrame = 0;
+};
+
+struct FakeBall : FakeBody {
+};
+
+struct FakeCar : FakeBody {
+    int playerId = 0;
+    unsigned char teamNum = 0;
+    bool onGround = true;
+    float boost = 0.33f;            // 0..1, like BoostWrapper
+};
+
+struct FakeTeam {
+    unsigned char teamNum = 0;
+    int score = 0;
+};
+
+struct FakeServer {
+    int secondsRemaining = 300;
+    int waitTimeRemaining = 0;
+    float gameSpeed = 1.0f;
+    bool roundActive = false;
+    bool ballHasBeenHit = false;
+    bool overTime = false;
+    bool matchEnded = false;
+    bool hasReplayDirector = true;
+    int physicsFrame = 0;
+
+    FakeBall ball;
+    std::vector<FakeCar> cars;
+    FakeTeam teams[2] = { { 0, 0 }, { 1, 0 } };
+};
+
+// The screen drawables paint on; counts what was drawn in the last frame
+struct FakeCanvas {
+    Vector2 size = { 1920, 1080 };
+    Vector2 position = { 0, 0 };
+    size_t strings = 0;
+    size_t boxes = 0;
+    std::string lastString;
+};
+
+// The scriptable game the SDK stub answers from. The driver owns one,
+// changes it between ticks and fires engine functions at it; GameWrapper
+// and CVarManagerWrapper are views of it. Everything except queue() and
+// log() is game-thread only, as in the real game.
+class FakeWorld {
+public:
+    using Hook = std::function<void(std::uintptr_t caller, void* params, const std::string& eventName)>;
+    using Notifier = std::function<void(std::vector<std::string>)>;
+    using LogSink = std::function<void(const std::string&)>;
+    using Drawable = std::function<void(CanvasWrapper)>;
+
+    FakeWorld();
+
+    // What GameWrapper reports
+    bool inGame = false;
+    bool inOnlineGame = false;
+    bool inReplay = false;
+    std::unique_ptr<FakeServer> server;     // null outside a match
+    int localCar = 0;                       // index into server->cars
+
+    // Handles for the wrappers (memory_address values)
+    std::uintptr_t getAddress() { return reinterpret_cast<std::uintptr_t>(this); }
+    std::uintptr_t getServerAddress() const { return reinterpret_cast<std::uintptr_t>(server.get()); }
+
+    // Engine functions: pre hooks run, then post hooks, in hook order.
+    // caller is the memory_address handed to HookEventWithCaller hooks.
+    void addHook(const std::string& eventName, Hook hook, bool post);
+    void removeHooks(const std::string& eventName, bool post);
+    void fire(const std::string& eventName, std::uintptr_t caller = 0);
+    size_t getHookCount() const;
+
+    // GameWrapper::Execute from any thread, SetTimeout on the game thread;
+    // both run in runQueued, called once per tick with the current time
+    void queue(std::function<void(GameWrapper*)> callback);
+    void queueAfter(std::function<void(GameWrapper*)> callback, double delaySeconds);
+    size_t runQueued(GameWrapper* gameWrapper, double nowSeconds);
+
+    // GameWrapper::RegisterDrawable; render() runs them all once per frame
+    void addDrawable(Drawable drawable);
+    void clearDrawables();
+    void render(FakeCanvas& canvas);
+    size_t getDrawableCount() const { return drawables.size(); }
+
+    // Console. executeCommand splits on spaces; params[0] is the command.
+    void registerNotifier(const std::string& name, Notifier notifier, const std::string& description);
+    bool removeNotifier(const std::string& name);
+    bool executeCommand(const std::string& line);
+    void log(const std::string& text);
+    void setLogSink(LogSink sink);
+
+    // What BakkesMod does when a plugin unloads
+    void clearPluginState();
+
+private:
+    struct Timeout {
+        double dueSeconds;
+        std::function<void(GameWrapper*)> callback;
+    };
+
+    std::unordered_map<std::string, std::vector<Hook>> preHooks;
+    std::unordered_map<std::string, std::vector<Hook>> postHooks;
+    std::unordered_map<std::string, Notifier> notifiers;
+    std::vector<Drawable> drawables;
+
+    std::mutex queueMutex;
+    std::vector<std::function<void(GameWrapper*)>> queued;
+    std::vector<std::function<void(GameWrapper*)>> running;
+    std::vector<Timeout> timeouts;
+    double lastNowSeconds;
+
+    std::mutex logMutex;
+    LogSink logSink;
+};
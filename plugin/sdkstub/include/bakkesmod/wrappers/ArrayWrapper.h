@@ -0,0 +1,20 @@
+#pragma once
+#include "../plugin/bakkesmodsdk.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// SDK stub: a snapshot of the element addresses instead of a TArray
+template<typename T>
+class ArrayWrapper
+{
+public:
+	ArrayWrapper(std::vector<std::uintptr_t> items) : items(std::move(items)) {}
+
+	int Count() { return (int)items.size(); }
+	T Get(int index) { return T(index >= 0 && index < (int)items.size() ? items[(size_t)index] : 0); }
+	bool IsNull() { return false; }
+
+private:
+	std::vector<std::uintptr_t> items;
+};
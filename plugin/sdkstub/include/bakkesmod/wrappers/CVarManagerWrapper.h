@@ -0,0 +1,28 @@
+#pragma once
+#include "../plugin/bakkesmodsdk.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <typeindex>
+#include <vector>
+
+class FakeWorld;
+
+typedef void (*commandNotifier)(std::vector<std::string>);
+
+// SDK stub: console commands and the log, kept by the FakeWorld
+class BAKKESMOD_PLUGIN_IMPORT CVarManagerWrapper
+{
+public:
+	CVarManagerWrapper(std::uintptr_t mem, std::type_index pluginIdx);
+
+	void executeCommand(std::string command, bool log = true);
+	void registerNotifier(std::string cvar, commandNotifier notifier, std::string description, unsigned char permissions);
+	void registerNotifier(std::string cvar, std::function<void(std::vector<std::string>)> notifier, std::string description, unsigned char permissions);
+	bool removeNotifier(std::string cvar);
+
+	void log(std::string text);
+
+private:
+	FakeWorld* world;
+};
@@ -0,0 +1,11 @@
+#pragma once
+#include "ObjectWrapper.h"
+
+class BAKKESMOD_PLUGIN_IMPORT ActorWrapper : public ObjectWrapper
+{
+public:
+	ActorWrapper(std::uintptr_t mem);
+
+	bool IsNull() const;
+	explicit operator bool() const;
+};
@@ -0,0 +1,15 @@
+#pragma once
+#include "bakkesmod/plugin/bakkesmodsdk.h"
+#include "../WrapperStructs.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+// SDK stub: memory_address points at a FakeWorld object (FakeWorld.h)
+class BAKKESMOD_PLUGIN_IMPORT ObjectWrapper
+{
+public:
+	std::uintptr_t memory_address;
+	ObjectWrapper(std::uintptr_t mem);
+};
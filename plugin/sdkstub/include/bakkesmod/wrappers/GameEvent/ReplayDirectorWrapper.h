@@ -0,0 +1,9 @@
+#pragma once
+#include "../Engine/ActorWrapper.h"
+
+// SDK stub: non-null while the FakeServer has a replay director
+class BAKKESMOD_PLUGIN_IMPORT ReplayDirectorWrapper : public ActorWrapper
+{
+public:
+	ReplayDirectorWrapper(std::uintptr_t mem);
+};
@@ -0,0 +1,11 @@
+#pragma once
+#include "../Engine/ObjectWrapper.h"
+
+// SDK stub: included by the plugin, not used
+class BAKKESMOD_PLUGIN_IMPORT ReplayWrapper : public ObjectWrapper
+{
+public:
+	ReplayWrapper(std::uintptr_t mem);
+
+	bool IsNull() const;
+};
@@ -0,0 +1,28 @@
+#pragma once
+#include "../Engine/ActorWrapper.h"
+#include "../ArrayWrapper.h"
+#include "../GameObject/BallWrapper.h"
+#include "../GameObject/CarWrapper.h"
+#include "../GameObject/TeamWrapper.h"
+#include "ReplayDirectorWrapper.h"
+
+// SDK stub: memory_address is a FakeServer. The members of
+// GameEventWrapper and TeamGameEventWrapper the plugin uses are folded in.
+class BAKKESMOD_PLUGIN_IMPORT ServerWrapper : public ActorWrapper
+{
+public:
+	ServerWrapper(std::uintptr_t mem);
+
+	BallWrapper GetBall();
+	ArrayWrapper<CarWrapper> GetCars();
+	ArrayWrapper<TeamWrapper> GetTeams();
+	ReplayDirectorWrapper GetReplayDirector();
+
+	int GetSecondsRemaining();
+	int GetWaitTimeRemaining();
+	float GetGameSpeed();
+	unsigned long GetbRoundActive();
+	unsigned long GetbBallHasBeenHit();
+	unsigned long GetbOverTime();
+	unsigned long GetbMatchEnded();
+};
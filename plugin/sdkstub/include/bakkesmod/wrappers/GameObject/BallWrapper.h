@@ -0,0 +1,9 @@
+#pragma once
+#include "RBActorWrapper.h"
+
+// SDK stub: memory_address is a FakeBall
+class BAKKESMOD_PLUGIN_IMPORT BallWrapper : public RBActorWrapper
+{
+public:
+	BallWrapper(std::uintptr_t mem);
+};
@@ -0,0 +1,9 @@
+#pragma once
+#include "../Engine/ActorWrapper.h"
+
+// SDK stub: included by the plugin, not used
+class BAKKESMOD_PLUGIN_IMPORT CameraWrapper : public ActorWrapper
+{
+public:
+	CameraWrapper(std::uintptr_t mem);
+};
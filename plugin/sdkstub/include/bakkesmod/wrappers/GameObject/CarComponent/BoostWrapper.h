@@ -0,0 +1,11 @@
+#pragma once
+#include "../../Engine/ActorWrapper.h"
+
+// SDK stub: memory_address is the FakeCar
+class BAKKESMOD_PLUGIN_IMPORT BoostWrapper : public ActorWrapper
+{
+public:
+	BoostWrapper(std::uintptr_t mem);
+
+	float GetCurrentBoostAmount();
+};
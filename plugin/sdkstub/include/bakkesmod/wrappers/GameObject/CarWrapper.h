@@ -0,0 +1,16 @@
+#pragma once
+#include "RBActorWrapper.h"
+#include "PriWrapper.h"
+#include "CarComponent/BoostWrapper.h"
+
+// SDK stub: memory_address is a FakeCar. VehicleWrapper's members are
+// folded in.
+class BAKKESMOD_PLUGIN_IMPORT CarWrapper : public RBActorWrapper
+{
+public:
+	CarWrapper(std::uintptr_t mem);
+
+	PriWrapper GetPRI();
+	BoostWrapper GetBoostComponent();
+	bool IsOnGround();
+};
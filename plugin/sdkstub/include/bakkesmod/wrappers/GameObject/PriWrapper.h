@@ -0,0 +1,12 @@
+#pragma once
+#include "../Engine/ActorWrapper.h"
+
+// SDK stub: memory_address is the FakeCar the player drives
+class BAKKESMOD_PLUGIN_IMPORT PriWrapper : public ActorWrapper
+{
+public:
+	PriWrapper(std::uintptr_t mem);
+
+	int GetPlayerID();
+	unsigned char GetTeamNum();
+};
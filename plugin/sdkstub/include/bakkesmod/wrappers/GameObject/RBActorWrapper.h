@@ -0,0 +1,11 @@
+#pragma once
+#include "../Engine/ActorWrapper.h"
+
+class BAKKESMOD_PLUGIN_IMPORT RBActorWrapper : public ActorWrapper
+{
+public:
+	RBActorWrapper(std::uintptr_t mem);
+
+	RBState GetRBState();
+	int GetPhysicsFrame();
+};
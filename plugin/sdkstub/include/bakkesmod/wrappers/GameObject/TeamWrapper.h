@@ -0,0 +1,13 @@
+#pragma once
+#include "../Engine/ActorWrapper.h"
+
+// SDK stub: memory_address is a FakeTeam. TeamInfoWrapper's members are
+// folded in.
+class BAKKESMOD_PLUGIN_IMPORT TeamWrapper : public ActorWrapper
+{
+public:
+	TeamWrapper(std::uintptr_t mem);
+
+	int GetScore();
+	unsigned char GetTeamNum();
+};
@@ -0,0 +1,52 @@
+#pragma once
+#include "../plugin/bakkesmodsdk.h"
+#include "GameEvent/ServerWrapper.h"
+#include "GameObject/CarWrapper.h"
+#include "canvaswrapper.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+
+class FakeWorld;
+
+// SDK stub: game queries and hooks, answered by the FakeWorld the driver
+// scripts. Hooks run when the driver fires the named engine function.
+class BAKKESMOD_PLUGIN_IMPORT GameWrapper
+{
+public:
+	GameWrapper(std::uintptr_t mem);
+
+	bool IsInGame();
+	bool IsInOnlineGame();
+	bool IsInReplay();
+
+	ServerWrapper GetOnlineGame();
+	ServerWrapper GetGameEventAsServer();
+	CarWrapper GetLocalCar();
+
+	void SetTimeout(std::function<void(GameWrapper*)> theLambda, float time); //time in seconds
+	void Execute(std::function<void(GameWrapper*)> theLambda); //Use this when calling from a different thread
+
+	void HookEvent(std::string eventName, std::function<void(std::string eventName)> callback);
+	void UnhookEvent(std::string eventName);
+	void HookEventPost(std::string eventName, std::function<void(std::string eventName)> callback);
+	void UnhookEventPost(std::string eventName);
+
+	void RegisterDrawable(std::function<void(CanvasWrapper)> callback);
+	void UnregisterDrawables(); //Can only unregister every drawable for now, sorry!
+
+	template<typename T>
+	void HookEventWithCaller(std::string eventName, std::function<void(T caller, void* params, std::string eventName)> callback);
+	template<typename T>
+	void HookEventWithCallerPost(std::string eventName, std::function<void(T caller, void* params, std::string eventName)> callback);
+
+private:
+	FakeWorld* world;
+};
+
+extern template void GameWrapper::HookEventWithCaller<ServerWrapper>(std::string eventName, std::function<void(ServerWrapper caller, void* params, std::string eventName)> callback);
+extern template void GameWrapper::HookEventWithCaller<CarWrapper>(std::string eventName, std::function<void(CarWrapper caller, void* params, std::string eventName)> callback);
+extern template void GameWrapper::HookEventWithCaller<BallWrapper>(std::string eventName, std::function<void(BallWrapper caller, void* params, std::string eventName)> callback);
+extern template void GameWrapper::HookEventWithCallerPost<ServerWrapper>(std::string eventName, std::function<void(ServerWrapper caller, void* params, std::string eventName)> callback);
+extern template void GameWrapper::HookEventWithCallerPost<CarWrapper>(std::string eventName, std::function<void(CarWrapper caller, void* params, std::string eventName)> callback);
+extern template void GameWrapper::HookEventWithCallerPost<BallWrapper>(std::string eventName, std::function<void(BallWrapper caller, void* params, std::string eventName)> callback);
@@ -0,0 +1,32 @@
+#pragma once
+// SDK stub: the math structs the plugin reads, with the real layouts
+
+struct Vector {
+    float X, Y, Z;
+
+    Vector(float x, float y, float z) : X(x), Y(y), Z(z) {}
+    Vector(float def) : X(def), Y(def), Z(def) {}
+    Vector() : Vector(0.0f) {}
+};
+
+struct Vector2 {
+    int X, Y;
+};
+
+struct Quat {
+    float X, Y, Z, W;
+
+    Quat(float w, float x, float y, float z) : X(x), Y(y), Z(z), W(w) {}
+    Quat() : Quat(1.0f, 0.0f, 0.0f, 0.0f) {}
+};
+
+struct RBState
+{
+    Quat Quaternion;
+    Vector Location;
+    Vector LinearVelocity;
+    Vector AngularVelocity;
+    float Time;
+    unsigned long bSleeping : 1;
+    unsigned long bNewData : 1;
+};
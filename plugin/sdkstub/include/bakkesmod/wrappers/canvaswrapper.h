@@ -0,0 +1,17 @@
+#pragma once
+#include "Engine/ObjectWrapper.h"
+#include <string>
+
+// SDK stub: draws onto a FakeCanvas (FakeWorld.h), which only counts calls
+class BAKKESMOD_PLUGIN_IMPORT CanvasWrapper : public ObjectWrapper
+{
+public:
+	CanvasWrapper(std::uintptr_t mem);
+
+	void SetPosition(Vector2 pos);
+	void SetColor(char Red, char Green, char Blue, char Alpha);//0-255
+	void FillBox(Vector2 size);
+	void DrawString(std::string text);
+	void DrawString(std::string text, float xScale, float yScale);
+	Vector2 GetSize();
+};
@@ -0,0 +1,47 @@
+#pragma once
+// SDK stub: the real parser.h pulls in <windows.h>; these are the string
+// helpers from it that build anywhere
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <vector>
+
+static inline bool string_ends_with(std::string const & value, std::string const & ending)
+{
+	if (ending.size() > value.size()) return false;
+	return std::equal(ending.rbegin(), ending.rend(), value.rbegin());
+}
+
+static inline bool string_starts_with(std::string const & value, std::string const & begin) {
+	return value.compare(0, begin.length(), begin) == 0;
+}
+
+static inline size_t split(const std::string &txt, std::vector<std::string> &strs, char ch)
+{
+	size_t pos = txt.find(ch);
+	size_t initialPos = 0;
+	strs.clear();
+
+	while (pos != std::string::npos) {
+		strs.push_back(txt.substr(initialPos, pos - initialPos));
+		initialPos = pos + 1;
+		pos = txt.find(ch, initialPos);
+	}
+
+	strs.push_back(txt.substr(initialPos, std::min(pos, txt.size()) - initialPos + 1));
+	return strs.size();
+}
+
+static inline std::string &ltrim(std::string &s) {
+	s.erase(s.begin(), std::find_if(s.begin(), s.end(), [](unsigned char c) { return !std::isspace(c); }));
+	return s;
+}
+
+static inline std::string &rtrim(std::string &s) {
+	s.erase(std::find_if(s.rbegin(), s.rend(), [](unsigned char c) { return !std::isspace(c); }).base(), s.end());
+	return s;
+}
+
+static inline std::string &trim(std::string &s) {
+	return ltrim(rtrim(s));
+}
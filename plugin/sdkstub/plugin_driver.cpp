@@ -0,0 +1,390 @@
+// Loads GameStatePlugin as a Linux shared object against the SDK stub and
+// plays scripted matches at it: menu, map load, countdowns, kickoffs,
+// goals with replays, a pause, the podium. Render frames fire the viewport
+// tick and paint the drawables, physics steps fire SetVehicleInput per car,
+// so the plugin runs its real hook paths. For profiling with perf,
+// heaptrack and the sanitizers; nothing here talks to a game.
+//
+// Usage: plugin_driver [--plugin path] [--seconds N] [--fps N] [--physics-hz N]
+//                      [--cars N] [--match-seconds N] [--unpaced]
+//                      [--command "console command"]...
+//
+// --seconds is game time. Frames are paced to the wall clock, because the
+// plugin's timers, tick cadences, throttles and transports all read it.
+// --unpaced runs as fast as the plugin allows: thousands of game seconds
+// pass per wall second, so the debouncer, every time-based tick subscriber
+// and the perf stats barely run and the frame cost it prints is not what
+// the game sees. Use it only to stress the per-frame hook paths. Commands
+// run after the last frame, before unload; by default the stats commands.
+
+#include "FakeWorld.h"
+#include "LatencyHistogram.h"
+#include "bakkesmod/plugin/bakkesmodplugin.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <typeindex>
+#include <vector>
+#include <dlfcn.h>
+
+static const char* kTickEvent = "Function Engine.GameViewportClient.Tick";
+static const char* kPhysicsTickEvent = "Function TAGame.Car_TA.SetVehicleInput";
+static const char* kPreLoadMapEvent = "Function ProjectX.EngineShare_X.EventPreLoadMap";
+static const char* kPostLoadMapEvent = "Function TAGame.LoadingScreen_TA.HandlePostLoadMap";
+static const char* kCountdownBeginEvent = "Function GameEvent_Soccar_TA.Countdown.BeginState";
+static const char* kReplayBeginEvent = "Function GameEvent_Soccar_TA.ReplayPlayback.BeginState";
+static const char* kReplayEndEvent = "Function GameEvent_Soccar_TA.ReplayPlayback.EndState";
+static const char* kLegacyReplayEvent = "Function TAGame.GameEvent_TA.OnReplayStarted";
+static const char* kPauseEvent = "Function ProjectX.GFxShell_X.SetGamePaused";
+static const char* kMatchEndedEvent = "Function TAGame.GameEvent_Soccar_TA.EventMatchEnded";
+static const char* kLegacyMatchEndedEvent = "Function TAGame.GameEvent_TA.OnMatchEnded";
+static const char* kMatchDestroyedEvent = "Function TAGame.GameEvent_Soccar_TA.Destroyed";
+
+struct DriverOptions {
+    std::string pluginPath = "./GameStatePlugin.so";
+    double seconds = 120.0;
+    int fps = 120;
+    int physicsHz = 120;
+    int cars = 6;
+    int matchSeconds = 60;
+    bool unpaced = false;
+    std::vector<std::string> commands;
+};
+
+// One match after another, advanced in fixed physics steps. Only the
+// fields the plugin reads are simulated; the ball bounces around the arena
+// and cars drive circles.
+class ScriptedMatch {
+public:
+    ScriptedMatch(FakeWorld& world, const DriverOptions& options)
+        : world(world), options(options), stage(Stage::menu), stageSeconds(0.0), playSeconds(0.0),
+          pauseSeconds(0.0), paused(false), pausedThisMatch(false), matches(0), goals(0) {}
+
+    // One physics step; fires the engine functions a real step would
+    void step(double dt) {
+        stageSeconds += dt;
+        switch (stage) {
+            case Stage::menu:
+                if (stageSeconds >= 2.0) loadMap();
+                break;
+            case Stage::countdown:
+                server().waitTimeRemaining = 3 - (int)stageSeconds;
+                if (stageSeconds >= 3.0) kickoff();
+                moveBodies(dt);
+                break;
+            case Stage::play:
+                if (paused) {
+                    stageSeconds -= dt;
+                    pauseSeconds += dt;
+                    if (pauseSeconds >= 2.0) setPaused(false);
+                    break;
+                }
+                playSeconds += dt;
+                server().secondsRemaining = std::max(0, options.matchSeconds - (int)playSeconds);
+                if (stageSeconds >= 1.0) server().ballHasBeenHit = true;
+                if (!pausedThisMatch && playSeconds >= options.matchSeconds / 2.0) {
+                    setPaused(true);
+                } else if (server().secondsRemaining == 0) {
+                    endMatch();
+                } else if (stageSeconds >= 15.0) {
+                    scoreGoal();
+                }
+                moveBodies(dt);
+                break;
+            case Stage::goalScored:
+                if (stageSeconds >= 2.0) beginReplay();
+                moveBodies(dt);
+                break;
+            case Stage::replay:
+                if (stageSeconds >= 4.0) endReplay();
+                moveBodies(dt);
+                break;
+            case Stage::podium:
+                if (stageSeconds >= 5.0) destroyMatch();
+                break;
+        }
+
+        FakeServer* active = world.server.get();
+        if (active && active->gameSpeed > 0.0f && stage != Stage::podium) {
+            ++active->physicsFrame;
+            active->ball.physicsFrame = active->physicsFrame;
+            active->ball.state.Time = (float)(active->physicsFrame / (double)options.physicsHz);
+            for (size_t i = 0; i < active->cars.size(); ++i) {
+                active->cars[i].physicsFrame = active->physicsFrame;
+                world.fire(kPhysicsTickEvent, reinterpret_cast<std::uintptr_t>(&active->cars[i]));
+            }
+        }
+    }
+
+    int getMatches() const { return matches; }
+    int getGoals() const { return goals; }
+
+private:
+    enum class Stage { menu, countdown, play, goalScored, replay, podium };
+
+    FakeWorld& world;
+    const DriverOptions& options;
+    Stage stage;
+    double stageSeconds;
+    double playSeconds;
+    double pauseSeconds;
+    bool paused;
+    bool pausedThisMatch;
+    int matches;
+    int goals;
+    float ballVelocity[3] = { 900.0f, -1300.0f, 1200.0f };
+    double carAngle = 0.0;
+
+    FakeServer& server() { return *world.server; }
+
+    void enter(Stage next) {
+        stage = next;
+        stageSeconds = 0.0;
+    }
+
+    void loadMap() {
+        world.fire(kPreLoadMapEvent);
+
+        // Cars are sized once per match; wrappers point into the vector
+        world.server.reset(new FakeServer());
+        server().cars.resize((size_t)options.cars);
+        for (size_t i = 0; i < server().cars.size(); ++i) {
+            server().cars[i].playerId = 1000 + (int)i;
+            server().cars[i].teamNum = (unsigned char)(i % 2);
+        }
+        world.localCar = 0;
+        world.inGame = true;
+        world.fire(kPostLoadMapEvent);
+
+        playSeconds = 0.0;
+        pausedThisMatch = false;
+        beginCountdown();
+    }
+
+    void beginCountdown() {
+        server().roundActive = false;
+        server().ballHasBeenHit = false;
+        server().waitTimeRemaining = 3;
+        server().ball.state.Location = Vector(0.0f, 0.0f, 93.0f);
+        enter(Stage::countdown);
+        world.fire(kCountdownBeginEvent, world.getServerAddress());
+    }
+
+    void kickoff() {
+        server().waitTimeRemaining = 0;
+        server().roundActive = true;
+        enter(Stage::play);
+    }
+
+    void setPaused(bool on) {
+        paused = on;
+        pausedThisMatch = true;
+        pauseSeconds = 0.0;
+        server().gameSpeed = on ? 0.0f : 1.0f;
+        world.fire(kPauseEvent);
+    }
+
+    void scoreGoal() {
+        server().teams[goals % 2].score++;
+        server().roundActive = false;
+        ++goals;
+        enter(Stage::goalScored);
+    }
+
+    void beginReplay() {
+        world.inReplay = true;
+        enter(Stage::replay);
+        world.fire(kReplayBeginEvent, world.getServerAddress());
+        world.fire(kLegacyReplayEvent);
+    }
+
+    void endReplay() {
+        world.inReplay = false;
+        world.fire(kReplayEndEvent);
+        beginCountdown();
+    }
+
+    void endMatch() {
+        server().matchEnded = true;
+        server().roundActive = false;
+        enter(Stage::podium);
+        world.fire(kMatchEndedEvent);
+        world.fire(kLegacyMatchEndedEvent);
+    }
+
+    void destroyMatch() {
+        world.fire(kMatchDestroyedEvent);
+        world.inGame = false;
+        world.server.reset();
+        ++matches;
+        enter(Stage::menu);
+    }
+
+    void moveBodies(double dt) {
+        // Ball: gravity, bounces off floor, walls and ceiling
+        RBState& ball = server().ball.state;
+        float* location[3] = { &ball.Location.X, &ball.Location.Y, &ball.Location.Z };
+        const float lo[3] = { -4000, -5000, 93 }, hi[3] = { 4000, 5000, 1950 };
+        ballVelocity[2] -= 650.0f * (float)dt;
+        for (int axis = 0; axis < 3; ++axis) {
+            *location[axis] += ballVelocity[axis] * (float)dt;
+            if (*location[axis] < lo[axis] || *location[axis] > hi[axis]) {
+                *location[axis] = std::min(std::max(*location[axis], lo[axis]), hi[axis]);
+                ballVelocity[axis] *= -0.6f;
+                if (axis == 2 && std::fabs(ballVelocity[2]) < 300.0f) ballVelocity[2] = 1400.0f;
+            }
+        }
+        ball.LinearVelocity = Vector(ballVelocity[0], ballVelocity[1], ballVelocity[2]);
+
+        // Cars: circles of different radii, boost draining and refilling
+        carAngle += dt;
+        for (size_t i = 0; i < server().cars.size(); ++i) {
+            FakeCar& car = server().cars[i];
+            double radius = 800.0 + 300.0 * (double)i;
+            double angle = carAngle * (1.0 + 0.1 * (double)i);
+            car.state.Location = Vector((float)(radius * std::cos(angle)), (float)(radius * std::sin(angle)), 17.0f);
+            car.state.LinearVelocity = Vector((float)(-radius * std::sin(angle)), (float)(radius * std::cos(angle)), 0.0f);
+            car.state.Quaternion = Quat((float)std::cos(angle / 2), 0.0f, 0.0f, (float)std::sin(angle / 2));
+            car.boost = (float)(0.5 + 0.5 * std::sin(angle * 0.3));
+            car.onGround = std::fmod(angle, 6.0) > 0.5;
+        }
+    }
+};
+
+static bool parseOptions(int argc, char** argv, DriverOptions& options) {
+    bool commandsGiven = false;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (strcmp(arg, "--plugin") == 0 && hasValue) {
+            options.pluginPath = argv[++i];
+        } else if (strcmp(arg, "--seconds") == 0 && hasValue) {
+            options.seconds = atof(argv[++i]);
+        } else if (strcmp(arg, "--fps") == 0 && hasValue) {
+            options.fps = atoi(argv[++i]);
+        } else if (strcmp(arg, "--physics-hz") == 0 && hasValue) {
+            options.physicsHz = atoi(argv[++i]);
+        } else if (strcmp(arg, "--cars") == 0 && hasValue) {
+            options.cars = atoi(argv[++i]);
+        } else if (strcmp(arg, "--match-seconds") == 0 && hasValue) {
+            options.matchSeconds = atoi(argv[++i]);
+        } else if (strcmp(arg, "--unpaced") == 0) {
+            options.unpaced = true;
+        } else if (strcmp(arg, "--command") == 0 && hasValue) {
+            options.commands.push_back(argv[++i]);
+            commandsGiven = true;
+        } else {
+            fprintf(stderr, "unknown or incomplete option: %s\n", arg);
+            return false;
+        }
+    }
+
+    if (options.fps <= 0 || options.physicsHz <= 0 || options.cars < 0 || options.matchSeconds <= 0) {
+        fprintf(stderr, "--fps, --physics-hz and --match-seconds must be positive\n");
+        return false;
+    }
+    if (!commandsGiven) {
+        options.commands = { "gamestate_hook_cost", "gamestate_net_stats" };
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    DriverOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        fprintf(stderr, "usage: %s [--plugin path] [--seconds N] [--fps N] [--physics-hz N] [--cars N]\n"
+                        "       [--match-seconds N] [--unpaced] [--command \"...\"]...\n", argv[0]);
+        return 2;
+    }
+
+    void* library = dlopen(options.pluginPath.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!library) {
+        fprintf(stderr, "dlopen failed: %s\n", dlerror());
+        return 1;
+    }
+
+    // What BakkesMod does with the DLL: read the export block, construct
+    // the plugin, hand it the wrappers, call onLoad
+    auto* info = static_cast<BakkesMod::Plugin::PluginInfo*>(dlsym(library, "exports"));
+    if (!info) {
+        fprintf(stderr, "%s has no plugin exports\n", options.pluginPath.c_str());
+        dlclose(library);
+        return 1;
+    }
+    fprintf(stderr, "Loaded %s %s (%s, API %d)\n", info->pluginName, info->pluginVersion,
+            info->className, info->apiBuildVersion);
+
+    FakeWorld world;
+    auto* pluginHandle = reinterpret_cast<std::shared_ptr<BakkesMod::Plugin::BakkesModPlugin>*>(info->initializeFunc());
+    std::shared_ptr<BakkesMod::Plugin::BakkesModPlugin> plugin = *pluginHandle;
+    plugin->cvarManager = std::make_shared<CVarManagerWrapper>(world.getAddress(), std::type_index(typeid(*plugin)));
+    plugin->gameWrapper = std::make_shared<GameWrapper>(world.getAddress());
+    plugin->onLoad();
+    fprintf(stderr, "onLoad: %zu hooks installed\n", world.getHookCount());
+
+    using DriverClock = std::chrono::steady_clock;
+    ScriptedMatch match(world, options);
+    LatencyHistogram frameCost;
+    FakeCanvas canvas;
+    const double frameSeconds = 1.0 / options.fps;
+    const double physicsSeconds = 1.0 / options.physicsHz;
+    const long long frames = (long long)(options.seconds * options.fps);
+    double gameSeconds = 0.0, physicsDue = 0.0;
+    size_t queuedRun = 0;
+
+    auto runStart = DriverClock::now();
+    for (long long frame = 0; frame < frames; ++frame) {
+        auto frameStart = DriverClock::now();
+
+        gameSeconds += frameSeconds;
+        while (physicsDue <= gameSeconds) {
+            match.step(physicsSeconds);
+            physicsDue += physicsSeconds;
+        }
+        world.fire(kTickEvent);
+        queuedRun += world.runQueued(plugin->gameWrapper.get(), gameSeconds);
+        world.render(canvas);
+
+        auto frameEnd = DriverClock::now();
+        frameCost.record((std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(frameEnd - frameStart).count());
+
+        if (!options.unpaced) {
+            std::this_thread::sleep_until(runStart + std::chrono::duration_cast<DriverClock::duration>(
+                std::chrono::duration<double>(gameSeconds)));
+        }
+    }
+    double wallSeconds = std::chrono::duration<double>(DriverClock::now() - runStart).count();
+    fflush(stdout);
+
+    for (const std::string& command : options.commands) {
+        fprintf(stderr, "> %s\n", command.c_str());
+        world.executeCommand(command);
+    }
+
+    fprintf(stderr, "%lld frames (%.0f game s, %d fps, %d Hz physics, %d cars) in %.2f s wall, %.0fx real time\n",
+            frames, options.seconds, options.fps, options.physicsHz, options.cars, wallSeconds,
+            wallSeconds > 0 ? options.seconds / wallSeconds : 0.0);
+    fprintf(stderr, "%d matches, %d goals, %zu queued callbacks run\n",
+            match.getMatches(), match.getGoals(), queuedRun);
+    fprintf(stderr, "%zu drawables, %zu strings and %zu boxes in the last frame\n",
+            world.getDrawableCount(), canvas.strings, canvas.boxes);
+    fprintf(stderr, "frame cost (tick + physics hooks + drawables%s): p50 %llu ns, p99 %llu ns, max %llu ns\n",
+            options.unpaced ? ", unpaced: timers mostly idle" : "",
+            (unsigned long long)frameCost.percentile(0.50), (unsigned long long)frameCost.percentile(0.99),
+            (unsigned long long)frameCost.getMax());
+
+    // Unload the way BakkesMod does: onUnload, drop the plugin's hooks and
+    // notifiers, delete it, unload the library
+    plugin->onUnload();
+    world.clearPluginState();
+    plugin.reset();
+    info->delFunc();
+    dlclose(library);
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include "FakeWorld.h"
+#include "bakkesmod/wrappers/canvaswrapper.h"
+#include <cstdio>
+#include <sstream>
+
+FakeWorld::FakeWorld() : lastNowSeconds(0.0) {
+}
+
+void FakeWorld::addHook(const std::string& eventName, Hook hook, bool post) {
+    (post ? postHooks : preHooks)[eventName].push_back(std::move(hook));
+}
+
+void FakeWorld::removeHooks(const std::string& eventName, bool post) {
+    (post ? postHooks : preHooks).erase(eventName);
+}
+
+void FakeWorld::fire(const std::string& eventName, std::uintptr_t caller) {
+    auto pre = preHooks.find(eventName);
+    if (pre != preHooks.end()) {
+        for (const Hook& hook : pre->second) {
+            hook(caller, nullptr, eventName);
+        }
+    }
+
+    auto post = postHooks.find(eventName);
+    if (post != postHooks.end()) {
+        for (const Hook& hook : post->second) {
+            hook(caller, nullptr, eventName);
+        }
+    }
+}
+
+size_t FakeWorld::getHookCount() const {
+    size_t count = 0;
+    for (const auto& entry : preHooks) count += entry.second.size();
+    for (const auto& entry : postHooks) count += entry.second.size();
+    return count;
+}
+
+void FakeWorld::queue(std::function<void(GameWrapper*)> callback) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    queued.push_back(std::move(callback));
+}
+
+void FakeWorld::queueAfter(std::function<void(GameWrapper*)> callback, double delaySeconds) {
+    timeouts.push_back({ lastNowSeconds + delaySeconds, std::move(callback) });
+}
+
+size_t FakeWorld::runQueued(GameWrapper* gameWrapper, double nowSeconds) {
+    lastNowSeconds = nowSeconds;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        running.swap(queued);
+    }
+
+    size_t ran = running.size();
+    for (auto& callback : running) {
+        callback(gameWrapper);
+    }
+    running.clear();
+
+    // Timeouts may add timeouts; take the due ones out first
+    std::vector<Timeout> due;
+    for (size_t i = 0; i < timeouts.size();) {
+        if (timeouts[i].dueSeconds <= nowSeconds) {
+            due.push_back(std::move(timeouts[i]));
+            timeouts[i] = std::move(timeouts.back());
+            timeouts.pop_back();
+        } else {
+            ++i;
+        }
+    }
+    for (Timeout& timeout : due) {
+        timeout.callback(gameWrapper);
+    }
+    return ran + due.size();
+}
+
+void FakeWorld::addDrawable(Drawable drawable) {
+    drawables.push_back(std::move(drawable));
+}
+
+void FakeWorld::clearDrawables() {
+    drawables.clear();
+}
+
+void FakeWorld::render(FakeCanvas& canvas) {
+    canvas.position = { 0, 0 };
+    canvas.strings = 0;
+    canvas.boxes = 0;
+    for (const Drawable& drawable : drawables) {
+        drawable(CanvasWrapper(reinterpret_cast<std::uintptr_t>(&canvas)));
+    }
+}
+
+void FakeWorld::registerNotifier(const std::string& name, Notifier notifier, const std::string& description) {
+    notifiers[name] = std::move(notifier);
+}
+
+bool FakeWorld::removeNotifier(const std::string& name) {
+    return notifiers.erase(name) > 0;
+}
+
+bool FakeWorld::executeCommand(const std::string& line) {
+    std::vector<std::string> params;
+    std::istringstream stream(line);
+    std::string word;
+    while (stream >> word) {
+        params.push_back(word);
+    }
+    if (params.empty()) return false;
+
+    auto found = notifiers.find(params[0]);
+    if (found == notifiers.end()) {
+        log("Unknown command: " + params[0]);
+        return false;
+    }
+    found->second(params);
+    return true;
+}
+
+void FakeWorld::log(const std::string& text) {
+    std::lock_guard<std::mutex> lock(logMutex);
+    if (logSink) {
+        logSink(text);
+    } else {
+        std::printf("[plugin] %s\n", text.c_str());
+    }
+}
+
+void FakeWorld::setLogSink(LogSink sink) {
+    std::lock_guard<std::mutex> lock(logMutex);
+    logSink = std::move(sink);
+}
+
+void FakeWorld::clearPluginState() {
+    preHooks.clear();
+    postHooks.clear();
+    notifiers.clear();
+    drawables.clear();
+    std::lock_guard<std::mutex> lock(queueMutex);
+    queued.clear();
+    timeouts.clear();
+}
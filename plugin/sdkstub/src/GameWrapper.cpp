@@ -0,0 +1,103 @@
+#include "bakkesmod/wrappers/GameWrapper.h"
+#include "bakkesmod/wrappers/CVarManagerWrapper.h"
+#include "FakeWorld.h"
+
+GameWrapper::GameWrapper(std::uintptr_t mem) : world(reinterpret_cast<FakeWorld*>(mem)) {
+}
+
+bool GameWrapper::IsInGame() { return world->inGame; }
+bool GameWrapper::IsInOnlineGame() { return world->inOnlineGame; }
+bool GameWrapper::IsInReplay() { return world->inReplay; }
+
+ServerWrapper GameWrapper::GetOnlineGame() {
+    return ServerWrapper(world->inOnlineGame ? world->getServerAddress() : 0);
+}
+
+ServerWrapper GameWrapper::GetGameEventAsServer() {
+    return ServerWrapper(world->inGame && !world->inOnlineGame ? world->getServerAddress() : 0);
+}
+
+CarWrapper GameWrapper::GetLocalCar() {
+    FakeServer* server = world->server.get();
+    if (!server || world->localCar < 0 || world->localCar >= (int)server->cars.size()) {
+        return CarWrapper(0);
+    }
+    return CarWrapper(reinterpret_cast<std::uintptr_t>(&server->cars[(size_t)world->localCar]));
+}
+
+void GameWrapper::SetTimeout(std::function<void(GameWrapper*)> theLambda, float time) {
+    world->queueAfter(std::move(theLambda), time);
+}
+
+void GameWrapper::Execute(std::function<void(GameWrapper*)> theLambda) {
+    world->queue(std::move(theLambda));
+}
+
+void GameWrapper::RegisterDrawable(std::function<void(CanvasWrapper)> callback) {
+    world->addDrawable(std::move(callback));
+}
+
+void GameWrapper::UnregisterDrawables() {
+    world->clearDrawables();
+}
+
+void GameWrapper::HookEvent(std::string eventName, std::function<void(std::string eventName)> callback) {
+    world->addHook(eventName, [callback](std::uintptr_t, void*, const std::string& name) { callback(name); }, false);
+}
+
+void GameWrapper::UnhookEvent(std::string eventName) {
+    world->removeHooks(eventName, false);
+}
+
+void GameWrapper::HookEventPost(std::string eventName, std::function<void(std::string eventName)> callback) {
+    world->addHook(eventName, [callback](std::uintptr_t, void*, const std::string& name) { callback(name); }, true);
+}
+
+void GameWrapper::UnhookEventPost(std::string eventName) {
+    world->removeHooks(eventName, true);
+}
+
+template<typename T>
+void GameWrapper::HookEventWithCaller(std::string eventName, std::function<void(T caller, void* params, std::string eventName)> callback) {
+    world->addHook(eventName, [callback](std::uintptr_t caller, void* params, const std::string& name) {
+        callback(T(caller), params, name);
+    }, false);
+}
+
+template<typename T>
+void GameWrapper::HookEventWithCallerPost(std::string eventName, std::function<void(T caller, void* params, std::string eventName)> callback) {
+    world->addHook(eventName, [callback](std::uintptr_t caller, void* params, const std::string& name) {
+        callback(T(caller), params, name);
+    }, true);
+}
+
+template void GameWrapper::HookEventWithCaller<ServerWrapper>(std::string, std::function<void(ServerWrapper, void*, std::string)>);
+template void GameWrapper::HookEventWithCaller<CarWrapper>(std::string, std::function<void(CarWrapper, void*, std::string)>);
+template void GameWrapper::HookEventWithCaller<BallWrapper>(std::string, std::function<void(BallWrapper, void*, std::string)>);
+template void GameWrapper::HookEventWithCallerPost<ServerWrapper>(std::string, std::function<void(ServerWrapper, void*, std::string)>);
+template void GameWrapper::HookEventWithCallerPost<CarWrapper>(std::string, std::function<void(CarWrapper, void*, std::string)>);
+template void GameWrapper::HookEventWithCallerPost<BallWrapper>(std::string, std::function<void(BallWrapper, void*, std::string)>);
+
+CVarManagerWrapper::CVarManagerWrapper(std::uintptr_t mem, std::type_index pluginIdx)
+    : world(reinterpret_cast<FakeWorld*>(mem)) {
+}
+
+void CVarManagerWrapper::executeCommand(std::string command, bool log) {
+    world->executeCommand(command);
+}
+
+void CVarManagerWrapper::registerNotifier(std::string cvar, commandNotifier notifier, std::string description, unsigned char permissions) {
+    world->registerNotifier(cvar, notifier, description);
+}
+
+void CVarManagerWrapper::registerNotifier(std::string cvar, std::function<void(std::vector<std::string>)> notifier, std::string description, unsigned char permissions) {
+    world->registerNotifier(cvar, std::move(notifier), description);
+}
+
+bool CVarManagerWrapper::removeNotifier(std::string cvar) {
+    return world->removeNotifier(cvar);
+}
+
+void CVarManagerWrapper::log(std::string text) {
+    world->log(text);
+}
@@ -0,0 +1,104 @@
+#include "bakkesmod/wrappers/GameEvent/ServerWrapper.h"
+#include "bakkesmod/wrappers/GameEvent/ReplayWrapper.h"
+#include "bakkesmod/wrappers/GameObject/CameraWrapper.h"
+#include "bakkesmod/wrappers/canvaswrapper.h"
+#include "FakeWorld.h"
+
+template<typename T>
+static T* fake(std::uintptr_t address) {
+    return reinterpret_cast<T*>(address);
+}
+
+ObjectWrapper::ObjectWrapper(std::uintptr_t mem) : memory_address(mem) {}
+
+ActorWrapper::ActorWrapper(std::uintptr_t mem) : ObjectWrapper(mem) {}
+bool ActorWrapper::IsNull() const { return memory_address == 0; }
+ActorWrapper::operator bool() const { return memory_address != 0; }
+
+// RBActorWrapper: cars and the ball
+RBActorWrapper::RBActorWrapper(std::uintptr_t mem) : ActorWrapper(mem) {}
+
+RBState RBActorWrapper::GetRBState() {
+    return memory_address ? fake<FakeBody>(memory_address)->state : RBState();
+}
+
+int RBActorWrapper::GetPhysicsFrame() {
+    return memory_address ? fake<FakeBody>(memory_address)->physicsFrame : 0;
+}
+
+BallWrapper::BallWrapper(std::uintptr_t mem) : RBActorWrapper(mem) {}
+
+CarWrapper::CarWrapper(std::uintptr_t mem) : RBActorWrapper(mem) {}
+PriWrapper CarWrapper::GetPRI() { return PriWrapper(memory_address); }
+BoostWrapper CarWrapper::GetBoostComponent() { return BoostWrapper(memory_address); }
+bool CarWrapper::IsOnGround() { return memory_address && fake<FakeCar>(memory_address)->onGround; }
+
+PriWrapper::PriWrapper(std::uintptr_t mem) : ActorWrapper(mem) {}
+int PriWrapper::GetPlayerID() { return memory_address ? fake<FakeCar>(memory_address)->playerId : 0; }
+unsigned char PriWrapper::GetTeamNum() { return memory_address ? fake<FakeCar>(memory_address)->teamNum : 0; }
+
+BoostWrapper::BoostWrapper(std::uintptr_t mem) : ActorWrapper(mem) {}
+float BoostWrapper::GetCurrentBoostAmount() { return memory_address ? fake<FakeCar>(memory_address)->boost : 0.0f; }
+
+TeamWrapper::TeamWrapper(std::uintptr_t mem) : ActorWrapper(mem) {}
+int TeamWrapper::GetScore() { return memory_address ? fake<FakeTeam>(memory_address)->score : 0; }
+unsigned char TeamWrapper::GetTeamNum() { return memory_address ? fake<FakeTeam>(memory_address)->teamNum : 0; }
+
+CameraWrapper::CameraWrapper(std::uintptr_t mem) : ActorWrapper(mem) {}
+ReplayDirectorWrapper::ReplayDirectorWrapper(std::uintptr_t mem) : ActorWrapper(mem) {}
+ReplayWrapper::ReplayWrapper(std::uintptr_t mem) : ObjectWrapper(mem) {}
+bool ReplayWrapper::IsNull() const { return memory_address == 0; }
+
+// ServerWrapper
+ServerWrapper::ServerWrapper(std::uintptr_t mem) : ActorWrapper(mem) {}
+
+BallWrapper ServerWrapper::GetBall() {
+    return BallWrapper(memory_address ? reinterpret_cast<std::uintptr_t>(&fake<FakeServer>(memory_address)->ball) : 0);
+}
+
+ArrayWrapper<CarWrapper> ServerWrapper::GetCars() {
+    std::vector<std::uintptr_t> items;
+    if (memory_address) {
+        for (FakeCar& car : fake<FakeServer>(memory_address)->cars) {
+            items.push_back(reinterpret_cast<std::uintptr_t>(&car));
+        }
+    }
+    return ArrayWrapper<CarWrapper>(std::move(items));
+}
+
+ArrayWrapper<TeamWrapper> ServerWrapper::GetTeams() {
+    std::vector<std::uintptr_t> items;
+    if (memory_address) {
+        for (FakeTeam& team : fake<FakeServer>(memory_address)->teams) {
+            items.push_back(reinterpret_cast<std::uintptr_t>(&team));
+        }
+    }
+    return ArrayWrapper<TeamWrapper>(std::move(items));
+}
+
+ReplayDirectorWrapper ServerWrapper::GetReplayDirector() {
+    return ReplayDirectorWrapper(memory_address && fake<FakeServer>(memory_address)->hasReplayDirector ? memory_address : 0);
+}
+
+int ServerWrapper::GetSecondsRemaining() { return memory_address ? fake<FakeServer>(memory_address)->secondsRemaining : 0; }
+int ServerWrapper::GetWaitTimeRemaining() { return memory_address ? fake<FakeServer>(memory_address)->waitTimeRemaining : 0; }
+float ServerWrapper::GetGameSpeed() { return memory_address ? fake<FakeServer>(memory_address)->gameSpeed : 1.0f; }
+unsigned long ServerWrapper::GetbRoundActive() { return memory_address && fake<FakeServer>(memory_address)->roundActive; }
+unsigned long ServerWrapper::GetbBallHasBeenHit() { return memory_address && fake<FakeServer>(memory_address)->ballHasBeenHit; }
+unsigned long ServerWrapper::GetbOverTime() { return memory_address && fake<FakeServer>(memory_address)->overTime; }
+unsigned long ServerWrapper::GetbMatchEnded() { return memory_address && fake<FakeServer>(memory_address)->matchEnded; }
+
+// CanvasWrapper
+CanvasWrapper::CanvasWrapper(std::uintptr_t mem) : ObjectWrapper(mem) {}
+void CanvasWrapper::SetPosition(Vector2 pos) { fake<FakeCanvas>(memory_address)->position = pos; }
+void CanvasWrapper::SetColor(char Red, char Green, char Blue, char Alpha) {}
+void CanvasWrapper::FillBox(Vector2 size) { ++fake<FakeCanvas>(memory_address)->boxes; }
+void CanvasWrapper::DrawString(std::string text) { DrawString(std::move(text), 1.0f, 1.0f); }
+
+void CanvasWrapper::DrawString(std::string text, float xScale, float yScale) {
+    FakeCanvas* canvas = fake<FakeCanvas>(memory_address);
+    ++canvas->strings;
+    canvas->lastString = std::move(text);
+}
+
+Vector2 CanvasWrapper::GetSize() { return fake<FakeCanvas>(memory_address)->size; }
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+// Receive buffer for stream parsers. Bytes are appended at the write cursor
+// and consumed from the read cursor. Instead of wrapping around, the ring
+// rewinds: when the tail runs out of room, the unread bytes (normally a
+// partial frame) slide back to the front. Unread data is therefore always
+// contiguous and can be handed out as a string_view without copying.
+class ByteRing {
+public:
+    explicit ByteRing(size_t capacity)
+        : buffer(capacity), readPos(0), writePos(0) {
+    }
+
+    // Unread bytes
+    const char* data() const { return buffer.data() + readPos; }
+    char* data() { return buffer.data() + readPos; }
+    size_t size() const { return writePos - readPos; }
+    size_t capacity() const { return buffer.size(); }
+
+    // Writable space after making room for at least minBytes (rewinding
+    // first, growing only if the unread bytes plus minBytes do not fit)
+    char* prepareWrite(size_t minBytes, size_t& available) {
+        if (buffer.size() - writePos < minBytes) {
+            rewind();
+            if (buffer.size() - writePos < minBytes) {
+                size_t newSize = buffer.size() * 2;
+                while (newSize - writePos < minBytes) newSize *= 2;
+                buffer.resize(newSize);
+            }
+        }
+        available = buffer.size() - writePos;
+        return buffer.data() + writePos;
+    }
+
+    void commitWrite(size_t bytes) {
+        writePos += bytes;
+    }
+
+    void consume(size_t bytes) {
+        readPos += bytes;
+        if (readPos == writePos) {
+            readPos = writePos = 0;  // empty: rewind for free
+        }
+    }
+
+    void clear() {
+        readPos = writePos = 0;
+    }
+
+private:
+    void rewind() {
+        if (readPos == 0) return;
+        size_t unread = writePos - readPos;
+        std::memmove(buffer.data(), buffer.data() + readPos, unread);
+        readPos = 0;
+        writePos = unread;
+    }
+
+    std::vector<char> buffer;
+    size_t readPos;
+    size_t writePos;
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <chrono>
+
+// Millisecond time source for timer-driven code (TimerWheel, SignalDebouncer).
+// The plugin uses SteadyClock; the debounce simulation drives a
+// VirtualClock by hand so every run is deterministic.
+class Clock {
+public:
+    virtual ~Clock() = default;
+
+    // Milliseconds since an arbitrary, fixed epoch; never goes backwards
+    virtual std::chrono::milliseconds now() const = 0;
+};
+
+class SteadyClock : public Clock {
+public:
+    std::chrono::milliseconds now() const override {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch());
+    }
+};
+
+class VirtualClock : public Clock {
+public:
+    explicit VirtualClock(std::chrono::milliseconds start = std::chrono::milliseconds(0))
+        : current(start) {
+    }
+
+    std::chrono::milliseconds now() const override { return current; }
+    void advance(std::chrono::milliseconds delta) { current += delta; }
+
+private:
+    std::chrono::milliseconds current;
+};
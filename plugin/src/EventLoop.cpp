@@ -0,0 +1,437 @@
+#include "EventLoop.h"
+#include <algorithm>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+
+// OS readiness backend. Exactly one implementation is compiled per platform.
+class EventLoop::Poller {
+public:
+    struct Ready {
+        SocketHandle socket;
+        unsigned events;
+    };
+
+    Poller();
+    ~Poller();
+
+    bool isValid() const;
+    bool add(SocketHandle socket, unsigned interest);
+    bool modify(SocketHandle socket, unsigned interest);
+    void remove(SocketHandle socket);
+    int wait(int timeoutMs, std::vector<Ready>& ready);
+
+private:
+#ifdef _WIN32
+    std::vector<WSAPOLLFD> pollFds;
+#else
+    int epollFd;
+    std::vector<epoll_event> events;
+#endif
+};
+
+#ifdef _WIN32
+
+// ---- WSAPoll backend ------------------------------------------------------
+
+static SHORT toPollEvents(unsigned interest) {
+    SHORT events = 0;
+    if (interest & EventLoop::Readable) events |= POLLRDNORM;
+    if (interest & EventLoop::Writable) events |= POLLWRNORM;
+    return events;
+}
+
+EventLoop::Poller::Poller() {
+}
+
+EventLoop::Poller::~Poller() {
+}
+
+bool EventLoop::Poller::isValid() const {
+    return true;
+}
+
+bool EventLoop::Poller::add(SocketHandle socket, unsigned interest) {
+    WSAPOLLFD pfd = {};
+    pfd.fd = socket;
+    pfd.events = toPollEvents(interest);
+    pollFds.push_back(pfd);
+    return true;
+}
+
+bool EventLoop::Poller::modify(SocketHandle socket, unsigned interest) {
+    for (auto& pfd : pollFds) {
+        if (pfd.fd == socket) {
+            pfd.events = toPollEvents(interest);
+            return true;
+        }
+    }
+    return false;
+}
+
+void EventLoop::Poller::remove(SocketHandle socket) {
+    pollFds.erase(std::remove_if(pollFds.begin(), pollFds.end(),
+        [socket](const WSAPOLLFD& pfd) { return pfd.fd == socket; }), pollFds.end());
+}
+
+int EventLoop::Poller::wait(int timeoutMs, std::vector<Ready>& ready) {
+    ready.clear();
+
+    // WSAPoll rejects an empty set, so a timers-only loop just waits out the timeout
+    if (pollFds.empty()) {
+        if (timeoutMs > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(timeoutMs));
+        }
+        return 0;
+    }
+
+    int result = WSAPoll(pollFds.data(), (ULONG)pollFds.size(), timeoutMs);
+    if (result == SOCKET_ERROR) {
+        return -1;
+    }
+
+    for (auto& pfd : pollFds) {
+        if (pfd.revents == 0) continue;
+
+        unsigned events = 0;
+        if (pfd.revents & (POLLRDNORM | POLLRDBAND)) events |= EventLoop::Readable;
+        if (pfd.revents & POLLWRNORM) events |= EventLoop::Writable;
+        if (pfd.revents & (POLLHUP | POLLERR | POLLNVAL)) events |= EventLoop::Closed;
+        ready.push_back({ pfd.fd, events });
+        pfd.revents = 0;
+    }
+
+    return (int)ready.size();
+}
+
+#else
+
+// ---- epoll backend --------------------------------------------------------
+
+static uint32_t toEpollEvents(unsigned interest) {
+    uint32_t events = EPOLLRDHUP;
+    if (interest & EventLoop::Readable) events |= EPOLLIN;
+    if (interest & EventLoop::Writable) events |= EPOLLOUT;
+    return events;
+}
+
+EventLoop::Poller::Poller()
+    : epollFd(epoll_create1(EPOLL_CLOEXEC)), events(64) {
+}
+
+EventLoop::Poller::~Poller() {
+    if (epollFd >= 0) {
+        ::close(epollFd);
+    }
+}
+
+bool EventLoop::Poller::isValid() const {
+    return epollFd >= 0;
+}
+
+bool EventLoop::Poller::add(SocketHandle socket, unsigned interest) {
+    epoll_event ev = {};
+    ev.events = toEpollEvents(interest);
+    ev.data.fd = socket;
+    return epoll_ctl(epollFd, EPOLL_CTL_ADD, socket, &ev) == 0;
+}
+
+bool EventLoop::Poller::modify(SocketHandle socket, unsigned interest) {
+    epoll_event ev = {};
+    ev.events = toEpollEvents(interest);
+    ev.data.fd = socket;
+    return epoll_ctl(epollFd, EPOLL_CTL_MOD, socket, &ev) == 0;
+}
+
+void EventLoop::Poller::remove(SocketHandle socket) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, socket, nullptr);
+}
+
+int EventLoop::Poller::wait(int timeoutMs, std::vector<Ready>& ready) {
+    ready.clear();
+
+    int count = epoll_wait(epollFd, events.data(), (int)events.size(), timeoutMs);
+    if (count < 0) {
+        return (errno == EINTR) ? 0 : -1;
+    }
+
+    for (int i = 0; i < count; ++i) {
+        unsigned flags = 0;
+        if (events[i].events & EPOLLIN) flags |= EventLoop::Readable;
+        if (events[i].events & EPOLLOUT) flags |= EventLoop::Writable;
+        if (events[i].events & (EPOLLHUP | EPOLLERR | EPOLLRDHUP)) flags |= EventLoop::Closed;
+        ready.push_back({ events[i].data.fd, flags });
+    }
+
+    // Grow the batch if the kernel filled it, so bursts drain in fewer waits
+    if (count == (int)events.size()) {
+        events.resize(events.size() * 2);
+    }
+
+    return count;
+}
+
+#endif
+
+// ---- EventLoop ------------------------------------------------------------
+
+EventLoop::EventLoop()
+    : poller(std::make_unique<Poller>()), nextTimerId(1),
+      wakeHandle(INVALID_SOCKET), wakePending(false) {
+    if (poller->isValid() && openWakeChannel()) {
+        watch(wakeHandle, Readable, [this](unsigned) {
+            drainWakeChannel();
+        });
+    }
+}
+
+EventLoop::~EventLoop() {
+    if (wakeHandle != INVALID_SOCKET) {
+        unwatch(wakeHandle);
+    }
+    closeWakeChannel();
+}
+
+// Check that the OS backend and wakeup channel are usable
+bool EventLoop::isValid() const {
+    return poller && poller->isValid() && wakeHandle != INVALID_SOCKET;
+}
+
+#ifdef _WIN32
+
+// WSAPoll only accepts sockets, so wake through a UDP socket connected to itself
+bool EventLoop::openWakeChannel() {
+    SocketHandle s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s == INVALID_SOCKET) {
+        return false;
+    }
+
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int len = sizeof(addr);
+
+    if (bind(s, (sockaddr*)&addr, sizeof(addr)) == SOCKET_ERROR ||
+        getsockname(s, (sockaddr*)&addr, &len) == SOCKET_ERROR ||
+        ::connect(s, (sockaddr*)&addr, sizeof(addr)) == SOCKET_ERROR ||
+        !setSocketNonBlocking(s, true)) {
+        closesocket(s);
+        return false;
+    }
+
+    wakeHandle = s;
+    return true;
+}
+
+void EventLoop::closeWakeChannel() {
+    if (wakeHandle != INVALID_SOCKET) {
+        closesocket(wakeHandle);
+        wakeHandle = INVALID_SOCKET;
+    }
+}
+
+void EventLoop::wakeup() {
+    if (!wakePending.exchange(true, std::memory_order_acq_rel)) {
+        char byte = 1;
+        send(wakeHandle, &byte, 1, 0);
+    }
+}
+
+void EventLoop::drainWakeChannel() {
+    char buffer[64];
+    while (recv(wakeHandle, buffer, sizeof(buffer), 0) > 0) {
+    }
+    // Clear before running the callback so a wakeup racing with it is not lost
+    wakePending.store(false, std::memory_order_release);
+    if (onWake) {
+        onWake();
+    }
+}
+
+#else
+
+bool EventLoop::openWakeChannel() {
+    int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    wakeHandle = fd;
+    return true;
+}
+
+void EventLoop::closeWakeChannel() {
+    if (wakeHandle != INVALID_SOCKET) {
+        ::close(wakeHandle);
+        wakeHandle = INVALID_SOCKET;
+    }
+}
+
+void EventLoop::wakeup() {
+    if (!wakePending.exchange(true, std::memory_order_acq_rel)) {
+        std::uint64_t one = 1;
+        ssize_t ignored = ::write(wakeHandle, &one, sizeof(one));
+        (void)ignored;
+    }
+}
+
+void EventLoop::drainWakeChannel() {
+    std::uint64_t count;
+    ssize_t ignored = ::read(wakeHandle, &count, sizeof(count));
+    (void)ignored;
+    // Clear before running the callback so a wakeup racing with it is not lost
+    wakePending.store(false, std::memory_order_release);
+    if (onWake) {
+        onWake();
+    }
+}
+
+#endif
+
+// Set the callback run on the loop thread after wakeup()
+void EventLoop::setWakeCallback(WakeCallback callback) {
+    onWake = std::move(callback);
+}
+
+// Register a socket with the given interest set
+bool EventLoop::watch(SocketHandle socket, unsigned interest, IoCallback callback) {
+    if (watches.count(socket) || !poller->add(socket, interest)) {
+        return false;
+    }
+
+    watches[socket] = std::make_shared<Watch>(Watch{ socket, interest, std::move(callback) });
+    return true;
+}
+
+// Change which readiness events a socket is notified for
+bool EventLoop::updateInterest(SocketHandle socket, unsigned interest) {
+    auto it = watches.find(socket);
+    if (it == watches.end()) {
+        return false;
+    }
+
+    if (it->second->interest == interest) {
+        return true;
+    }
+
+    it->second->interest = interest;
+    return poller->modify(socket, interest);
+}
+
+// Stop watching a socket (must be called before the socket is closed)
+void EventLoop::unwatch(SocketHandle socket) {
+    auto it = watches.find(socket);
+    if (it == watches.end()) {
+        return;
+    }
+
+    poller->remove(socket);
+    watches.erase(it);
+}
+
+// Schedule a one-shot timer
+EventLoop::TimerId EventLoop::addTimer(std::chrono::milliseconds delay, TimerCallback callback) {
+    return scheduleTimer(delay, Clock::duration::zero(), std::move(callback));
+}
+
+// Schedule a timer that fires every period until cancelled
+EventLoop::TimerId EventLoop::addPeriodicTimer(std::chrono::milliseconds period, TimerCallback callback) {
+    return scheduleTimer(period, period, std::move(callback));
+}
+
+// Cancel a pending timer (stale heap entries are skipped when they surface)
+void EventLoop::cancelTimer(TimerId id) {
+    timers.erase(id);
+}
+
+EventLoop::TimerId EventLoop::scheduleTimer(Clock::duration delay, Clock::duration period, TimerCallback callback) {
+    TimerId id = nextTimerId++;
+    timers[id] = Timer{ std::move(callback), period };
+    timerQueue.push({ Clock::now() + delay, id });
+    return id;
+}
+
+// Poll timeout: time until the earliest live timer, capped by maxWaitMs.
+// Cancelled entries on top are dropped first so they cannot cut the wait short.
+int EventLoop::computeTimeoutMs(int maxWaitMs) {
+    while (!timerQueue.empty() && timers.find(timerQueue.top().id) == timers.end()) {
+        timerQueue.pop();
+    }
+    if (timerQueue.empty()) {
+        return maxWaitMs;
+    }
+
+    auto untilNext = timerQueue.top().deadline - Clock::now();
+    if (untilNext <= Clock::duration::zero()) {
+        return 0;
+    }
+
+    // Round up so we never wake just before the deadline and spin
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(untilNext + std::chrono::microseconds(999)).count();
+    if (maxWaitMs >= 0 && ms > maxWaitMs) {
+        return maxWaitMs;
+    }
+    return (int)ms;
+}
+
+// Run every timer whose deadline has passed
+int EventLoop::dispatchTimers() {
+    int dispatched = 0;
+    auto now = Clock::now();
+
+    while (!timerQueue.empty() && timerQueue.top().deadline <= now) {
+        TimerEntry entry = timerQueue.top();
+        timerQueue.pop();
+
+        auto it = timers.find(entry.id);
+        if (it == timers.end()) {
+            continue;  // cancelled
+        }
+
+        TimerCallback callback = it->second.callback;
+        if (it->second.period > Clock::duration::zero()) {
+            // Stay on the original schedule, but resync after a stall rather
+            // than firing once for every missed period
+            auto next = entry.deadline + it->second.period;
+            if (next <= now) {
+                next = now + it->second.period;
+            }
+            timerQueue.push({ next, entry.id });
+        } else {
+            timers.erase(it);
+        }
+
+        callback();
+        ++dispatched;
+    }
+
+    return dispatched;
+}
+
+// Wait for readiness, then dispatch socket callbacks and due timers
+int EventLoop::runOnce(int maxWaitMs) {
+    static thread_local std::vector<Poller::Ready> ready;
+
+    int count = poller->wait(computeTimeoutMs(maxWaitMs), ready);
+    if (count < 0) {
+        return -1;
+    }
+
+    int dispatched = 0;
+    for (const auto& item : ready) {
+        auto it = watches.find(item.socket);
+        if (it == watches.end()) {
+            continue;  // unwatched by an earlier callback in this batch
+        }
+
+        // Hold a reference so the callback may unwatch its own socket
+        std::shared_ptr<Watch> watch = it->second;
+        watch->callback(item.events);
+        ++dispatched;
+    }
+
+    return dispatched + dispatchTimers();
+}
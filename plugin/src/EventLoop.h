@@ -0,0 +1,104 @@
+#pragma once
+
+#include "NetPlatform.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+// Readiness-based reactor that drives socket reads, writes and timers
+// from a single thread. The OS backend is WSAPoll on Windows and epoll
+// on Linux; both sit behind the private Poller interface.
+//
+// All methods must be called from the thread that runs the loop (or
+// before that thread is started), except wakeup(), which any thread may
+// call to interrupt a wait.
+class EventLoop {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimerId = std::uint64_t;
+
+    // Readiness flags passed to socket callbacks
+    enum IoEvent : unsigned {
+        Readable = 1u << 0,
+        Writable = 1u << 1,
+        Closed   = 1u << 2   // hang-up or socket error
+    };
+
+    using IoCallback = std::function<void(unsigned events)>;
+    using TimerCallback = std::function<void()>;
+    using WakeCallback = std::function<void()>;
+
+    EventLoop();
+    ~EventLoop();
+
+    // True if the OS backend was created successfully
+    bool isValid() const;
+
+    // Socket registration
+    bool watch(SocketHandle socket, unsigned interest, IoCallback callback);
+    bool updateInterest(SocketHandle socket, unsigned interest);
+    void unwatch(SocketHandle socket);
+
+    // Timers (one-shot and periodic)
+    TimerId addTimer(std::chrono::milliseconds delay, TimerCallback callback);
+    TimerId addPeriodicTimer(std::chrono::milliseconds period, TimerCallback callback);
+    void cancelTimer(TimerId id);
+
+    // Cross-thread wakeup. Repeated calls before the loop runs collapse into
+    // one; the wake callback then runs on the loop thread.
+    void wakeup();
+    void setWakeCallback(WakeCallback callback);
+
+    // Wait for readiness or the next timer, bounded by maxWaitMs (-1 = no bound),
+    // then dispatch. Returns the number of callbacks run, or -1 on backend error.
+    int runOnce(int maxWaitMs);
+
+    class Poller;
+
+private:
+    struct Watch {
+        SocketHandle socket;
+        unsigned interest;
+        IoCallback callback;
+    };
+
+    struct Timer {
+        TimerCallback callback;
+        Clock::duration period;   // zero for one-shot timers
+    };
+
+    struct TimerEntry {
+        Clock::time_point deadline;
+        TimerId id;
+        bool operator>(const TimerEntry& other) const { return deadline > other.deadline; }
+    };
+
+    std::unique_ptr<Poller> poller;
+    std::unordered_map<SocketHandle, std::shared_ptr<Watch>> watches;
+
+    std::priority_queue<TimerEntry, std::vector<TimerEntry>, std::greater<TimerEntry>> timerQueue;
+    std::unordered_map<TimerId, Timer> timers;
+    TimerId nextTimerId;
+
+    // Wakeup channel: eventfd on Linux, a self-connected UDP socket on Windows
+    SocketHandle wakeHandle;
+    std::atomic<bool> wakePending;
+    WakeCallback onWake;
+
+    bool openWakeChannel();
+    void closeWakeChannel();
+    void drainWakeChannel();
+
+    TimerId scheduleTimer(Clock::duration delay, Clock::duration period, TimerCallback callback);
+    int computeTimeoutMs(int maxWaitMs);
+    int dispatchTimers();
+
+    // Disable copying
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "GameSnapshot.h"
+#include <cstdint>
+
+// Everything GameStateDetector reads from the game, behind one call. The
+// plugin implements it on the BakkesMod SDK (SdkGameProbe.h); the replay
+// driver implements it on a recorded trace (ProbeTrace.h), so detection
+// runs and can be benchmarked without the game.
+struct GameReading {
+    bool inGame = false;            // GameWrapper::IsInGame
+    MatchPhaseInputs phaseInputs;
+    MatchInfo match;
+};
+
+inline bool operator==(const GameReading& a, const GameReading& b) {
+    const MatchPhaseInputs& x = a.phaseInputs;
+    const MatchPhaseInputs& y = b.phaseInputs;
+    return a.inGame == b.inGame &&
+           x.inMatch == y.inMatch && x.inReplay == y.inReplay && x.paused == y.paused &&
+           x.matchEnded == y.matchEnded && x.roundActive == y.roundActive &&
+           x.ballHasBeenHit == y.ballHasBeenHit && x.overtime == y.overtime &&
+           x.waitTimeRemaining == y.waitTimeRemaining &&
+           a.match.blueScore == b.match.blueScore && a.match.orangeScore == b.match.orangeScore &&
+           a.match.secondsRemaining == b.match.secondsRemaining && a.match.overtime == b.match.overtime;
+}
+
+inline bool operator!=(const GameReading& a, const GameReading& b) {
+    return !(a == b);
+}
+
+// Engine events the detector reacts to; the hook names are in
+// SdkGameProbe.cpp. Values are trace ids, so only append.
+enum class GameEvent : std::uint8_t {
+    countdownBegin,     // kickoff countdown: a match (or a new round) is live
+    matchEnded,         // podium reached
+    matchDestroyed,     // match torn down when leaving it
+    replayBegin,        // value: 1 if the server's ReplayDirector confirmed it
+    replayEnd,
+    pauseToggled,       // pause menu opened or closed
+    preLoadMap,
+    postLoadMap,
+    matchStartedCommand,    // GameState_* console notifiers; pause value: 1 = paused
+    matchEndedCommand,
+    replayStartedCommand,
+    replayEndedCommand,
+    pauseCommand,
+    detectCommand,          // gamestate_detect
+    count
+};
+
+class GameProbe {
+public:
+    virtual ~GameProbe() = default;
+
+    // One pass over the game (game thread)
+    virtual GameReading read() = 0;
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "GameState.h"
+#include "MatchPhase.h"
+#include <cstdint>
+
+// Live numbers of the current match; defaults outside a match
+struct MatchInfo {
+    int blueScore = 0;
+    int orangeScore = 0;
+    int secondsRemaining = -1;
+    bool overtime = false;
+};
+
+// Everything the plugin reads from the game, captured in one pass on the
+// game thread. Published through a Seqlock (Seqlock.h) so other threads
+// (polling, network, telemetry) never call into the SDK themselves.
+struct GameSnapshot {
+    std::uint64_t tick = 0;             // viewport tick of the sample, 0 = never sampled
+    std::int64_t sampledAtMs = 0;       // steady clock
+    bool inGame = false;                // GameWrapper::IsInGame
+    MatchPhaseInputs phaseInputs;
+    MatchInfo match;
+    GameState state = GameState::unknown;   // classifyGameState of this sample
+    MatchPhase phase = MatchPhase::unknown; // tracked phase after this sample
+};
+
+// Coarse state of one sample; free play counts as inGame
+constexpr GameState classifyGameState(const GameSnapshot& snapshot) {
+    return !snapshot.inGame ? GameState::inMenu
+         : snapshot.phaseInputs.inReplay ? GameState::inReplay
+         : snapshot.phaseInputs.paused ? GameState::gamePaused
+         : GameState::inGame;
+}
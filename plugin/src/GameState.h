@@ -0,0 +1,12 @@
+#pragma once
+
+// Game state enumeration. The values double as state ids in the binary
+// wire protocol (WireProtocol.h), so only append new states. Finer detail
+// inside a match is MatchPhase (MatchPhase.h).
+enum class GameState {
+    inMenu,
+    inGame,
+    inReplay,
+    gamePaused,
+    unknown
+};
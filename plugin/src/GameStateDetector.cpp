@@ -1,16 +1,23 @@
 #include "GameStateDetector.h"
-#include "bakkesmod/wrappers/GameWrapper.h"
-#include "bakkesmod/wrappers/GameEvent/ServerWrapper.h"
-#include "bakkesmod/wrappers/GameEvent/ReplayWrapper.h"
-#include "bakkesmod/wrappers/GameObject/CameraWrapper.h"
-#include "bakkesmod/plugin/bakkesmodsdk.h"
-#include "utils/parser.h"
-#include <iostream>
+#include "Logger.h"
+#include "Tracer.h"
+#include <algorithm>
 #include <vector>
 
-GameStateDetector::GameStateDetector(BakkesMod::Plugin::BakkesModPlugin* plugin)
-    : bakkesModPlugin(plugin), currentState(GameState::unknown),
-      isDetecting(false), usePollingMode(false), pollingInterval(200) {
+// Sample period in a match (10 Hz); menus are sampled only as often as the
+// detection mode needs. Periods are measured on the injected clock, not in
+// ticks, so they hold at any frame rate.
+static const std::chrono::milliseconds kMatchSampleInterval(100);
+
+// Sample interval meaning "only on demand"; 0 means every tick
+static const std::chrono::milliseconds kSampleOnDemand(-1);
+
+GameStateDetector::GameStateDetector(GameProbe* probe, const Clock& clock)
+    : probe(probe), clock(clock), currentState(GameState::unknown),
+      isDetecting(false), detectionMode(DetectionMode::eventHooks), pollingInterval(200),
+      reconcileInterval(1000), nextReconcileAt(0), matchOver(false),
+      currentPhase(MatchPhase::unknown), tickCount(0), matchSampleInterval(kMatchSampleInterval),
+      menuSampleInterval(kSampleOnDemand), lastSampleAt(0), reconcileProbes(0), missedTransitions(0) {
 }
 
 GameStateDetector::~GameStateDetector() {
@@ -18,14 +25,31 @@ GameStateDetector::~GameStateDetector() {
 }
 
 // Start game state detection
-void GameStateDetector::startDetection(bool usePolling, int pollingIntervalMs) {
+void GameStateDetector::startDetection(DetectionMode mode, int intervalMs) {
     if (isDetecting) return;
 
-    usePollingMode = usePolling;
-    pollingInterval = pollingIntervalMs;
+    detectionMode = mode;
+    pollingInterval = intervalMs;
+    reconcileInterval = std::chrono::milliseconds(std::max(1, intervalMs));
+    nextReconcileAt = clock.now() + reconcileInterval;
+    lastSampleAt = clock.now();
+
+    // eventHooks: menus rely on the hooks and the reconciliation probe.
+    // polling: the thread can only see what the sampler published.
+    if (mode == DetectionMode::tickProbe) {
+        matchSampleInterval = std::chrono::milliseconds(0);
+        menuSampleInterval = std::chrono::milliseconds(0);
+    } else if (mode == DetectionMode::polling) {
+        menuSampleInterval = reconcileInterval;
+        matchSampleInterval = std::min(kMatchSampleInterval, menuSampleInterval);
+    } else {
+        matchSampleInterval = kMatchSampleInterval;
+        menuSampleInterval = kSampleOnDemand;
+    }
+
     isDetecting = true;
 
-    if (usePollingMode) {
+    if (detectionMode == DetectionMode::polling) {
         // Start polling thread
         pollingThread = std::make_unique<std::thread>(
             &GameStateDetector::pollingLoop, this
@@ -51,78 +75,34 @@ GameState GameStateDetector::getCurrentState() const {
     return currentState.load();
 }
 
-// Setup Bakkesmod hooks for match events
-void GameStateDetector::setupMatchHooks() {
-    if (!bakkesModPlugin) return;
-
-    std::cout << "GameStateDetector: Setting up match hooks..." << std::endl;
-
-    // Hook into match start event
-    bakkesModPlugin->cvarManager->registerNotifier("GameState_MatchStarted",
-        [this](std::vector<std::string> params) {
-            std::cout << "GameStateDetector: Match started event triggered!" << std::endl;
-            onMatchStarted();
-        }, "", PERMISSION_ALL);
-
-    // Hook into match end event
-    bakkesModPlugin->cvarManager->registerNotifier("GameState_MatchEnded",
-        [this](std::vector<std::string> params) {
-            std::cout << "GameStateDetector: Match ended event triggered!" << std::endl;
-            onMatchEnded();
-        }, "", PERMISSION_ALL);
-
-    // Hook into game tick for continuous monitoring
-    bakkesModPlugin->gameWrapper->HookEvent("Function Engine.GameViewportClient.Tick",
-        [this](std::string eventName) {
-            if (!usePollingMode && isDetecting) {
-                GameState newState = detectGameState();
-                if (newState != currentState.load()) {
-                    updateState(newState);
-                }
-            }
-        });
-
-    // Add a manual command to test state detection
-    bakkesModPlugin->cvarManager->registerNotifier("gamestate_detect",
-        [this](std::vector<std::string> params) {
-            std::cout << "GameStateDetector: Manual state detection triggered!" << std::endl;
-            GameState newState = detectGameState();
-            std::cout << "GameStateDetector: Detected state: " << (int)newState << std::endl;
-            updateState(newState);
-        }, "Manually trigger game state detection", PERMISSION_ALL);
-
-    std::cout << "GameStateDetector: Match hooks setup completed" << std::endl;
+// Get current match phase
+MatchPhase GameStateDetector::getCurrentPhase() const {
+    return currentPhase.load();
 }
 
-// Setup Bakkesmod hooks for replay events
-void GameStateDetector::setupReplayHooks() {
-    if (!bakkesModPlugin) return;
-
-    // Hook into replay start
-    bakkesModPlugin->cvarManager->registerNotifier("GameState_ReplayStarted",
-        [this](std::vector<std::string> params) {
-            onReplayStarted();
-        }, "", PERMISSION_ALL);
-
-    // Hook into replay end
-    bakkesModPlugin->cvarManager->registerNotifier("GameState_ReplayEnded",
-        [this](std::vector<std::string> params) {
-            onReplayEnded();
-        }, "", PERMISSION_ALL);
+// Latest sample published by the game thread
+GameSnapshot GameStateDetector::getSnapshot() const {
+    return latestSnapshot.load();
 }
 
-// Setup Bakkesmod hooks for pause events
-void GameStateDetector::setupPauseHooks() {
-    if (!bakkesModPlugin) return;
-
-    // Hook into pause toggle
-    bakkesModPlugin->cvarManager->registerNotifier("GameState_PauseChanged",
-        [this](std::vector<std::string> params) {
-            if (!params.empty()) {
-                bool isPaused = (params[0] == "1");
-                onPauseChanged(isPaused);
-            }
-        }, "", PERMISSION_ALL);
+// Tick hook cost and probe counters, one console line each
+std::vector<std::string> GameStateDetector::describeHookCost() const {
+    const char* mode = detectionMode == DetectionMode::eventHooks ? "hooks"
+                     : detectionMode == DetectionMode::tickProbe ? "tick" : "polling";
+
+    return {
+        std::string("Detection mode: ") + mode + ", ticks " + std::to_string(tickHookCost.getCount()),
+        "Tick hook cost: p50 " + std::to_string(tickHookCost.percentile(0.50)) +
+            " ns, p99 " + std::to_string(tickHookCost.percentile(0.99)) +
+            " ns, max " + std::to_string(tickHookCost.getMax()) + " ns",
+        "Reconciliation probes " + std::to_string(reconcileProbes.load()) +
+            ", transitions missed by hooks " + std::to_string(missedTransitions.load()),
+        std::string("Match phase ") + kMatchPhaseNames[(size_t)currentPhase.load()] +
+            ", resyncs past the transition table " + std::to_string(phaseTracker.getResyncCount()),
+        "Snapshots published " + std::to_string(latestSnapshot.getVersion()) +
+            ", every " + (matchSampleInterval.count() > 0 ? std::to_string(matchSampleInterval.count()) + " ms"
+                                                             : std::string("tick")) + " in a match"
+    };
 }
 
 // Set callback for state changes
@@ -130,132 +110,237 @@ void GameStateDetector::setStateChangedCallback(StateChangedCallback callback) {
     onStateChanged = callback;
 }
 
-// Detect current game state using Bakkesmod API
-GameState GameStateDetector::detectGameState() {
-    if (!bakkesModPlugin) {
-        std::cout << "GameStateDetector: No plugin reference!" << std::endl;
-        return GameState::inMenu;
-    }
+// Set callback for match phase changes
+void GameStateDetector::setPhaseChangedCallback(PhaseChangedCallback callback) {
+    onPhaseChanged = callback;
+}
+
+// Read everything the plugin needs from the game in one pass (game thread)
+GameSnapshot GameStateDetector::readGame() {
+    GameSnapshot snapshot;
+    snapshot.tick = tickCount;
+    snapshot.sampledAtMs = clock.now().count();
 
-    auto gameWrapper = bakkesModPlugin->gameWrapper;
-    if (!gameWrapper) {
-        std::cout << "GameStateDetector: No game wrapper!" << std::endl;
-        return GameState::inMenu;
+    if (!probe) {
+        GS_LOG_ERROR("GameStateDetector: No game probe!");
+        return snapshot;
     }
 
-    bool isInGame = gameWrapper->IsInGame();
-    bool isInReplay = gameWrapper->IsInReplay();
-    
-    std::cout << "GameStateDetector: IsInGame=" << isInGame << ", IsInReplay=" << isInReplay << std::endl;
+    GameReading reading = probe->read();
+    snapshot.inGame = reading.inGame;
+    snapshot.phaseInputs = reading.phaseInputs;
+    snapshot.match = reading.match;
+    return snapshot;
+}
 
-    if (!isInGame) {
-        std::cout << "GameStateDetector: Not in game, returning inMenu" << std::endl;
-        return GameState::inMenu;
-    }
+// Read the game, advance the phase tracker and publish the snapshot.
+// `implied` is the phase an engine event announces; it wins over the
+// reading, which can trail the event by a tick or two.
+GameSnapshot GameStateDetector::sampleGame(MatchPhase implied) {
+    GameSnapshot snapshot = readGame();
+    lastSampleAt = std::chrono::milliseconds(snapshot.sampledAtMs);
 
-    // Check if we're in a replay (including goal replays)
-    if (isInReplay) {
-        std::cout << "GameStateDetector: In replay, returning inReplay" << std::endl;
-        return GameState::inReplay;
+    bool phaseChanged;
+    if (implied == MatchPhase::unknown) {
+        phaseChanged = phaseTracker.observe(classifyMatchPhase(snapshot.phaseInputs));
+    } else {
+        phaseChanged = phaseTracker.getPhase() != implied;
+        phaseTracker.reset(implied);
     }
+    snapshot.phase = phaseTracker.getPhase();
 
-    // Check if game is paused
-    if (isGamePaused()) {
-        std::cout << "GameStateDetector: Game paused, returning gamePaused" << std::endl;
-        return GameState::gamePaused;
-    }
+    // The tracked phase decides the state (podium = inMenu), so the two
+    // never disagree; fall back to the raw probe while it is unknown
+    snapshot.state = snapshot.phase != MatchPhase::unknown ? toLegacyState(snapshot.phase)
+                                                           : classifyGameState(snapshot);
 
-    // Check if we're in an active match or free play
-    ServerWrapper server = gameWrapper->GetGameEventAsServer();
-    if (!server.IsNull()) {
-        std::cout << "GameStateDetector: In active match, returning inGame" << std::endl;
-        return GameState::inGame;
-    }
+    // Publish before notifying so callbacks already see this sample
+    latestSnapshot.store(snapshot);
 
-    // If we're in game but no server wrapper, we're likely in free play
-    if (isInGame) {
-        std::cout << "GameStateDetector: In free play, returning inGame" << std::endl;
-        return GameState::inGame;
+    if (phaseChanged) {
+        applyPhase(snapshot.phase);
     }
 
-    std::cout << "GameStateDetector: Default case, returning inMenu" << std::endl;
-    return GameState::inMenu;
+    return snapshot;
 }
 
-// Check if currently in main menu
-bool GameStateDetector::isInMainMenu() {
-    if (!bakkesModPlugin) return true;
+// Viewport tick (game thread, every frame): runs the sampler (every tick in
+// tickProbe mode, 10 Hz in a match otherwise) and the reconciliation probe
+// when their clock deadlines pass
+void GameStateDetector::onTick() {
+    if (!isDetecting) return;
 
-    auto gameWrapper = bakkesModPlugin->gameWrapper;
+    auto start = std::chrono::steady_clock::now();
+    ++tickCount;
+    std::chrono::milliseconds now = clock.now();
 
-    // If not in game, we're likely in menu
-    return !gameWrapper->IsInGame() && !gameWrapper->IsInReplay();
-}
+    // Phases only exist in a match; menus cost a clock read unless the mode
+    // samples them
+    bool inMatch = currentState.load() != GameState::inMenu || phaseTracker.getPhase() != MatchPhase::menu;
+    std::chrono::milliseconds sampleInterval = inMatch ? matchSampleInterval : menuSampleInterval;
 
-// Check if actively in a game
-bool GameStateDetector::isInGame() {
-    if (!bakkesModPlugin) return false;
-
-    auto gameWrapper = bakkesModPlugin->gameWrapper;
+    if (sampleInterval >= std::chrono::milliseconds(0) && now - lastSampleAt >= sampleInterval) {
+        GameSnapshot snapshot = sampleGame();
+        if (detectionMode == DetectionMode::tickProbe) {
+            applyState(snapshot.state);
+        }
+    }
 
-    if (!gameWrapper->IsInGame()) return false;
+    if (detectionMode == DetectionMode::eventHooks && now >= nextReconcileAt) {
+        reconcile();
+    }
 
-    ServerWrapper server = gameWrapper->GetGameEventAsServer();
-    return !server.IsNull() && !gameWrapper->IsInReplay();
+    tickHookCost.record((std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
 }
 
-// Check if in replay mode
-bool GameStateDetector::isInReplay() {
-    if (!bakkesModPlugin) return false;
+// Notify a phase change accepted by the tracker
+void GameStateDetector::applyPhase(MatchPhase phase) {
+    currentPhase = phase;
+    GS_LOG_DEBUG("GameStateDetector: phase %s", kMatchPhaseNames[(size_t)phase]);
 
-    return bakkesModPlugin->gameWrapper->IsInReplay();
+    if (onPhaseChanged) {
+        onPhaseChanged(phase);
+    }
+
+    // Keep the legacy state consistent with the phase
+    if (phase != MatchPhase::unknown) {
+        applyState(toLegacyState(phase));
+    }
 }
 
-// Check if game is paused
-bool GameStateDetector::isGamePaused() {
-    if (!bakkesModPlugin) return false;
+// Full probe that catches transitions the event hooks did not report
+void GameStateDetector::reconcile() {
+    nextReconcileAt = clock.now() + reconcileInterval;
+    reconcileProbes.fetch_add(1, std::memory_order_relaxed);
 
-    auto gameWrapper = bakkesModPlugin->gameWrapper;
+    // The podium probes as inGame before the phase catches up; keep the
+    // ended match in the menu
+    GameState newState = sampleGame().state;
+    if (matchOver && newState == GameState::inGame) {
+        newState = GameState::inMenu;
+    }
+
+    if (newState != currentState.load()) {
+        missedTransitions.fetch_add(1, std::memory_order_relaxed);
+        applyState(newState);
+    }
+}
 
-    // Check if the game is paused by examining game speed
-    if (gameWrapper->IsInGame()) {
-        ServerWrapper server = gameWrapper->GetGameEventAsServer();
-        if (!server.IsNull()) {
-            // Game speed of 0 typically indicates paused state
-            return server.GetGameSpeed() == 0.0f;
+// Engine events and console commands (game thread). Engine events only
+// drive eventHooks mode; the other modes find the same changes by probing.
+void GameStateDetector::onGameEvent(GameEvent event, int value) {
+    switch (event) {
+        case GameEvent::countdownBegin:
+            if (isEventDriven()) onMatchStarted();
+            break;
+        case GameEvent::matchEnded:
+        case GameEvent::matchDestroyed:
+            if (isEventDriven()) onMatchEnded();
+            break;
+        case GameEvent::replayBegin:
+            // Unconfirmed replays (no ReplayDirector) are checked by probing
+            if (!isEventDriven()) break;
+            if (value) {
+                onReplayStarted();
+            } else {
+                reconcile();
+            }
+            break;
+        case GameEvent::replayEnd:
+            if (isEventDriven()) onReplayEnded();
+            break;
+        case GameEvent::pauseToggled:
+            // The game speed tells whether the pause menu opened or closed
+            if (isEventDriven()) applyState(sampleGame().state);
+            break;
+        case GameEvent::preLoadMap:
+            // Nothing reliable to probe while loading; settle once the map is up
+            if (isEventDriven()) nextReconcileAt = clock.now() + reconcileInterval;
+            break;
+        case GameEvent::postLoadMap:
+            if (isEventDriven()) onMapLoaded();
+            break;
+        case GameEvent::matchStartedCommand:
+            onMatchStarted();
+            break;
+        case GameEvent::matchEndedCommand:
+            onMatchEnded();
+            break;
+        case GameEvent::replayStartedCommand:
+            onReplayStarted();
+            break;
+        case GameEvent::replayEndedCommand:
+            onReplayEnded();
+            break;
+        case GameEvent::pauseCommand:
+            onPauseChanged(value != 0);
+            break;
+        case GameEvent::detectCommand: {
+            GameState newState = sampleGame().state;
+            GS_LOG_INFO("GameStateDetector: Detected state: %d", (int)newState);
+            applyState(newState);
+            break;
         }
+        case GameEvent::count:
+            break;
     }
+}
+
+bool GameStateDetector::isEventDriven() const {
+    return isDetecting && detectionMode == DetectionMode::eventHooks;
+}
 
-    return false;
+// Event handlers. Each samples first, with the phase the event implies, so
+// the phase goes out before the state and the two never disagree.
+void GameStateDetector::onMapLoaded() {
+    nextReconcileAt = clock.now() + reconcileInterval;
+    matchOver = false;
+    applyState(sampleGame().state);
 }
 
-// Hook handlers
 void GameStateDetector::onMatchStarted() {
-    updateState(GameState::inGame);
+    matchOver = false;
+    sampleGame(MatchPhase::countdown);
+    applyState(GameState::inGame);
 }
 
 void GameStateDetector::onMatchEnded() {
-    updateState(GameState::inMenu);
+    // Destroyed after the podium: the menu sample already moved on
+    bool inMatch = phaseTracker.getPhase() != MatchPhase::menu && phaseTracker.getPhase() != MatchPhase::unknown;
+    matchOver = true;
+    sampleGame(inMatch ? MatchPhase::postGame : MatchPhase::unknown);
+    applyState(GameState::inMenu);
 }
 
 void GameStateDetector::onReplayStarted() {
-    updateState(GameState::inReplay);
+    sampleGame(MatchPhase::replay);
+    applyState(GameState::inReplay);
 }
 
 void GameStateDetector::onReplayEnded() {
     // After replay ends, go back to menu or game depending on context
-    GameState newState = detectGameState();
-    updateState(newState);
+    applyState(sampleGame().state);
 }
 
 void GameStateDetector::onPauseChanged(bool isPaused) {
+    GameSnapshot snapshot = sampleGame(isPaused ? MatchPhase::paused : MatchPhase::unknown);
     if (isPaused) {
-        updateState(GameState::gamePaused);
+        applyState(GameState::gamePaused);
     } else {
         // When unpaused, determine if we're in game or replay
-        GameState newState = detectGameState();
-        updateState(newState);
+        applyState(snapshot.state);
+    }
+}
+
+// State change decided on the game thread. While the polling thread runs
+// it alone publishes the state (from the snapshot just sampled), so two
+// threads never race on currentState.
+void GameStateDetector::applyState(GameState newState) {
+    if (pollingThread) {
+        return;
     }
+    updateState(newState);
 }
 
 // Update current state and notify callback
@@ -269,11 +354,15 @@ void GameStateDetector::updateState(GameState newState) {
     }
 }
 
-// Polling loop for fallback detection method
+// Polling loop for fallback detection method. Never calls the SDK: it
+// follows the snapshots the tick sampler publishes.
 void GameStateDetector::pollingLoop() {
+    Tracer::setThreadName("polling");
     while (isDetecting) {
-        GameState newState = detectGameState();
-        updateState(newState);
+        GameSnapshot snapshot = latestSnapshot.load();
+        if (snapshot.tick != 0) {
+            updateState(snapshot.state);
+        }
 
         std::this_thread::sleep_for(std::chrono::milliseconds(pollingInterval));
     }
@@ -1,60 +1,111 @@
 #pragma once
 
-#include "GameStatePlugin.h"
+#include "GameProbe.h"
+#include "GameSnapshot.h"
+#include "Clock.h"
+#include "LatencyHistogram.h"
+#include "Seqlock.h"
 #include <memory>
 #include <thread>
 #include <atomic>
 #include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
 
-// Use the BakkesMod namespace
-using namespace BakkesMod::Plugin;
+// How the detector notices state changes
+enum class DetectionMode {
+    eventHooks,     // engine events, plus a low-frequency reconciliation probe
+    tickProbe,      // full SDK probe on every viewport tick (legacy)
+    polling         // background thread watching the game-thread snapshots
+};
 
-// Game state detection and polling system
+// Game state detection and polling system. Reads the game only through a
+// GameProbe and is driven by onTick/onGameEvent, which the plugin calls
+// from its hooks (SdkGameProbe) and the replay driver from a trace. Probe
+// reads and events happen on the game thread; other threads only see the
+// published GameSnapshot.
 class GameStateDetector {
 public:
-    // Callback function type
+    // Callback function types
     using StateChangedCallback = std::function<void(GameState)>;
+    using PhaseChangedCallback = std::function<void(MatchPhase)>;
 
-    GameStateDetector(BakkesMod::Plugin::BakkesModPlugin* plugin);
+    GameStateDetector(GameProbe* probe, const Clock& clock);
     ~GameStateDetector();
 
-    // Detection methods
-    void startDetection(bool usePolling = true, int pollingIntervalMs = 200);
+    // Detection methods. intervalMs is the polling interval in polling mode
+    // and the reconciliation probe interval in eventHooks mode.
+    void startDetection(DetectionMode mode = DetectionMode::eventHooks, int intervalMs = 1000);
     void stopDetection();
     GameState getCurrentState() const;
+    MatchPhase getCurrentPhase() const;
+    DetectionMode getDetectionMode() const { return detectionMode; }
+
+    // Latest game-thread sample; lock-free, safe from any thread
+    GameSnapshot getSnapshot() const;
+
+    // Swap the probe, e.g. for a trace recorder wrapping it (game thread)
+    void setProbe(GameProbe* newProbe) { probe = newProbe; }
+
+    // Game thread: every viewport tick, and every engine event
+    void onTick();
+    void onGameEvent(GameEvent event, int value = 0);
 
-    // Hook setup methods
-    void setupMatchHooks();
-    void setupReplayHooks();
-    void setupPauseHooks();
+    // Per-frame cost of the viewport tick hook, and probe counters
+    std::vector<std::string> describeHookCost() const;
 
-    // Callback setter
+    // Callback setters
     void setStateChangedCallback(StateChangedCallback callback);
+    void setPhaseChangedCallback(PhaseChangedCallback callback);
 
 private:
-    // Plugin reference for accessing game data
-    BakkesMod::Plugin::BakkesModPlugin* bakkesModPlugin;
+    GameProbe* probe;
+    const Clock& clock;
 
     // Detection state
     std::atomic<GameState> currentState;
     std::atomic<bool> isDetecting;
-    bool usePollingMode;
+    DetectionMode detectionMode;
     int pollingInterval;
 
-    // Polling thread
+    // Reconciliation probe (eventHooks mode, game thread); deadlines are on
+    // the injected clock
+    std::chrono::milliseconds reconcileInterval;
+    std::chrono::milliseconds nextReconcileAt;
+    bool matchOver;             // ended match still loaded (podium)
+
+    // Game-thread sampler; time between samples in and out of a match
+    // (0 = every tick, negative = only on demand)
+    MatchPhaseTracker phaseTracker;
+    std::atomic<MatchPhase> currentPhase;
+    std::uint64_t tickCount;
+    std::chrono::milliseconds matchSampleInterval;
+    std::chrono::milliseconds menuSampleInterval;
+    std::chrono::milliseconds lastSampleAt;
+    Seqlock<GameSnapshot> latestSnapshot;
+
+    // Hook cost accounting; tick cost in nanoseconds
+    LatencyHistogram tickHookCost;
+    std::atomic<std::uint64_t> reconcileProbes;
+    std::atomic<std::uint64_t> missedTransitions;
+
+    // Polling thread (reads latestSnapshot only)
     std::unique_ptr<std::thread> pollingThread;
 
     // Callbacks
     StateChangedCallback onStateChanged;
+    PhaseChangedCallback onPhaseChanged;
 
-    // Detection methods
-    GameState detectGameState();
-    bool isInMainMenu();
-    bool isInGame();
-    bool isInReplay();
-    bool isGamePaused();
+    // Sampling (game thread)
+    GameSnapshot readGame();
+    GameSnapshot sampleGame(MatchPhase implied = MatchPhase::unknown);
+    void applyPhase(MatchPhase phase);
 
-    // Hook handlers
+    // Event handlers
+    void reconcile();
+    void onMapLoaded();
+    bool isEventDriven() const;
     void onMatchStarted();
     void onMatchEnded();
     void onReplayStarted();
@@ -63,6 +114,7 @@ private:
 
     // Polling loop
     void pollingLoop();
+    void applyState(GameState newState);
     void updateState(GameState newState);
 
     // Disable copying
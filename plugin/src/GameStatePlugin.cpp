@@ -1,9 +1,27 @@
 #include "GameStatePlugin.h"
 #include "WebSocketClient.h"
+#include "ShmRingWriter.h"
+#include "StateBoardWriter.h"
+#include "TimerWheel.h"
+#include "TickDispatcher.h"
+#include "SignalDebouncer.h"
+#include "WireProtocol.h"
 #include "GameStateDetector.h"
-#include <iostream>
+#include "SdkGameProbe.h"
+#include "PhysicsSampler.h"
+#include "SessionRecorder.h"
+#include "HookProfiler.h"
+#include "PerfOverlay.h"
+#include "JsonWriter.h"
+#include "Tracer.h"
+#include "Logger.h"
 #include <fstream>
 #include <sstream>
+#include <ctime>
+#include <filesystem>
+
+// Debouncer signal carrying the game state
+static const SignalDebouncer::SignalId kGameStateSignal = 0;
 
 // Plugin entry point macro for Bakkesmod
 BAKKESMOD_PLUGIN(GameStatePlugin, "Game State Plugin", "1.0.0", PLUGINTYPE_FREEPLAY)
@@ -14,14 +32,171 @@ BAKKESMOD_PLUGIN(GameStatePlugin, "Game State Plugin", "1.0.0", PLUGINTYPE_FREEP
 void GameStatePlugin::onLoad() {
     // Initialize current state
     currentState = GameState::unknown;
+    currentPhase = MatchPhase::unknown;
     lastStateChangeTime = std::chrono::steady_clock::now();
 
     // Load configuration from file
     loadConfig();
 
-    // Create WebSocket client for communication with desktop app
+    // Diagnostics go to log_file_path from a background thread
+    if (!logFilePath.empty() && !Logger::start(logFilePath, enableDebugLogging)) {
+        cvarManager->log("Failed to open log file " + logFilePath);
+    }
+    GS_LOG_INFO("GameStatePlugin: loading, transport %s, detection %s", transport.c_str(), detectionMode.c_str());
+
+    // Every hook, command, tick subscriber and drawable registered below is
+    // timed into the profiler, so it has to exist first
+    hookProfiler = std::make_unique<HookProfiler>();
+    hookProfiler->setEnabled(perfProfilingEnabled);
+    executeSite = hookProfiler->addSite(HookSiteKind::callback, "Execute");
+
+    // Timeline of hooks, state changes and socket I/O for gamestate_timeline
+    setupTimeline();
+
+    // Flapping states (goal replays, pauses, loading screens) are throttled
+    // before they reach the desktop app
+    setupStateThrottle();
+
+    // Single owner of the viewport tick
+    setupTickDispatcher();
+
+    // Transport to the desktop app: WebSocket (default) or shared memory
+    if (transport == "shm") {
+        setupSharedMemoryTransport();
+    } else {
+        setupWebSocket();
+    }
+
+    // Latest-state page for overlays, independent of the transport
+    if (stateBoardEnabled) {
+        setupStateBoard();
+    }
+
+    // Ball and car physics for macros and overlays
+    if (telemetryEnabled) {
+        setupTelemetry();
+    }
+
+    // Columnar session file of telemetry and state events for later analysis
+    if (sessionRecordingEnabled) {
+        setupSessionRecording();
+    }
+
+    // Create game state detector; it reads the game only through the probe
+    gameProbe = std::make_unique<SdkGameProbe>(this, *clock, *hookProfiler);
+    gameStateDetector = std::make_unique<GameStateDetector>(gameProbe.get(), *clock);
+
+    // Set game state change callback; the polling thread hands its changes
+    // to the game thread, which owns the throttle
+    bool pollingDetection = usePolling || detectionMode == "polling";
+    gameStateDetector->setStateChangedCallback([this, pollingDetection](GameState newState) {
+        if (pollingDetection && gameWrapper) {
+            gameWrapper->Execute(hookProfiler->wrap(executeSite, [this, newState](GameWrapper*) {
+                onGameStateChanged(newState);
+            }));
+        } else {
+            onGameStateChanged(newState);
+        }
+    });
+
+    // Match phases are sampled on the game thread
+    gameStateDetector->setPhaseChangedCallback([this](MatchPhase phase) {
+        onMatchPhaseChanged(phase);
+    });
+
+    // Setup Bakkesmod event hooks for real-time detection
+    setupEventHooks();
+
+    // Detector hooks: engine events plus a reconciliation probe by default
+    gameProbe->installHooks(*gameStateDetector, *tickDispatcher);
+    setupProbeTrace();
+
+    // gamestate_perf, the canvas overlay and the periodic stats message
+    setupPerf();
+
+    if (usePolling || detectionMode == "polling") {
+        gameStateDetector->startDetection(DetectionMode::polling, pollingIntervalMs);
+        cvarManager->log("Using background polling for state detection");
+    } else if (detectionMode == "tick") {
+        gameStateDetector->startDetection(DetectionMode::tickProbe);
+        cvarManager->log("Using per-tick probing for state detection");
+    } else {
+        gameStateDetector->startDetection(DetectionMode::eventHooks, reconcileIntervalMs);
+        cvarManager->log("Using BakkesMod event hooks for real-time state detection");
+    }
+
+    // Connect to the desktop app in the background; onWebSocketConnected
+    // sends the current state once the handshake completes
+    if (webSocketClient) {
+        if (!webSocketClient->connect()) {
+            cvarManager->log("Failed to start desktop app WebSocket connection");
+        } else {
+            cvarManager->log("Connecting to desktop app at " + websocketUrl + "...");
+        }
+    }
+
+    cvarManager->log("GameStatePlugin loaded successfully");
+}
+
+// Debounce/throttle filter between detection and the transports
+void GameStatePlugin::setupStateThrottle() {
+    clock = std::make_unique<SteadyClock>();
+    timerWheel = std::make_unique<TimerWheel>(clock->now());
+    stateDebouncer = std::make_unique<SignalDebouncer>(*timerWheel,
+        [this](SignalDebouncer::SignalId, std::int64_t value) {
+            applyStateChange((GameState)value);
+        });
+
+    DebouncePolicy policy;
+    policy.minDwell = std::chrono::milliseconds(stateChangeThrottleMs);
+    policy.edge = stateChangeEdge == "trailing" ? DebounceEdge::trailing : DebounceEdge::leading;
+    stateDebouncer->setDefaultPolicy(policy);
+}
+
+// The one viewport tick hook; everything that runs per frame subscribes to
+// the dispatcher instead of hooking the tick itself
+void GameStatePlugin::setupTickDispatcher() {
+    tickDispatcher = std::make_unique<TickDispatcher>(*clock, std::chrono::microseconds(tickBudgetUs));
+    tickDispatcher->setProfiler(hookProfiler.get());
+
+    if (gameWrapper) {
+        const std::string tickEvent = "Function Engine.GameViewportClient.Tick";
+        gameWrapper->HookEvent(tickEvent, hookProfiler->wrapHook(tickEvent, [this](std::string eventName) {
+            if (tickDispatcher) {
+                tickDispatcher->onTick();
+            }
+        }));
+    }
+
+    cvarManager->registerNotifier("gamestate_ticks", hookProfiler->wrapCommand("gamestate_ticks", [this](std::vector<std::string> params) {
+        for (const std::string& line : tickDispatcher->describe()) {
+            cvarManager->log(line);
+        }
+    }), "Show per-frame cost, budget overruns and deferrals of the tick subscribers", PERMISSION_ALL);
+}
+
+// Create and configure the WebSocket client (connected at the end of onLoad)
+void GameStatePlugin::setupWebSocket() {
     webSocketClient = std::make_unique<WebSocketClient>(websocketUrl);
 
+    ReconnectPolicy reconnectPolicy;
+    reconnectPolicy.enabled = autoReconnectEnabled;
+    reconnectPolicy.baseDelayMs = reconnectIntervalMs;
+    reconnectPolicy.maxDelayMs = maxReconnectDelayMs;
+    reconnectPolicy.maxAttempts = maxReconnectAttempts;
+    webSocketClient->setReconnectPolicy(reconnectPolicy);
+
+    ConnectTimeouts connectTimeouts;
+    connectTimeouts.connectTimeoutMs = connectTimeoutMs;
+    connectTimeouts.handshakeTimeoutMs = handshakeTimeoutMs;
+    webSocketClient->setConnectTimeouts(connectTimeouts);
+    webSocketClient->setOfferBinaryProtocol(binaryProtocolEnabled);
+
+    HeartbeatPolicy heartbeatPolicy;
+    heartbeatPolicy.intervalMs = pingIntervalMs;
+    heartbeatPolicy.maxMissedPongs = maxMissedPongs;
+    webSocketClient->setHeartbeatPolicy(heartbeatPolicy);
+
     // Set WebSocket event callbacks
     webSocketClient->setConnectedCallback([this]() {
         onWebSocketConnected();
@@ -35,33 +210,205 @@ void GameStatePlugin::onLoad() {
         onWebSocketError(error);
     });
 
-    // Create game state detector
-    gameStateDetector = std::make_unique<GameStateDetector>(this);
-
-    // Set game state change callback
-    gameStateDetector->setStateChangedCallback([this](GameState newState) {
-        onGameStateChanged(newState);
+    // Inbound messages arrive on the network thread; handle them on the game thread
+    webSocketClient->setMessageCallback([this](std::string_view payload, bool isBinary) {
+        if (isBinary || !gameWrapper) return;
+        std::string message(payload);
+        gameWrapper->Execute(hookProfiler->wrap(executeSite, [this, message](GameWrapper*) {
+            onWebSocketMessage(message);
+        }));
     });
+}
 
-    // Setup Bakkesmod event hooks for real-time detection
-    setupEventHooks();
+// Create the shared-memory ring the desktop app reads with ShmRingReader
+void GameStatePlugin::setupSharedMemoryTransport() {
+    shmWriter = std::make_unique<ShmRingWriter>();
+    shmSequence = 0;
 
-    // Note: We're using event hooks instead of polling for better performance
-    cvarManager->log("Using BakkesMod event hooks for real-time state detection");
+    if (!shmWriter->create(shmRegionName, (size_t)shmRingSizeKb * 1024)) {
+        cvarManager->log("Failed to create shared memory region " + shmRegionName);
+        shmWriter.reset();
+        return;
+    }
 
-    // Attempt to connect to desktop app
-    if (!webSocketClient->connect()) {
-        cvarManager->log("Failed to connect to desktop app WebSocket");
-    } else {
-        // Send a test message immediately after connection
-        cvarManager->log("Sending test message to desktop app...");
-        webSocketClient->sendJsonMessage("inMenu", getCurrentTimestamp());
-        
-        // Also send a test JSON message
-        webSocketClient->sendJsonMessage("inMenu", getCurrentTimestamp());
+    cvarManager->log("Publishing state updates to shared memory region " + shmRegionName +
+                     " (" + std::to_string(shmWriter->getCapacity() / 1024) + " KB ring)");
+}
+
+// Create the state board page readers map with StateBoardReader
+void GameStatePlugin::setupStateBoard() {
+    stateBoard = std::make_unique<StateBoardWriter>();
+    stateSinceMs = getCurrentTimeMs();
+    lastBoardEvent = StateBoardEvent::none;
+    lastBoardEventAtMs = 0;
+
+    if (!stateBoard->create(stateBoardName)) {
+        cvarManager->log("Failed to create state board " + stateBoardName);
+        stateBoard.reset();
+        return;
     }
 
-    cvarManager->log("GameStatePlugin loaded successfully");
+    cvarManager->log("Publishing latest state to shared memory board " + stateBoardName);
+}
+
+// Physics sampler on the vehicle input hook, plus its stats command
+void GameStatePlugin::setupTelemetry() {
+    physicsSampler = std::make_unique<PhysicsSampler>(this, *hookProfiler, (size_t)telemetryCapacityFrames);
+    physicsSampler->setRateHz(telemetryRateHz);
+    physicsSampler->setEntities(parseTelemetryEntities(telemetryEntities));
+    physicsSampler->start();
+
+    cvarManager->registerNotifier("gamestate_telemetry",
+        hookProfiler->wrapCommand("gamestate_telemetry", [this](std::vector<std::string> params) {
+            if (physicsSampler) physicsSampler->logStats();
+        }), "Show physics telemetry frame counts and sample cost", PERMISSION_ALL);
+
+    cvarManager->log("Sampling physics telemetry (" + telemetryEntities + ") into a " +
+                     std::to_string(physicsSampler->getRing().getCapacity()) + "-frame ring");
+}
+
+// Open a new session file under session_recording_dir, named by start time
+void GameStatePlugin::setupSessionRecording() {
+    std::error_code error;
+    std::filesystem::create_directories(sessionRecordingDir, error);
+
+    std::string name = formatLocalTime("session-%Y%m%d-%H%M%S.gsr");
+    std::string path = (std::filesystem::path(sessionRecordingDir) / name).string();
+
+    sessionRecorder = std::make_unique<SessionRecorder>();
+    if (!sessionRecorder->open(path, getCurrentTimeMs())) {
+        cvarManager->log("Failed to create session recording " + path);
+        sessionRecorder.reset();
+        return;
+    }
+
+    cvarManager->registerNotifier("gamestate_recording",
+        hookProfiler->wrapCommand("gamestate_recording", [this](std::vector<std::string> params) {
+            if (!sessionRecorder) return;
+            cvarManager->log("Session recording: " + std::to_string(sessionRecorder->getFramesRecorded()) +
+                             " frames, " + std::to_string(sessionRecorder->getChunksWritten()) + " chunks, " +
+                             std::to_string(sessionRecorder->getBytesWritten() / 1024) + " KB written, " +
+                             std::to_string(sessionRecorder->getChunksDropped()) + " chunks dropped");
+        }), "Show session recording size and dropped chunks", PERMISSION_ALL);
+
+    cvarManager->log("Recording session to " + path +
+                     (physicsSampler ? "" : " (state events only, telemetry is disabled)"));
+}
+
+// gamestate_trace start|stop [file]: record what the detector reads and
+// which events fire, for tools/detector_replay
+void GameStatePlugin::setupProbeTrace() {
+    cvarManager->registerNotifier("gamestate_trace",
+        hookProfiler->wrapCommand("gamestate_trace", [this](std::vector<std::string> params) {
+            if (!gameProbe) return;
+            std::string command = params.size() > 1 ? params[1] : "";
+
+            if (command == "start") {
+                gameProbe->startTrace(getCurrentTimeMs());
+                cvarManager->log("Recording probe trace; gamestate_trace stop to save it");
+            } else if (command == "stop" && gameProbe->isTracing()) {
+                std::string path = params.size() > 2 ? params[2] : formatLocalTime("probe-%Y%m%d-%H%M%S.gstrace");
+                if (gameProbe->stopTrace(path)) {
+                    cvarManager->log("Probe trace saved to " + path);
+                } else {
+                    cvarManager->log("Failed to write probe trace " + path);
+                }
+            } else {
+                cvarManager->log(std::string("Usage: gamestate_trace start|stop [file] (") +
+                                 (gameProbe->isTracing() ? "recording)" : "idle)"));
+            }
+        }), "Record detector probe reads and engine events for offline replay", PERMISSION_ALL);
+}
+
+// gamestate_perf [reset|overlay]: per-callsite cost dump, histogram reset
+// and the canvas overlay; plus the stats message the backend graphs
+void GameStatePlugin::setupPerf() {
+    perfOverlay = std::make_unique<PerfOverlay>(this, *hookProfiler);
+    if (perfOverlayEnabled && hookProfiler->isEnabled()) {
+        perfOverlay->show();
+    }
+
+    cvarManager->registerNotifier("gamestate_perf",
+        hookProfiler->wrapCommand("gamestate_perf", [this](std::vector<std::string> params) {
+            std::string command = params.size() > 1 ? params[1] : "";
+
+            if (command == "reset") {
+                hookProfiler->reset();
+                cvarManager->log("Hook profiler reset");
+            } else if (command == "overlay") {
+                if (perfOverlay->isShowing()) {
+                    perfOverlay->hide();
+                } else if (hookProfiler->isEnabled()) {
+                    perfOverlay->show();
+                }
+                cvarManager->log(std::string("Perf overlay ") + (perfOverlay->isShowing() ? "on" : "off"));
+            } else {
+                for (const std::string& line : hookProfiler->describe()) {
+                    cvarManager->log(line);
+                }
+            }
+        }), "Show per-hook CPU cost (p50/p99/max); reset clears it, overlay toggles the canvas view", PERMISSION_ALL);
+
+    if (perfStatsIntervalMs > 0 && hookProfiler->isEnabled() && webSocketClient) {
+        perfMessageBuffer.resize(16 * 1024);
+        tickDispatcher->subscribe("perf stats", TickCadence::every(std::chrono::milliseconds(perfStatsIntervalMs)),
+                                  TickPriority::low, [this]() {
+            sendPerfStats();
+        });
+    }
+}
+
+// One JSON text frame per interval with each callsite's window; the binary
+// protocol only covers state and event messages
+void GameStatePlugin::sendPerfStats() {
+    // Only a server that selected gamestate.json.v2 or bin.v1 expects them
+    if (!webSocketClient || !webSocketClient->isConnected() || !webSocketClient->carriesEvents()) return;
+
+    JsonWriter json(perfMessageBuffer.data(), perfMessageBuffer.size());
+    json.beginObject();
+    hookProfiler->writeWindowJson(json);
+    json.field("timestamp", getCurrentTimestamp());
+    json.endObject();
+
+    if (json.ok()) {
+        webSocketClient->sendMessage(json.data(), json.size());
+    }
+}
+
+// gamestate_timeline start|stop|dump [file]: Chrome trace-event JSON of
+// what every plugin thread did in the last few seconds, for Perfetto
+void GameStatePlugin::setupTimeline() {
+    Tracer::setThreadName("game");
+    if (timelineEnabled) {
+        Tracer::start((size_t)timelineEventsPerThread);
+    }
+
+    cvarManager->registerNotifier("gamestate_timeline",
+        hookProfiler->wrapCommand("gamestate_timeline", [this](std::vector<std::string> params) {
+            std::string command = params.size() > 1 ? params[1] : "";
+
+            if (command == "start") {
+                Tracer::start((size_t)timelineEventsPerThread);
+                cvarManager->log("Recording timeline; gamestate_timeline dump to save it");
+            } else if (command == "stop") {
+                Tracer::stop();
+                cvarManager->log("Timeline stopped; events are kept until the next start");
+            } else if (command == "dump") {
+                std::string path = params.size() > 2 ? params[2] : formatLocalTime("timeline-%Y%m%d-%H%M%S.json");
+                bool started = Tracer::dump(path, [this, path](bool ok, size_t events) {
+                    logFromAnyThread(ok ? "Timeline saved to " + path + " (" + std::to_string(events) +
+                                          " events); open it in ui.perfetto.dev"
+                                        : "Failed to write timeline " + path);
+                });
+                if (!started) {
+                    cvarManager->log("A timeline dump is still being written");
+                }
+            } else {
+                cvarManager->log(std::string("Usage: gamestate_timeline start|stop|dump [file] (") +
+                                 (Tracer::isEnabled() ? "recording, " : "idle, ") +
+                                 std::to_string(Tracer::getEventCount()) + " events)");
+            }
+        }), "Record hooks, state changes and socket I/O per thread and dump them for Perfetto", PERMISSION_ALL);
 }
 
 // Called when the plugin is unloaded by Bakkesmod
@@ -73,16 +420,50 @@ void GameStatePlugin::onUnload() {
         gameStateDetector->stopDetection();
     }
 
+    if (physicsSampler) {
+        physicsSampler->stop();
+    }
+
+    // Writes the chunk index so the file opens without a scan
+    if (sessionRecorder) {
+        sessionRecorder->close();
+    }
+
     // Disconnect WebSocket
     if (webSocketClient) {
         webSocketClient->disconnect();
     }
 
-    // Clean up resources
+    // A dump in flight still holds event names from this plugin
+    Tracer::stop();
+    Tracer::waitForDump();
+
+    // Clean up resources (closing the ring tells the reader we are gone).
+    // The dispatcher goes first: its subscribers use everything below.
+    tickDispatcher.reset();
     gameStateDetector.reset();
+    gameProbe.reset();
+    sessionRecorder.reset();
+    physicsSampler.reset();
     webSocketClient.reset();
+    shmWriter.reset();
+    stateBoard.reset();
+    stateDebouncer.reset();
+    timerWheel.reset();
+
+    // The overlay's drawable points at it; the profiler goes last, since
+    // every wrapped callback above records into it
+    if (gameWrapper) {
+        gameWrapper->UnregisterDrawables();
+    }
+    perfOverlay.reset();
+    hookProfiler.reset();
 
     cvarManager->log("GameStatePlugin unloaded successfully");
+
+    // Last: flushes whatever the components logged while shutting down
+    GS_LOG_INFO("GameStatePlugin: unloaded");
+    Logger::stop();
 }
 
 // Load plugin configuration from file
@@ -91,6 +472,38 @@ void GameStatePlugin::loadConfig() {
     websocketUrl = "ws://localhost:8080";  // Default desktop app WebSocket URL
     pollingIntervalMs = 200;                // 200ms polling interval
     usePolling = false;                     // Prefer hooks over polling
+    detectionMode = "hooks";                // "hooks", "tick" or "polling"
+    reconcileIntervalMs = 1000;             // Probe period behind the event hooks
+    autoReconnectEnabled = true;            // Keep retrying when the desktop app restarts
+    reconnectIntervalMs = 5000;             // First retry delay, doubled per attempt
+    maxReconnectDelayMs = 60000;            // Backoff cap
+    maxReconnectAttempts = 10;              // Consecutive failures before giving up
+    connectTimeoutMs = 2000;                // TCP connect limit per attempt
+    handshakeTimeoutMs = 2000;              // Upgrade response limit per attempt
+    binaryProtocolEnabled = false;          // Also offer binary messages; the server must select them
+    pingIntervalMs = 1000;                  // Heartbeat period while connected
+    transport = "websocket";                // "websocket" or "shm"
+    shmRegionName = "TTLxRL_GameState";     // Shared memory name for transport=shm
+    shmRingSizeKb = 256;                    // Ring capacity for transport=shm
+    maxMissedPongs = 3;                     // Unanswered pings before reconnecting
+    stateBoardEnabled = true;               // Publish the latest state to shared memory
+    stateBoardName = "TTLxRL_StateBoard";   // Shared memory name of the state board
+    enableDebugLogging = false;             // Debug lines (Debug builds only)
+    logFilePath = "GameStatePlugin.log";    // Diagnostics log; empty = off
+    stateChangeThrottleMs = 100;            // Minimum dwell between state updates
+    stateChangeEdge = "leading";            // "leading" or "trailing"
+    telemetryEnabled = false;               // Ball/car physics sampler
+    telemetryRateHz = 120;                  // Samples per second; 120 = every physics tick
+    telemetryEntities = "ball,cars";        // Any of ball, cars, local (own car only), all
+    telemetryCapacityFrames = 1024;         // Ring size in frames (rounded up to a power of two)
+    sessionRecordingEnabled = false;        // Write telemetry and events to .gsr session files
+    sessionRecordingDir = "recordings";     // One file per plugin load, named by start time
+    tickBudgetUs = 500;                     // Per-frame budget for deferrable tick work; 0 = off
+    perfProfilingEnabled = true;            // Time every hook, command and tick subscriber
+    perfOverlayEnabled = false;             // Draw the top callsites on the game canvas at load
+    perfStatsIntervalMs = 0;                // Per-callsite stats to the desktop app; 0 = off
+    timelineEnabled = false;                // Record the activity timeline from load
+    timelineEventsPerThread = 32768;        // Timeline ring size per thread (last few seconds)
 
     // Try to load from config file
     std::ifstream configFile("GameStatePlugin.cfg");
@@ -109,6 +522,70 @@ void GameStatePlugin::loadConfig() {
                     pollingIntervalMs = std::stoi(value);
                 } else if (key == "use_polling") {
                     usePolling = (value == "true");
+                } else if (key == "detection_mode") {
+                    detectionMode = value;
+                } else if (key == "reconcile_interval_ms") {
+                    reconcileIntervalMs = std::stoi(value);
+                } else if (key == "auto_reconnect_enabled") {
+                    autoReconnectEnabled = (value == "true");
+                } else if (key == "websocket_reconnect_interval_ms") {
+                    reconnectIntervalMs = std::stoi(value);
+                } else if (key == "websocket_max_reconnect_delay_ms") {
+                    maxReconnectDelayMs = std::stoi(value);
+                } else if (key == "websocket_max_reconnect_attempts" || key == "max_reconnect_attempts") {
+                    maxReconnectAttempts = std::stoi(value);
+                } else if (key == "websocket_connect_timeout_ms") {
+                    connectTimeoutMs = std::stoi(value);
+                } else if (key == "websocket_handshake_timeout_ms") {
+                    handshakeTimeoutMs = std::stoi(value);
+                } else if (key == "websocket_binary_protocol") {
+                    binaryProtocolEnabled = (value == "true");
+                } else if (key == "transport") {
+                    transport = value;
+                } else if (key == "shm_region_name") {
+                    shmRegionName = value;
+                } else if (key == "shm_ring_size_kb") {
+                    shmRingSizeKb = std::stoi(value);
+                } else if (key == "websocket_ping_interval_ms") {
+                    pingIntervalMs = std::stoi(value);
+                } else if (key == "websocket_max_missed_pongs") {
+                    maxMissedPongs = std::stoi(value);
+                } else if (key == "state_board_enabled") {
+                    stateBoardEnabled = (value == "true");
+                } else if (key == "state_board_name") {
+                    stateBoardName = value;
+                } else if (key == "enable_debug_logging") {
+                    enableDebugLogging = (value == "true");
+                } else if (key == "log_file_path") {
+                    logFilePath = value;
+                } else if (key == "state_change_throttle_ms") {
+                    stateChangeThrottleMs = std::stoi(value);
+                } else if (key == "state_change_edge") {
+                    stateChangeEdge = value;
+                } else if (key == "telemetry_enabled") {
+                    telemetryEnabled = (value == "true");
+                } else if (key == "telemetry_rate_hz") {
+                    telemetryRateHz = std::stoi(value);
+                } else if (key == "telemetry_entities") {
+                    telemetryEntities = value;
+                } else if (key == "telemetry_capacity_frames") {
+                    telemetryCapacityFrames = std::stoi(value);
+                } else if (key == "session_recording_enabled") {
+                    sessionRecordingEnabled = (value == "true");
+                } else if (key == "session_recording_dir") {
+                    sessionRecordingDir = value;
+                } else if (key == "tick_budget_us") {
+                    tickBudgetUs = std::stoi(value);
+                } else if (key == "perf_profiling_enabled") {
+                    perfProfilingEnabled = (value == "true");
+                } else if (key == "perf_overlay_enabled") {
+                    perfOverlayEnabled = (value == "true");
+                } else if (key == "perf_stats_interval_ms") {
+                    perfStatsIntervalMs = std::stoi(value);
+                } else if (key == "timeline_enabled") {
+                    timelineEnabled = (value == "true");
+                } else if (key == "timeline_events_per_thread") {
+                    timelineEventsPerThread = std::stoi(value);
                 }
             }
         }
@@ -122,49 +599,74 @@ void GameStatePlugin::setupEventHooks() {
 
     cvarManager->log("Setting up BakkesMod event hooks for real-time detection...");
 
-    // Hook into game tick for continuous monitoring (this one works reliably)
-    gameWrapper->HookEvent("Function Engine.GameViewportClient.Tick", [this](std::string eventName) {
-        static int tickCount = 0;
-        tickCount++;
-        
-        // Check state every 60 ticks (roughly 1 second at 60fps)
-        if (tickCount % 60 == 0) {
-            GameState newState = gameStateDetector->getCurrentState();
-            if (newState != currentState) {
-                cvarManager->log("State change detected via tick hook: " + gameStateToString(currentState) + " -> " + gameStateToString(newState));
-                onGameStateChanged(newState);
-            }
+    // Tick work runs from the dispatcher, on wall-time cadences so it keeps
+    // its rate at any frame rate
+    tickDispatcher->subscribe("throttle timers", TickCadence::everyTick(), TickPriority::critical, [this]() {
+        timerWheel->advance(clock->now());
+    });
+
+    // Drain new telemetry frames into the open chunk (no I/O here). The ring
+    // holds seconds of frames, so a deferred drain loses nothing.
+    tickDispatcher->subscribe("session frames", TickCadence::everyTick(), TickPriority::normal, [this]() {
+        if (sessionRecorder && physicsSampler) {
+            sessionRecorder->recordFrames(physicsSampler->getRing(), getCurrentTimeMs());
+        }
+    });
+
+    // Catch a state the detector holds but the plugin never sent
+    tickDispatcher->subscribe("state check", TickCadence::every(std::chrono::milliseconds(1000)), TickPriority::normal, [this]() {
+        GameState newState = gameStateDetector->getCurrentState();
+        if (newState != currentState) {
+            cvarManager->log(std::string("State change detected via tick hook: ") + gameStateToString(currentState) + " -> " + gameStateToString(newState));
+            onGameStateChanged(newState);
+        }
+    });
+
+    // Keep score and clock on the state board fresh (about 6 Hz)
+    tickDispatcher->subscribe("state board", TickCadence::every(std::chrono::milliseconds(166)), TickPriority::normal, [this]() {
+        publishStateBoard(StateBoardEvent::none);
+    });
+
+    // Score events only change the file when a goal went in
+    tickDispatcher->subscribe("session score", TickCadence::every(std::chrono::milliseconds(166)), TickPriority::low, [this]() {
+        if (sessionRecorder) {
+            const MatchInfo& match = gameStateDetector->getSnapshot().match;
+            sessionRecorder->recordScore(match.blueScore, match.orangeScore, getCurrentTimeMs());
         }
     });
 
     // Try to hook into some common events (these may or may not work)
     try {
         // Hook into match events - using more generic names
-        gameWrapper->HookEvent("Function TAGame.GameEvent_TA.OnMatchEnded", [this](std::string eventName) {
+        const std::string matchEndedEvent = "Function TAGame.GameEvent_TA.OnMatchEnded";
+        gameWrapper->HookEvent(matchEndedEvent, hookProfiler->wrapHook(matchEndedEvent, [this](std::string eventName) {
             cvarManager->log("Event: Match ended - sending inMenu state");
-            sendStateUpdate(GameState::inMenu);
-        });
+            onGameStateChanged(GameState::inMenu);
+            publishStateBoard(StateBoardEvent::matchEnded);
+        }));
     } catch (...) {
         cvarManager->log("Warning: Could not hook into match events");
     }
 
     try {
         // Hook into replay events
-        gameWrapper->HookEvent("Function TAGame.GameEvent_TA.OnReplayStarted", [this](std::string eventName) {
+        const std::string replayStartedEvent = "Function TAGame.GameEvent_TA.OnReplayStarted";
+        gameWrapper->HookEvent(replayStartedEvent, hookProfiler->wrapHook(replayStartedEvent, [this](std::string eventName) {
             cvarManager->log("Event: Replay started - sending inReplay state");
-            sendStateUpdate(GameState::inReplay);
-        });
+            onGameStateChanged(GameState::inReplay);
+            publishStateBoard(StateBoardEvent::replayStarted);
+        }));
     } catch (...) {
         cvarManager->log("Warning: Could not hook into replay events");
     }
 
-    cvarManager->log("BakkesMod event hooks setup completed - using tick-based detection as primary method");
+    cvarManager->log("BakkesMod event hooks setup completed");
 
     // Add manual command for testing state detection
-    cvarManager->registerNotifier("gamestate_check", [this](std::vector<std::string> params) {
+    cvarManager->registerNotifier("gamestate_check", hookProfiler->wrapCommand("gamestate_check", [this](std::vector<std::string> params) {
         cvarManager->log("Manual state check triggered!");
         GameState newState = gameStateDetector->getCurrentState();
-        cvarManager->log("Current detected state: " + gameStateToString(newState));
+        cvarManager->log(std::string("Current detected state: ") + gameStateToString(newState));
         
         if (newState != currentState) {
             cvarManager->log("State change detected! Sending update...");
@@ -172,17 +674,61 @@ void GameStatePlugin::setupEventHooks() {
         } else {
             cvarManager->log("No state change detected");
         }
-    }, "Manually check current game state", PERMISSION_ALL);
+    }), "Manually check current game state", PERMISSION_ALL);
+
+    // Connection health: heartbeat RTT and transport counters
+    cvarManager->registerNotifier("gamestate_net_stats", hookProfiler->wrapCommand("gamestate_net_stats", [this](std::vector<std::string> params) {
+        logNetStats();
+    }), "Show WebSocket round-trip times and transport counters", PERMISSION_ALL);
+}
+
+// Print heartbeat RTT percentiles and transport counters to the console
+void GameStatePlugin::logNetStats() {
+    if (shmWriter) {
+        cvarManager->log("Shared memory " + shmRegionName + ": written " +
+                         std::to_string(shmWriter->getMessagesWritten()) + ", dropped " +
+                         std::to_string(shmWriter->getMessagesDropped()) + ", ring " +
+                         std::to_string(shmWriter->getCapacity() / 1024) + " KB");
+    }
+    if (!webSocketClient) return;
+
+    const LatencyHistogram& rtt = webSocketClient->getRttHistogram();
+    WebSocketStats stats = webSocketClient->getStats();
+
+    cvarManager->log(std::string("WebSocket: ") + (webSocketClient->isConnected() ? "connected" : "not connected") +
+                     ", last connect " + std::to_string(webSocketClient->getLastConnectLatencyMs()) + " ms");
+    cvarManager->log("RTT (" + std::to_string(rtt.getCount()) + " pongs): p50 " +
+                     std::to_string(rtt.percentile(0.50)) + " us, p99 " +
+                     std::to_string(rtt.percentile(0.99)) + " us, max " +
+                     std::to_string(rtt.getMax()) + " us");
+    cvarManager->log("Pings sent " + std::to_string(stats.pingsSent) + ", pongs " +
+                     std::to_string(stats.pongsReceived) + ", dead-peer reconnects " +
+                     std::to_string(stats.deadPeerDisconnects));
+    cvarManager->log("Frames queued " + std::to_string(stats.framesQueued) + ", sent " +
+                     std::to_string(stats.framesSent) + ", dropped " + std::to_string(stats.framesDropped) +
+                     ", queue " + std::to_string(stats.queueDepth) + "/" + std::to_string(stats.queueCapacity));
 }
 
 // Note: Polling methods removed - now using real-time BakkesMod event hooks
 
-// Handle game state changes
+// Handle raw game state changes from detection (game thread)
 void GameStatePlugin::onGameStateChanged(GameState newState) {
+    GS_TRACE_INSTANT("state detected", "state", (std::int64_t)newState);
+    if (stateDebouncer) {
+        stateDebouncer->update(kGameStateSignal, (std::int64_t)newState);
+    } else {
+        applyStateChange(newState);
+    }
+}
+
+// Publish a state change that made it through the throttle
+void GameStatePlugin::applyStateChange(GameState newState) {
     // Only send updates if state actually changed
     if (newState == currentState) {
         return;  // No change, skip update
     }
+    TraceScope trace("state change", "state");
+    trace.setValue((std::int64_t)newState);
 
     // Update current state and timestamp
     currentState = newState;
@@ -191,25 +737,46 @@ void GameStatePlugin::onGameStateChanged(GameState newState) {
     // Send state update to desktop app
     sendStateUpdate(newState);
 
+    stateSinceMs = getCurrentTimeMs();
+    publishStateBoard(StateBoardEvent::stateChanged);
+
+    if (sessionRecorder) {
+        sessionRecorder->recordEvent(SessionEventKind::state, (std::int64_t)newState, stateSinceMs);
+    }
+
     // Log the state change
-    cvarManager->log("Game state changed to: " + gameStateToString(newState));
+    cvarManager->log(std::string("Game state changed to: ") + gameStateToString(newState));
+    GS_LOG_INFO("GameStatePlugin: state changed to %s", gameStateToString(newState));
 }
 
 // Send state update to desktop app via WebSocket
 void GameStatePlugin::sendStateUpdate(GameState state) {
+    if (shmWriter) {
+        // Same binary encoding as the WebSocket path (WireProtocol.h)
+        char message[kMaxWireMessageSize];
+        size_t length = encodeStateMessage(message, shmSequence++, (std::uint32_t)state,
+                                           (std::uint64_t)getCurrentTimestamp());
+        GS_TRACE_INSTANT("shm write", "net", (std::int64_t)length);
+        if (!shmWriter->write(message, length)) {
+            cvarManager->log("Shared memory ring full, state update dropped");
+        }
+        return;
+    }
+
     if (!webSocketClient || !webSocketClient->isConnected()) {
         cvarManager->log("WebSocket not connected, cannot send state update");
         return;
     }
 
-    std::string stateString = gameStateToString(state);
+    const char* stateString = gameStateToString(state);
     long long timestamp = getCurrentTimestamp();
 
-    webSocketClient->sendJsonMessage(stateString, timestamp);
+    // Binary or JSON, whichever the desktop app picked in the handshake
+    webSocketClient->sendStateMessage((std::uint32_t)state, stateString, timestamp);
 }
 
-// Convert GameState enum to string
-std::string GameStatePlugin::gameStateToString(GameState state) {
+// Convert GameState enum to its wire name (a literal, so nothing is allocated)
+const char* GameStatePlugin::gameStateToString(GameState state) {
     switch (state) {
         case GameState::inMenu: return "inMenu";
         case GameState::inGame: return "inGame";
@@ -219,6 +786,83 @@ std::string GameStatePlugin::gameStateToString(GameState state) {
     }
 }
 
+// Local wall-clock time through strftime, for file names
+std::string GameStatePlugin::formatLocalTime(const char* format) {
+    std::time_t now = std::time(nullptr);
+    std::tm local = {};
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    char text[128];
+    std::strftime(text, sizeof(text), format, &local);
+    return text;
+}
+
+// Match phase changes go out unthrottled; they are already sampled at ~10 Hz
+void GameStatePlugin::onMatchPhaseChanged(MatchPhase phase) {
+    GS_TRACE_INSTANT("phase", "state", (std::int64_t)phase);
+    currentPhase = phase;
+    sendPhaseUpdate(phase);
+    publishStateBoard(StateBoardEvent::none);
+
+    if (sessionRecorder) {
+        sessionRecorder->recordEvent(SessionEventKind::phase, (std::int64_t)phase, getCurrentTimeMs());
+    }
+}
+
+// Send a "phase" event message over whichever transport is active
+void GameStatePlugin::sendPhaseUpdate(MatchPhase phase) {
+    long long timestamp = getCurrentTimestamp();
+
+    if (shmWriter) {
+        char message[kMaxWireMessageSize];
+        size_t length = encodeEventMessage(message, shmSequence++, (std::uint32_t)WireEventId::Phase,
+                                           (std::uint64_t)timestamp, (std::int64_t)phase);
+        shmWriter->write(message, length);
+        return;
+    }
+
+    if (!webSocketClient || !webSocketClient->isConnected()) {
+        return;
+    }
+
+    webSocketClient->sendEventMessage((std::uint32_t)WireEventId::Phase, "phase", (std::int64_t)phase, timestamp);
+}
+
+// Publish the current state, score and clock to the state board (game thread)
+void GameStatePlugin::publishStateBoard(StateBoardEvent event) {
+    if (!stateBoard) return;
+
+    long long now = getCurrentTimeMs();
+    if (event != StateBoardEvent::none) {
+        lastBoardEvent = event;
+        lastBoardEventAtMs = now;
+    }
+
+    MatchInfo match = gameStateDetector ? gameStateDetector->getSnapshot().match : MatchInfo();
+
+    StateBoardSnapshot snapshot = {};
+    snapshot.state = (std::uint32_t)currentState.load();
+    snapshot.lastEvent = (std::uint32_t)lastBoardEvent;
+    snapshot.stateSinceMs = stateSinceMs;
+    snapshot.updatedAtMs = now;
+    snapshot.lastEventAtMs = lastBoardEventAtMs;
+    snapshot.blueScore = match.blueScore;
+    snapshot.orangeScore = match.orangeScore;
+    snapshot.secondsRemaining = match.secondsRemaining;
+    snapshot.flags = match.overtime ? kStateBoardOvertime : 0;
+    snapshot.phase = (std::uint32_t)currentPhase.load();
+    stateBoard->publish(snapshot);
+}
+
+long long GameStatePlugin::getCurrentTimeMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+}
+
 // Get current timestamp in Unix epoch format
 long long GameStatePlugin::getCurrentTimestamp() {
     return std::chrono::duration_cast<std::chrono::seconds>(
@@ -226,26 +870,43 @@ long long GameStatePlugin::getCurrentTimestamp() {
     ).count();
 }
 
-// WebSocket connected callback
+// Log from the network thread without calling into the SDK off the game thread
+void GameStatePlugin::logFromAnyThread(const std::string& message) {
+    if (!gameWrapper) return;
+    gameWrapper->Execute(hookProfiler->wrap(executeSite, [this, message](GameWrapper*) {
+        cvarManager->log(message);
+    }));
+}
+
+// WebSocket connected callback (network thread)
 void GameStatePlugin::onWebSocketConnected() {
-    cvarManager->log("WebSocket connected to desktop app");
+    logFromAnyThread("WebSocket connected to desktop app in " +
+                     std::to_string(webSocketClient->getLastConnectLatencyMs()) + " ms");
 
     // Send current state immediately upon connection
-    if (currentState != GameState::unknown) {
-        sendStateUpdate(currentState);
+    GameState state = currentState.load();
+    if (state != GameState::unknown) {
+        sendStateUpdate(state);
+    }
+
+    MatchPhase phase = currentPhase.load();
+    if (phase != MatchPhase::unknown) {
+        sendPhaseUpdate(phase);
     }
 }
 
-// WebSocket disconnected callback
+// WebSocket disconnected callback (network thread)
 void GameStatePlugin::onWebSocketDisconnected() {
-    cvarManager->log("WebSocket disconnected from desktop app");
-
-    // Attempt to reconnect after a delay
-    // Note: In a real implementation, you might want to use a timer
-    // or implement exponential backoff
+    // The client's network thread reconnects with backoff on its own
+    logFromAnyThread("WebSocket disconnected from desktop app");
 }
 
-// WebSocket error callback
+// WebSocket error callback (network thread)
 void GameStatePlugin::onWebSocketError(const std::string& error) {
-    cvarManager->log("WebSocket error: " + error);
+    logFromAnyThread("WebSocket error: " + error);
+}
+
+// Message from the desktop app (runs on the game thread)
+void GameStatePlugin::onWebSocketMessage(const std::string& message) {
+    cvarManager->log("Message from desktop app: " + message);
 }
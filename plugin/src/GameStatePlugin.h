@@ -1,24 +1,33 @@
 #pragma once
 
 #include "bakkesmod/plugin/bakkesmodplugin.h"
+#include "GameState.h"
+#include "MatchPhase.h"
+#include "StateBoard.h"
+#include "Clock.h"
 #include <memory>
 #include <string>
+#include <vector>
 #include <chrono>
+#include <atomic>
+#include <cstdint>
 
 // Use the BakkesMod namespace
 using namespace BakkesMod::Plugin;
 
 class WebSocketClient;
+class ShmRingWriter;
+class StateBoardWriter;
+class TimerWheel;
+class TickDispatcher;
+class SignalDebouncer;
 class GameStateDetector;
-
-// Game state enumeration
-enum class GameState {
-    inMenu,
-    inGame,
-    inReplay,
-    gamePaused,
-    unknown
-};
+class SdkGameProbe;
+class PhysicsSampler;
+class SessionRecorder;
+class HookProfiler;
+class PerfOverlay;
+struct HookSite;
 
 // Main plugin class that inherits from BakkesmodPlugin
 class GameStatePlugin : public BakkesMod::Plugin::BakkesModPlugin {
@@ -34,27 +43,105 @@ public:
     void onWebSocketConnected();
     void onWebSocketDisconnected();
     void onWebSocketError(const std::string& error);
+    void onWebSocketMessage(const std::string& message);
 
 private:
     // Plugin components
-    std::unique_ptr<WebSocketClient> webSocketClient;
+    std::unique_ptr<WebSocketClient> webSocketClient;   // transport=websocket
+    std::unique_ptr<ShmRingWriter> shmWriter;           // transport=shm
+    std::uint16_t shmSequence;
+    std::unique_ptr<SdkGameProbe> gameProbe;           // must outlive the detector
     std::unique_ptr<GameStateDetector> gameStateDetector;
+    std::unique_ptr<StateBoardWriter> stateBoard;       // state_board_enabled
+    std::unique_ptr<PhysicsSampler> physicsSampler;     // telemetry_enabled
+    std::unique_ptr<SessionRecorder> sessionRecorder;   // session_recording_enabled
+
+    // State change throttle (game thread)
+    std::unique_ptr<Clock> clock;
+    std::unique_ptr<TimerWheel> timerWheel;
+    std::unique_ptr<SignalDebouncer> stateDebouncer;
 
-    // State tracking
-    GameState currentState;
+    // Owner of the viewport tick (game thread)
+    std::unique_ptr<TickDispatcher> tickDispatcher;
+
+    // Per-callsite cost of everything above; created first, destroyed last
+    std::unique_ptr<HookProfiler> hookProfiler;
+    HookSite* executeSite;                              // all GameWrapper::Execute callbacks
+    std::unique_ptr<PerfOverlay> perfOverlay;
+    std::vector<char> perfMessageBuffer;                // reused by the stats message
+
+    // State tracking (read by the network thread when it resends on reconnect)
+    std::atomic<GameState> currentState;
+    std::atomic<MatchPhase> currentPhase;
     std::chrono::steady_clock::time_point lastStateChangeTime;
 
+    // State board bookkeeping (game thread)
+    long long stateSinceMs;
+    StateBoardEvent lastBoardEvent;
+    long long lastBoardEventAtMs;
+
     // Configuration
     std::string websocketUrl;
     int pollingIntervalMs;
     bool usePolling;
+    std::string detectionMode;
+    int reconcileIntervalMs;
+    bool autoReconnectEnabled;
+    int reconnectIntervalMs;
+    int maxReconnectDelayMs;
+    int maxReconnectAttempts;
+    int connectTimeoutMs;
+    int handshakeTimeoutMs;
+    bool binaryProtocolEnabled;
+    int pingIntervalMs;
+    int maxMissedPongs;
+    std::string transport;
+    std::string shmRegionName;
+    int shmRingSizeKb;
+    bool stateBoardEnabled;
+    std::string stateBoardName;
+    bool enableDebugLogging;
+    std::string logFilePath;
+    int stateChangeThrottleMs;
+    std::string stateChangeEdge;
+    bool telemetryEnabled;
+    int telemetryRateHz;
+    std::string telemetryEntities;
+    int telemetryCapacityFrames;
+    bool sessionRecordingEnabled;
+    std::string sessionRecordingDir;
+    int tickBudgetUs;
+    bool perfProfilingEnabled;
+    bool perfOverlayEnabled;
+    int perfStatsIntervalMs;
+    bool timelineEnabled;
+    int timelineEventsPerThread;
 
     // Private methods
     void loadConfig();
     void setupEventHooks();
+    void setupWebSocket();
+    void setupSharedMemoryTransport();
+    void setupStateBoard();
+    void setupStateThrottle();
+    void setupTickDispatcher();
+    void setupTelemetry();
+    void setupSessionRecording();
+    void setupProbeTrace();
+    void setupPerf();
+    void setupTimeline();
+    void sendPerfStats();
+    void applyStateChange(GameState newState);
+    void onMatchPhaseChanged(MatchPhase phase);
+    void sendPhaseUpdate(MatchPhase phase);
+    void publishStateBoard(StateBoardEvent event);
     void setupPolling();
     void setupSimplePolling();
     void sendStateUpdate(GameState state);
-    std::string gameStateToString(GameState state);
+    const char* gameStateToString(GameState state);
     long long getCurrentTimestamp();
+    long long getCurrentTimeMs();
+    std::string formatLocalTime(const char* format);
+    void logFromAnyThread(const std::string& message);
+    void logNetStats();
 };
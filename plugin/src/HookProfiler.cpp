@@ -0,0 +1,136 @@
+#include "HookProfiler.h"
+#include <algorithm>
+#include <cstdio>
+
+HookProfiler::HookProfiler() : siteCount(0), enabled(true) {
+    resetAt = std::chrono::steady_clock::now();
+    windowStartedAt = resetAt;
+}
+
+HookSite* HookProfiler::addSite(HookSiteKind kind, const std::string& name) {
+    if (!enabled) return nullptr;
+
+    // Registration happens at setup, off the hot path
+    std::lock_guard<std::mutex> lock(addMutex);
+    size_t count = siteCount.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        if (sites[i]->kind == kind && sites[i]->name == name) {
+            return sites[i].get();
+        }
+    }
+    if (count == kMaxSites) {
+        return sites[kMaxSites - 1].get();
+    }
+
+    auto site = std::make_unique<HookSite>();
+    site->kind = count == kMaxSites - 1 ? HookSiteKind::callback : kind;
+    site->name = count == kMaxSites - 1 ? std::string("other") : name;
+    sites[count] = std::move(site);
+    siteCount.store(count + 1, std::memory_order_release);
+    return sites[count].get();
+}
+
+std::vector<const HookSite*> HookProfiler::getSitesByTotal() const {
+    std::vector<const HookSite*> sorted;
+    size_t count = getSiteCount();
+    for (size_t i = 0; i < count; ++i) {
+        sorted.push_back(sites[i].get());
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [](const HookSite* a, const HookSite* b) {
+        return a->totalNs.load(std::memory_order_relaxed) > b->totalNs.load(std::memory_order_relaxed);
+    });
+    return sorted;
+}
+
+std::uint64_t HookProfiler::getTotalNs() const {
+    std::uint64_t totalNs = 0;
+    size_t count = getSiteCount();
+    for (size_t i = 0; i < count; ++i) {
+        totalNs += sites[i]->outerNs.load(std::memory_order_relaxed);
+    }
+    return totalNs;
+}
+
+std::vector<std::string> HookProfiler::describe() const {
+    std::vector<std::string> lines;
+    if (!enabled) {
+        lines.push_back("Hook profiling is off (perf_profiling_enabled=false)");
+        return lines;
+    }
+
+    std::uint64_t totalNs = getTotalNs();
+    std::vector<const HookSite*> sorted = getSitesByTotal();
+
+    double elapsedNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - resetAt).count();
+    char header[160];
+    snprintf(header, sizeof(header), "Plugin CPU time: %.1f ms over %.1f s, %.3f%% of one core, %zu callsites",
+             totalNs / 1e6, elapsedNs / 1e9, elapsedNs > 0 ? 100.0 * (double)totalNs / elapsedNs : 0.0, sorted.size());
+    lines.push_back(header);
+
+    for (const HookSite* site : sorted) {
+        std::uint64_t calls = site->cost.getCount();
+        if (calls == 0) continue;
+
+        char line[256];
+        snprintf(line, sizeof(line), "  %-8s %s: calls %llu, p50 %llu ns, p99 %llu ns, max %llu ns, total %.2f ms",
+                 kHookSiteKindNames[(size_t)site->kind], shortHookName(site->name).c_str(),
+                 (unsigned long long)calls, (unsigned long long)site->cost.percentile(0.50),
+                 (unsigned long long)site->cost.percentile(0.99), (unsigned long long)site->cost.getMax(),
+                 site->totalNs.load(std::memory_order_relaxed) / 1e6);
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+void HookProfiler::reset() {
+    size_t count = getSiteCount();
+    for (size_t i = 0; i < count; ++i) {
+        sites[i]->cost.reset();
+        sites[i]->window.reset();
+        sites[i]->totalNs.store(0, std::memory_order_relaxed);
+        sites[i]->outerNs.store(0, std::memory_order_relaxed);
+    }
+    resetAt = std::chrono::steady_clock::now();
+    windowStartedAt = resetAt;
+}
+
+void HookProfiler::writeWindowJson(JsonWriter& json) {
+    auto now = std::chrono::steady_clock::now();
+    json.key("perf");
+    json.beginArray();
+
+    size_t count = getSiteCount();
+    for (size_t i = 0; i < count; ++i) {
+        HookSite& site = *sites[i];
+        std::uint64_t calls = site.window.getCount();
+        if (calls == 0) continue;
+
+        json.beginObject();
+        json.field("site", shortHookName(site.name));
+        json.field("kind", kHookSiteKindNames[(size_t)site.kind]);
+        json.field("calls", (unsigned long long)calls);
+        json.field("p50Ns", (unsigned long long)site.window.percentile(0.50));
+        json.field("p99Ns", (unsigned long long)site.window.percentile(0.99));
+        json.field("maxNs", (unsigned long long)site.window.getMax());
+        json.endObject();
+        site.window.reset();
+    }
+
+    json.endArray();
+    json.field("windowMs", (long long)std::chrono::duration_cast<std::chrono::milliseconds>(now - windowStartedAt).count());
+    windowStartedAt = now;
+}
+
+std::string shortHookName(const std::string& name) {
+    const char* prefix = "Function ";
+    if (name.compare(0, 9, prefix) != 0) return name;
+
+    // Keep "Class.Function" (or "Class.State.Function"), drop the package
+    std::string path = name.substr(9);
+    size_t dot = path.find('.');
+    if (dot != std::string::npos && std::count(path.begin(), path.end(), '.') >= 2) {
+        return path.substr(dot + 1);
+    }
+    return path;
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "JsonWriter.h"
+#include "LatencyHistogram.h"
+#include "Tracer.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// What a callsite is, for grouping in the dump and the overlay
+enum class HookSiteKind : std::uint8_t {
+    hook,       // engine function hook
+    command,    // console notifier
+    tick,       // TickDispatcher subscriber
+    drawable,   // canvas callback
+    callback    // GameWrapper::Execute work queued from other threads
+};
+
+constexpr const char* kHookSiteKindNames[] = { "hook", "command", "tick", "drawable", "callback" };
+
+// Timed callbacks running on this thread. Tick subscribers run inside the
+// Tick hook; only outermost calls count towards the plugin's total.
+inline thread_local int hookTimerDepth = 0;
+
+// Cost of one callsite in nanoseconds. `cost` covers everything since load
+// (or gamestate_perf reset); `window` only since the last stats message.
+// One thread records (the game thread); any thread may read.
+struct HookSite {
+    HookSiteKind kind = HookSiteKind::hook;
+    std::string name;
+    LatencyHistogram cost;
+    LatencyHistogram window;
+    std::atomic<std::uint64_t> totalNs{0};
+    std::atomic<std::uint64_t> outerNs{0};     // calls not nested in another site
+
+    void record(std::uint64_t ns) {
+        cost.record(ns);
+        window.record(ns);
+        totalNs.store(totalNs.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+        if (hookTimerDepth == 0) {
+            outerNs.store(outerNs.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+        }
+    }
+};
+
+// Times the enclosing scope into a site, and onto the timeline while
+// tracing; does nothing for a null site
+class ScopedHookTimer {
+public:
+    explicit ScopedHookTimer(HookSite* site)
+        : site(site), start(site ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point()) {
+        if (site) ++hookTimerDepth;
+    }
+
+    ~ScopedHookTimer() {
+        if (site) {
+            --hookTimerDepth;
+            auto end = std::chrono::steady_clock::now();
+            site->record((std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            if (Tracer::isEnabled()) {
+                Tracer::complete(site->name.c_str(), kHookSiteKindNames[(size_t)site->kind],
+                                 Tracer::toNs(start), Tracer::toNs(end));
+            }
+        }
+    }
+
+private:
+    HookSite* site;
+    std::chrono::steady_clock::time_point start;
+
+    ScopedHookTimer(const ScopedHookTimer&) = delete;
+    ScopedHookTimer& operator=(const ScopedHookTimer&) = delete;
+};
+
+// Per-callsite CPU cost of everything the plugin runs on the game thread:
+// hooks, notifiers, tick subscribers, drawables and Execute callbacks. Each
+// callback is wrapped at registration, so a call costs two steady-clock
+// reads (QueryPerformanceCounter / clock_gettime) and two relaxed
+// histogram updates.
+//
+//   gameWrapper->HookEvent(name, profiler.wrapHook(name, [this](std::string eventName) { ... }));
+//   cvarManager->registerNotifier("gamestate_x", profiler.wrapCommand("gamestate_x", ...), ...);
+//
+// Sites are registered at setup and live as long as the profiler; the
+// table is fixed-size, so readers never race a reallocation.
+class HookProfiler {
+public:
+    static constexpr size_t kMaxSites = 64;
+
+    HookProfiler();
+
+    // Off: new sites are not registered and wrapped callbacks are not timed
+    void setEnabled(bool on) { enabled = on; }
+    bool isEnabled() const { return enabled; }
+
+    // Find or register a site; nullptr when disabled. Past kMaxSites every
+    // new name shares one "other" site.
+    HookSite* addSite(HookSiteKind kind, const std::string& name);
+
+    // Wrap a callback so each call is timed into the named site
+    template<typename Callback>
+    auto wrap(HookSite* site, Callback callback) {
+        return [site, callback = std::move(callback)](auto&&... args) mutable {
+            ScopedHookTimer timer(site);
+            return callback(std::forward<decltype(args)>(args)...);
+        };
+    }
+
+    template<typename Callback>
+    auto wrapHook(const std::string& eventName, Callback callback) {
+        return wrap(addSite(HookSiteKind::hook, eventName), std::move(callback));
+    }
+
+    template<typename Callback>
+    auto wrapCommand(const std::string& command, Callback callback) {
+        return wrap(addSite(HookSiteKind::command, command), std::move(callback));
+    }
+
+    size_t getSiteCount() const { return siteCount.load(std::memory_order_acquire); }
+    const HookSite& getSite(size_t index) const { return *sites[index]; }
+
+    // Sites by total time spent, most expensive first
+    std::vector<const HookSite*> getSitesByTotal() const;
+    // Time spent in the plugin, nested calls counted once
+    std::uint64_t getTotalNs() const;
+
+    // gamestate_perf: p50/p99/max and total per site, plus the share of a
+    // core the plugin used since load or reset
+    std::vector<std::string> describe() const;
+    void reset();
+
+    // Stats message body: each site's window ("perf": [...], "windowMs"),
+    // then the windows restart. Game thread.
+    void writeWindowJson(JsonWriter& json);
+
+private:
+    std::array<std::unique_ptr<HookSite>, kMaxSites> sites;    // the last one may be "other"
+    std::atomic<size_t> siteCount;
+    std::mutex addMutex;
+    bool enabled;
+    std::chrono::steady_clock::time_point resetAt;
+    std::chrono::steady_clock::time_point windowStartedAt;
+
+    // Disable copying
+    HookProfiler(const HookProfiler&) = delete;
+    HookProfiler& operator=(const HookProfiler&) = delete;
+};
+
+// "Function TAGame.Car_TA.SetVehicleInput" -> "Car_TA.SetVehicleInput"
+std::string shortHookName(const std::string& name);
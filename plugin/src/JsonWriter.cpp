@@ -0,0 +1,131 @@
+#include "JsonWriter.h"
+#include <charconv>
+#include <cstring>
+
+// Characters that must be escaped inside a JSON string
+static inline bool needsEscape(unsigned char c) {
+    return c < 0x20 || c == '"' || c == '\\';
+}
+
+JsonWriter::JsonWriter(char* buffer, size_t capacity)
+    : buffer(buffer), capacity(capacity), length(0), overflow(false), needComma(false) {
+}
+
+void JsonWriter::beginObject() {
+    beforeValue();
+    put('{');
+    needComma = false;
+}
+
+void JsonWriter::endObject() {
+    put('}');
+    needComma = true;
+}
+
+void JsonWriter::beginArray() {
+    beforeValue();
+    put('[');
+    needComma = false;
+}
+
+void JsonWriter::endArray() {
+    put(']');
+    needComma = true;
+}
+
+void JsonWriter::key(std::string_view name) {
+    beforeValue();
+    put('"');
+    append(name.data(), name.size());
+    put('"');
+    put(':');
+    needComma = false;  // the value follows without a comma
+}
+
+void JsonWriter::stringValue(std::string_view value) {
+    beforeValue();
+    put('"');
+    appendEscaped(value);
+    put('"');
+    needComma = true;
+}
+
+void JsonWriter::intValue(std::int64_t value) {
+    beforeValue();
+    char digits[24];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    append(digits, (size_t)(result.ptr - digits));
+    needComma = true;
+}
+
+void JsonWriter::uintValue(std::uint64_t value) {
+    beforeValue();
+    char digits[24];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    append(digits, (size_t)(result.ptr - digits));
+    needComma = true;
+}
+
+void JsonWriter::boolValue(bool value) {
+    beforeValue();
+    if (value) {
+        append("true", 4);
+    } else {
+        append("false", 5);
+    }
+    needComma = true;
+}
+
+void JsonWriter::beforeValue() {
+    if (needComma) {
+        put(',');
+    }
+}
+
+void JsonWriter::put(char c) {
+    if (length < capacity) {
+        buffer[length++] = c;
+    } else {
+        overflow = true;
+    }
+}
+
+void JsonWriter::append(const char* text, size_t count) {
+    if (capacity - length < count) {
+        overflow = true;
+        length = capacity;
+        return;
+    }
+    std::memcpy(buffer + length, text, count);
+    length += count;
+}
+
+// Copy runs of safe characters in one go; escape the rest
+void JsonWriter::appendEscaped(std::string_view value) {
+    static const char kHex[] = "0123456789abcdef";
+
+    size_t runStart = 0;
+    for (size_t i = 0; i < value.size(); ++i) {
+        unsigned char c = (unsigned char)value[i];
+        if (!needsEscape(c)) {
+            continue;
+        }
+
+        append(value.data() + runStart, i - runStart);
+        runStart = i + 1;
+
+        switch (c) {
+            case '"':  append("\\\"", 2); break;
+            case '\\': append("\\\\", 2); break;
+            case '\n': append("\\n", 2); break;
+            case '\r': append("\\r", 2); break;
+            case '\t': append("\\t", 2); break;
+            default: {
+                char escape[6] = { '\\', 'u', '0', '0', kHex[c >> 4], kHex[c & 0xF] };
+                append(escape, sizeof(escape));
+                break;
+            }
+        }
+    }
+    append(value.data() + runStart, value.size() - runStart);
+}
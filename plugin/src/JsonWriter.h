@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Streaming JSON writer for outgoing messages. Writes into a caller-provided
+// buffer and never allocates; commas are inserted automatically. If the
+// buffer runs out, the writer stops and ok() turns false.
+//
+//   char buffer[128];
+//   JsonWriter json(buffer, sizeof(buffer));
+//   json.beginObject();
+//   json.field("state", "inGame");
+//   json.field("timestamp", 1700000000LL);
+//   json.endObject();
+//   if (json.ok()) send(json.data(), json.size());
+class JsonWriter {
+public:
+    JsonWriter(char* buffer, size_t capacity);
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+
+    // Object member name; names are expected to be plain ASCII literals
+    void key(std::string_view name);
+
+    // Values
+    void stringValue(std::string_view value);   // escaped only if it needs it
+    void intValue(std::int64_t value);
+    void uintValue(std::uint64_t value);
+    void boolValue(bool value);
+
+    // key() followed by a value
+    void field(std::string_view name, std::string_view value) { key(name); stringValue(value); }
+    void field(std::string_view name, const char* value) { key(name); stringValue(value); }
+    void field(std::string_view name, int value) { key(name); intValue(value); }
+    void field(std::string_view name, long value) { key(name); intValue(value); }
+    void field(std::string_view name, long long value) { key(name); intValue(value); }
+    void field(std::string_view name, unsigned value) { key(name); uintValue(value); }
+    void field(std::string_view name, unsigned long value) { key(name); uintValue(value); }
+    void field(std::string_view name, unsigned long long value) { key(name); uintValue(value); }
+    void field(std::string_view name, bool value) { key(name); boolValue(value); }
+
+    const char* data() const { return buffer; }
+    size_t size() const { return length; }
+    bool ok() const { return !overflow; }
+
+private:
+    char* buffer;
+    size_t capacity;
+    size_t length;
+    bool overflow;
+    bool needComma;     // a value was written at the current nesting level
+
+    void beforeValue();
+    void put(char c);
+    void append(const char* text, size_t count);
+    void appendEscaped(std::string_view value);
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Fixed-bucket log-linear histogram of latencies in whatever unit the
+// caller records (microseconds for the network stats, nanoseconds for hook
+// and frame costs). Values below 32 get exact buckets; above that every
+// power of two is split into 16 linear sub-buckets, so a reported
+// percentile is within 1/16 (6.25%) of the true value. Values of 2^32 and
+// up (about 71 minutes in us, 4.3 s in ns) land in the last bucket.
+//
+// One thread records; any thread may read. Buckets are relaxed atomics, so
+// a reader sees a consistent-enough view without locking the writer.
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 4;
+    static constexpr std::uint64_t kSubBuckets = 1u << kSubBucketBits;
+    static constexpr int kMaxValueBits = 32;
+    static constexpr size_t kBucketCount = (kMaxValueBits - kSubBucketBits + 1) * kSubBuckets;
+
+    LatencyHistogram() {
+        reset();
+    }
+
+    void record(std::uint64_t valueUs) {
+        buckets[bucketIndex(valueUs)].fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+
+        std::uint64_t previous = maxValue.load(std::memory_order_relaxed);
+        while (valueUs > previous &&
+               !maxValue.compare_exchange_weak(previous, valueUs, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Value at quantile q (0..1), as the upper bound of its bucket; 0 if empty
+    std::uint64_t percentile(double q) const {
+        std::uint64_t total = count.load(std::memory_order_relaxed);
+        if (total == 0) {
+            return 0;
+        }
+
+        std::uint64_t rank = (std::uint64_t)(q * (double)total);
+        if (rank >= total) {
+            rank = total - 1;
+        }
+
+        std::uint64_t seen = 0;
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            seen += buckets[i].load(std::memory_order_relaxed);
+            if (seen > rank) {
+                return std::min(bucketUpperBound(i), getMax());
+            }
+        }
+        return getMax();
+    }
+
+    std::uint64_t getCount() const { return count.load(std::memory_order_relaxed); }
+    std::uint64_t getMax() const { return maxValue.load(std::memory_order_relaxed); }
+
+    void reset() {
+        for (auto& bucket : buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        count.store(0, std::memory_order_relaxed);
+        maxValue.store(0, std::memory_order_relaxed);
+    }
+
+    static size_t bucketIndex(std::uint64_t value) {
+        if (value < 2 * kSubBuckets) {
+            return (size_t)value;
+        }
+
+        int msb = 63;
+        while (!(value >> msb)) {
+            --msb;
+        }
+        int shift = msb - kSubBucketBits;
+        size_t index = (size_t)(shift + 1) * kSubBuckets + (size_t)((value >> shift) - kSubBuckets);
+        return index < kBucketCount ? index : kBucketCount - 1;
+    }
+
+    static std::uint64_t bucketUpperBound(size_t index) {
+        if (index < 2 * kSubBuckets) {
+            return index;
+        }
+        int shift = (int)(index / kSubBuckets) - 1;
+        std::uint64_t sub = index % kSubBuckets + kSubBuckets;
+        return ((sub + 1) << shift) - 1;
+    }
+
+private:
+    std::array<std::atomic<std::uint64_t>, kBucketCount> buckets;
+    std::atomic<std::uint64_t> count;
+    std::atomic<std::uint64_t> maxValue;
+};
@@ -0,0 +1,264 @@
+#include "Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr size_t kLogRingSlots = 256;       // lines buffered per thread
+constexpr size_t kLogLineMax = 240;         // longer lines are truncated
+constexpr int kFlushIntervalMs = 50;
+
+struct LogRecord {
+    std::int64_t timeUs;                    // system clock
+    std::uint16_t level;
+    std::uint16_t threadId;
+    std::uint32_t length;
+    char text[kLogLineMax];
+};
+
+// One thread's lines; the thread is the only producer, the writer thread
+// the only consumer
+struct ThreadRing {
+    LogRecord slots[kLogRingSlots];
+    std::atomic<std::uint32_t> head{0};
+    std::atomic<std::uint32_t> tail{0};
+    std::uint16_t threadId = 0;
+};
+
+struct LoggerState {
+    // Rings are registered once per thread and live as long as the process,
+    // so a thread's cached pointer never dangles across stop()/start()
+    std::mutex ringsMutex;
+    std::vector<std::unique_ptr<ThreadRing>> rings;
+
+    std::atomic<bool> running{false};
+    std::atomic<std::uint64_t> dropped{0};
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    bool stopRequested = false;
+    std::atomic<bool> flushRequested{false};
+
+    std::thread writer;
+    std::FILE* file = nullptr;
+
+    // Writer thread only
+    std::vector<ThreadRing*> drainRings;
+    std::vector<LogRecord> batch;
+    std::uint64_t droppedReported = 0;
+
+    // Programs that never call stop() (tools, benchmarks) exit cleanly
+    ~LoggerState();
+};
+
+LoggerState& state() {
+    static LoggerState instance;
+    return instance;
+}
+
+thread_local ThreadRing* tlsRing = nullptr;
+
+ThreadRing* threadRing() {
+    if (!tlsRing) {
+        LoggerState& s = state();
+        std::lock_guard<std::mutex> lock(s.ringsMutex);
+        s.rings.push_back(std::make_unique<ThreadRing>());
+        tlsRing = s.rings.back().get();
+        tlsRing->threadId = (std::uint16_t)s.rings.size();
+    }
+    return tlsRing;
+}
+
+const char* levelName(std::uint16_t level) {
+    switch ((LogLevel)level) {
+        case LogLevel::Debug: return "DEBUG";
+        case LogLevel::Info: return "INFO";
+        case LogLevel::Warn: return "WARN";
+        case LogLevel::Error: return "ERROR";
+    }
+    return "?";
+}
+
+std::int64_t nowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// "2026-01-31 18:04:05" for the second containing timeUs
+void formatSecond(std::int64_t timeUs, char* out, size_t size) {
+    std::time_t seconds = (std::time_t)(timeUs / 1000000);
+    std::tm local;
+#ifdef _WIN32
+    localtime_s(&local, &seconds);
+#else
+    localtime_r(&seconds, &local);
+#endif
+    std::strftime(out, size, "%Y-%m-%d %H:%M:%S", &local);
+}
+
+// Move every queued line to the file, oldest first (writer thread)
+void drain(LoggerState& s) {
+    {
+        std::lock_guard<std::mutex> lock(s.ringsMutex);
+        s.drainRings.clear();
+        for (const auto& ring : s.rings) {
+            s.drainRings.push_back(ring.get());
+        }
+    }
+
+    s.batch.clear();
+    for (ThreadRing* ring : s.drainRings) {
+        std::uint32_t tail = ring->tail.load(std::memory_order_relaxed);
+        std::uint32_t head = ring->head.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) {
+            s.batch.push_back(ring->slots[tail & (kLogRingSlots - 1)]);
+        }
+        ring->tail.store(tail, std::memory_order_release);
+    }
+
+    std::stable_sort(s.batch.begin(), s.batch.end(),
+        [](const LogRecord& a, const LogRecord& b) { return a.timeUs < b.timeUs; });
+
+    if (!s.file) return;
+
+    char second[32] = "";
+    std::int64_t formattedSecond = -1;
+    for (const LogRecord& record : s.batch) {
+        if (record.timeUs / 1000000 != formattedSecond) {
+            formattedSecond = record.timeUs / 1000000;
+            formatSecond(record.timeUs, second, sizeof(second));
+        }
+        std::fprintf(s.file, "%s.%03d [%s] [T%u] %.*s\n", second, (int)(record.timeUs / 1000 % 1000),
+                     levelName(record.level), (unsigned)record.threadId, (int)record.length, record.text);
+    }
+
+    std::uint64_t dropped = s.dropped.load(std::memory_order_relaxed);
+    if (dropped != s.droppedReported) {
+        std::fprintf(s.file, "[WARN] Logger: %llu line(s) dropped, ring full\n",
+                     (unsigned long long)(dropped - s.droppedReported));
+        s.droppedReported = dropped;
+    }
+
+    if (!s.batch.empty()) {
+        std::fflush(s.file);
+    }
+}
+
+// Ask the writer thread for a final drain and wait for it
+void stopWriter(LoggerState& s) {
+    if (!s.writer.joinable()) {
+        return;
+    }
+
+    s.running.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(s.wakeMutex);
+        s.stopRequested = true;
+    }
+    s.wake.notify_one();
+    s.writer.join();
+
+    std::fclose(s.file);
+    s.file = nullptr;
+}
+
+LoggerState::~LoggerState() {
+    stopWriter(*this);
+}
+
+void writerLoop() {
+    LoggerState& s = state();
+    for (;;) {
+        bool stopping;
+        {
+            std::unique_lock<std::mutex> lock(s.wakeMutex);
+            s.wake.wait_for(lock, std::chrono::milliseconds(kFlushIntervalMs),
+                            [&s] { return s.stopRequested || s.flushRequested.load(); });
+            stopping = s.stopRequested;
+        }
+
+        s.flushRequested.store(false);
+
+        drain(s);
+        if (stopping) break;
+    }
+}
+
+} // namespace
+
+std::atomic<bool> Logger::debugEnabled(false);
+
+bool Logger::start(const std::string& path, bool enableDebug) {
+    stop();
+
+    LoggerState& s = state();
+    s.file = std::fopen(path.c_str(), "a");
+    if (!s.file) {
+        return false;
+    }
+
+    setDebugEnabled(enableDebug);
+    s.dropped.store(0, std::memory_order_relaxed);
+    s.droppedReported = 0;
+    s.stopRequested = false;
+    s.batch.reserve(kLogRingSlots * 4);
+    s.writer = std::thread(writerLoop);
+    s.running.store(true, std::memory_order_release);
+    return true;
+}
+
+void Logger::stop() {
+    stopWriter(state());
+}
+
+void Logger::write(LogLevel level, const char* format, ...) {
+    LoggerState& s = state();
+
+    va_list args;
+    va_start(args, format);
+
+    if (!s.running.load(std::memory_order_acquire)) {
+        std::vfprintf(stderr, format, args);
+        std::fputc('\n', stderr);
+        va_end(args);
+        return;
+    }
+
+    ThreadRing* ring = threadRing();
+    std::uint32_t head = ring->head.load(std::memory_order_relaxed);
+    std::uint32_t tail = ring->tail.load(std::memory_order_acquire);
+    if (head - tail >= kLogRingSlots) {
+        s.dropped.fetch_add(1, std::memory_order_relaxed);
+        va_end(args);
+        return;
+    }
+
+    LogRecord& record = ring->slots[head & (kLogRingSlots - 1)];
+    record.timeUs = nowUs();
+    record.level = (std::uint16_t)level;
+    record.threadId = ring->threadId;
+    int length = std::vsnprintf(record.text, sizeof(record.text), format, args);
+    va_end(args);
+    record.length = length < 0 ? 0 : (std::uint32_t)std::min<size_t>((size_t)length, sizeof(record.text) - 1);
+
+    ring->head.store(head + 1, std::memory_order_release);
+
+    // Errors should reach the file promptly; a burst that half-fills the
+    // ring should not have to wait for the next flush interval
+    if (level == LogLevel::Error || head - tail == kLogRingSlots / 2) {
+        s.flushRequested.store(true);
+        s.wake.notify_one();
+    }
+}
+
+std::uint64_t Logger::getDropped() {
+    return state().dropped.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Asynchronous file logger (GameStatePlugin.cfg: log_file_path,
+// enable_debug_logging). A log call formats straight into a slot of the
+// calling thread's own ring and returns; a background thread drains all
+// rings, orders the lines by time and appends them to the file. Nothing on
+// the calling side locks, allocates or touches the file. When a thread's
+// ring is full the line is dropped and counted.
+//
+// Debug lines are compiled out unless GAMESTATE_DEBUG_LOGGING is defined
+// (Debug builds), arguments included; when compiled in they are still off
+// until enable_debug_logging=true.
+//
+//   GS_LOG_INFO("WebSocketClient: Connected to %s in %lld ms", url.c_str(), ms);
+//   GS_LOG_DEBUG("GameStateDetector: probe returned %d", (int)state);
+//
+// Before Logger::start() (benchmarks, tools) lines go straight to stderr.
+
+enum class LogLevel : std::uint32_t {
+    Debug,
+    Info,
+    Warn,
+    Error
+};
+
+#if defined(__GNUC__) || defined(__clang__)
+#define GS_LOG_PRINTF(fmt, args) __attribute__((format(printf, fmt, args)))
+#else
+#define GS_LOG_PRINTF(fmt, args)
+#endif
+
+class Logger {
+public:
+    // Open (append to) path and start the writer thread
+    static bool start(const std::string& path, bool debugEnabled);
+    // Drain everything logged so far, stop the thread and close the file
+    static void stop();
+
+    static bool isDebugEnabled() { return debugEnabled.load(std::memory_order_relaxed); }
+    static void setDebugEnabled(bool enabled) { debugEnabled.store(enabled, std::memory_order_relaxed); }
+
+    static void write(LogLevel level, const char* format, ...) GS_LOG_PRINTF(2, 3);
+
+    // Lines lost to full rings since start()
+    static std::uint64_t getDropped();
+
+private:
+    static std::atomic<bool> debugEnabled;
+};
+
+#ifdef GAMESTATE_DEBUG_LOGGING
+#define GS_LOG_DEBUG(...) \
+    do { if (Logger::isDebugEnabled()) Logger::write(LogLevel::Debug, __VA_ARGS__); } while (0)
+#else
+#define GS_LOG_DEBUG(...) do { } while (0)
+#endif
+
+#define GS_LOG_INFO(...) Logger::write(LogLevel::Info, __VA_ARGS__)
+#define GS_LOG_WARN(...) Logger::write(LogLevel::Warn, __VA_ARGS__)
+#define GS_LOG_ERROR(...) Logger::write(LogLevel::Error, __VA_ARGS__)
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Read-only view of a whole file mapped into memory (MapViewOfFile /
+// mmap). Pages are loaded on first touch, so opening a large recording is
+// cheap and only the parts a reader looks at are read from disk.
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return base != nullptr; }
+    const char* data() const { return static_cast<const char*>(base); }
+    size_t size() const { return length; }
+
+private:
+    void* base;
+    size_t length;
+#ifdef _WIN32
+    void* fileHandle;       // HANDLE
+    void* mapping;          // HANDLE
+#endif
+
+    // Disable copying
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+};
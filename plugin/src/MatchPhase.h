@@ -0,0 +1,206 @@
+#pragma once
+
+#include "GameState.h"
+#include <cstddef>
+#include <cstdint>
+
+// Fine-grained phase of a match, sampled from ServerWrapper fields, for
+// consumers that time inputs around kickoffs, goals and the podium. Sent as
+// "phase" event messages (WireProtocol.h: WireEventId::Phase). Consumers
+// that only know GameState keep receiving it; toLegacyState() is the
+// mapping.
+//
+// The values are wire ids, so only append new phases.
+enum class MatchPhase : std::uint8_t {
+    menu,           // not in a match
+    countdown,      // pre-kickoff 3-2-1, round not active yet
+    kickoff,        // round active, ball not touched yet
+    live,           // regular play
+    overtime,       // play in overtime
+    goalScored,     // goal explosion until the replay or next countdown
+    replay,         // goal replay
+    paused,
+    postGame,       // match over: podium / scoreboard
+    unknown
+};
+
+constexpr size_t kMatchPhaseCount = (size_t)MatchPhase::unknown + 1;
+
+constexpr const char* kMatchPhaseNames[kMatchPhaseCount] = {
+    "menu", "countdown", "kickoff", "live", "overtime",
+    "goalScored", "replay", "paused", "postGame", "unknown"
+};
+
+// ServerWrapper fields one sample is classified from
+struct MatchPhaseInputs {
+    bool inMatch = false;           // a game event exists
+    bool inReplay = false;
+    bool paused = false;
+    bool matchEnded = false;        // GetbMatchEnded
+    bool roundActive = false;       // GetbRoundActive
+    bool ballHasBeenHit = false;    // GetbBallHasBeenHit
+    bool overtime = false;          // GetbOverTime
+    int waitTimeRemaining = 0;      // GetWaitTimeRemaining
+};
+
+// Phase a single sample shows, before the transition table is applied
+constexpr MatchPhase classifyMatchPhase(const MatchPhaseInputs& in) {
+    if (in.inReplay) return MatchPhase::replay;     // goal replays and the replay viewer
+    if (!in.inMatch) return MatchPhase::menu;
+    if (in.matchEnded) return MatchPhase::postGame;
+    if (in.paused) return MatchPhase::paused;
+    if (in.waitTimeRemaining > 0) return MatchPhase::countdown;
+    if (!in.roundActive) return in.ballHasBeenHit ? MatchPhase::goalScored : MatchPhase::countdown;
+    if (!in.ballHasBeenHit) return MatchPhase::kickoff;
+    return in.overtime ? MatchPhase::overtime : MatchPhase::live;
+}
+
+// What consumers of the old state stream see. The podium maps to inMenu,
+// matching the match-ended hook that has always sent inMenu.
+constexpr GameState toLegacyState(MatchPhase phase) {
+    switch (phase) {
+        case MatchPhase::menu: return GameState::inMenu;
+        case MatchPhase::countdown: return GameState::inGame;
+        case MatchPhase::kickoff: return GameState::inGame;
+        case MatchPhase::live: return GameState::inGame;
+        case MatchPhase::overtime: return GameState::inGame;
+        case MatchPhase::goalScored: return GameState::inGame;
+        case MatchPhase::replay: return GameState::inReplay;
+        case MatchPhase::paused: return GameState::gamePaused;
+        case MatchPhase::postGame: return GameState::inMenu;
+        case MatchPhase::unknown: return GameState::unknown;
+    }
+    return GameState::unknown;
+}
+
+// Transitions the game actually makes, row = from, column = to. A sample
+// that implies any other transition is treated as a glitch until it is
+// seen twice in a row (MatchPhaseTracker).
+namespace match_phase_detail {
+
+constexpr bool X = true;
+constexpr bool _ = false;
+
+constexpr bool kTransitions[kMatchPhaseCount][kMatchPhaseCount] = {
+    //            menu cntdn kick live  ot  goal rply paus post unkn
+    /* menu     */ { _,   X,   X,   X,   _,   _,   _,   _,   _,   X },
+    /* countdown*/ { X,   _,   X,   X,   X,   _,   _,   X,   X,   X },
+    /* kickoff  */ { X,   X,   _,   X,   X,   _,   _,   X,   X,   X },
+    /* live     */ { X,   X,   _,   _,   X,   X,   _,   X,   X,   X },
+    /* overtime */ { X,   X,   _,   _,   _,   X,   _,   X,   X,   X },
+    /* goal     */ { X,   X,   _,   _,   _,   _,   X,   _,   X,   X },
+    /* replay   */ { X,   X,   _,   _,   _,   _,   _,   _,   X,   X },
+    /* paused   */ { X,   X,   X,   X,   X,   X,   X,   _,   X,   X },
+    /* postGame */ { X,   X,   _,   _,   _,   _,   _,   _,   _,   X },
+    /* unknown  */ { X,   X,   X,   X,   X,   X,   X,   X,   X,   _ },
+};
+
+} // namespace match_phase_detail
+
+inline constexpr const auto& kMatchPhaseTransitions = match_phase_detail::kTransitions;
+
+constexpr bool isMatchPhaseTransitionAllowed(MatchPhase from, MatchPhase to) {
+    return kMatchPhaseTransitions[(size_t)from][(size_t)to];
+}
+
+namespace match_phase_detail {
+
+// Every phase reachable from `start` through allowed transitions
+constexpr bool reachesAll(MatchPhase start) {
+    bool seen[kMatchPhaseCount] = {};
+    seen[(size_t)start] = true;
+    for (size_t round = 0; round < kMatchPhaseCount; ++round) {
+        for (size_t from = 0; from < kMatchPhaseCount; ++from) {
+            if (!seen[from]) continue;
+            for (size_t to = 0; to < kMatchPhaseCount; ++to) {
+                if (kMatchPhaseTransitions[from][to]) seen[to] = true;
+            }
+        }
+    }
+    for (size_t i = 0; i < kMatchPhaseCount; ++i) {
+        if (!seen[i]) return false;
+    }
+    return true;
+}
+
+constexpr bool noSelfTransitions() {
+    for (size_t i = 0; i < kMatchPhaseCount; ++i) {
+        if (kMatchPhaseTransitions[i][i]) return false;
+    }
+    return true;
+}
+
+// Leaving a match and losing track are always possible
+constexpr bool alwaysLeavable() {
+    for (size_t i = 0; i < kMatchPhaseCount; ++i) {
+        if (i != (size_t)MatchPhase::menu && !kMatchPhaseTransitions[i][(size_t)MatchPhase::menu]) return false;
+        if (i != (size_t)MatchPhase::unknown && !kMatchPhaseTransitions[i][(size_t)MatchPhase::unknown]) return false;
+    }
+    return true;
+}
+
+// Every known phase maps to a real legacy state
+constexpr bool legacyStatesCovered() {
+    for (size_t i = 0; i < kMatchPhaseCount; ++i) {
+        if (toLegacyState((MatchPhase)i) == GameState::unknown && i != (size_t)MatchPhase::unknown) return false;
+    }
+    return true;
+}
+
+} // namespace match_phase_detail
+
+static_assert(match_phase_detail::noSelfTransitions(), "a phase never transitions to itself");
+static_assert(match_phase_detail::reachesAll(MatchPhase::menu), "every phase must be reachable from the menu");
+static_assert(match_phase_detail::reachesAll(MatchPhase::unknown), "every phase must be reachable after losing track");
+static_assert(match_phase_detail::alwaysLeavable(), "every phase must be able to return to menu and unknown");
+static_assert(match_phase_detail::legacyStatesCovered(), "every known phase needs a legacy GameState");
+static_assert(isMatchPhaseTransitionAllowed(MatchPhase::live, MatchPhase::goalScored), "goals end live play");
+static_assert(!isMatchPhaseTransitionAllowed(MatchPhase::replay, MatchPhase::live), "play resumes through a countdown");
+static_assert(classifyMatchPhase({ true, false, false, false, true, false, false, 0 }) == MatchPhase::kickoff,
+              "active round with an untouched ball is a kickoff");
+
+// Applies the transition table to a stream of samples. One sample showing
+// a transition the table does not allow is ignored; if the next sample
+// agrees, the tracker resyncs to it (and counts it), so detection never
+// gets stuck on a phase the game has left.
+class MatchPhaseTracker {
+public:
+    MatchPhase getPhase() const { return phase; }
+    std::uint64_t getResyncCount() const { return resyncs; }
+
+    // Feed one classified sample; returns true if the phase changed
+    bool observe(MatchPhase sample) {
+        if (sample == phase) {
+            hasCandidate = false;
+            return false;
+        }
+
+        if (isMatchPhaseTransitionAllowed(phase, sample)) {
+            phase = sample;
+            hasCandidate = false;
+            return true;
+        }
+
+        if (hasCandidate && candidate == sample) {
+            phase = sample;
+            hasCandidate = false;
+            ++resyncs;
+            return true;
+        }
+
+        candidate = sample;
+        hasCandidate = true;
+        return false;
+    }
+
+    void reset(MatchPhase to = MatchPhase::unknown) {
+        phase = to;
+        hasCandidate = false;
+    }
+
+private:
+    MatchPhase phase = MatchPhase::unknown;
+    MatchPhase candidate = MatchPhase::unknown;
+    bool hasCandidate = false;
+    std::uint64_t resyncs = 0;
+};
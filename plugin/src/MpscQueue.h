@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Bounded multi-producer / single-consumer queue (Vyukov's sequence-per-cell
+// design). Producers claim a cell with one CAS and fill it in place, so a
+// push is O(1) and never takes a lock. Cell values are reused rather than
+// destroyed, which lets std::string slots keep their capacity between uses.
+template <typename T>
+class MpscQueue {
+public:
+    // Capacity is rounded up to a power of two
+    explicit MpscQueue(size_t requestedCapacity)
+        : mask(roundUpPow2(requestedCapacity) - 1), enqueuePos(0), dequeuePos(0) {
+        cells.reset(new Cell[mask + 1]);
+        for (size_t i = 0; i <= mask; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // Claim a free cell and fill it with fill(T&). Returns false if the queue is full.
+    template <typename Fill>
+    bool tryPush(Fill&& fill) {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        for (;;) {
+            cell = &cells[pos & mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // full
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        fill(cell->value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Hand the oldest element to consume(T&). Single consumer only.
+    template <typename Consume>
+    bool tryPop(Consume&& consume) {
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        Cell* cell = &cells[pos & mask];
+        size_t seq = cell->sequence.load(std::memory_order_acquire);
+
+        if ((intptr_t)seq - (intptr_t)(pos + 1) < 0) {
+            return false;  // empty, or the producer has not finished filling it
+        }
+
+        consume(cell->value);
+        dequeuePos.store(pos + 1, std::memory_order_relaxed);
+        cell->sequence.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate number of queued elements (exact when quiescent)
+    size_t size() const {
+        size_t head = dequeuePos.load(std::memory_order_relaxed);
+        size_t tail = enqueuePos.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+    size_t capacity() const {
+        return mask + 1;
+    }
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    static size_t roundUpPow2(size_t value) {
+        size_t result = 2;
+        while (result < value) result <<= 1;
+        return result;
+    }
+
+    std::unique_ptr<Cell[]> cells;
+    const size_t mask;
+
+    // Keep the producer and consumer cursors on separate cache lines
+    alignas(64) std::atomic<size_t> enqueuePos;
+    alignas(64) std::atomic<size_t> dequeuePos;
+
+    // Disable copying
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+};
@@ -0,0 +1,116 @@
+#pragma once
+
+// Socket portability layer so the transport code builds against Winsock
+// inside the game and against BSD sockets on Linux build boxes.
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+using SocketHandle = SOCKET;
+
+// Flags passed to every send() call
+constexpr int kSocketSendFlags = 0;
+#else
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+
+using SocketHandle = int;
+
+// Flags passed to every send() call (no SIGPIPE when the peer has gone away)
+constexpr int kSocketSendFlags = MSG_NOSIGNAL;
+
+#ifndef INVALID_SOCKET
+#define INVALID_SOCKET (-1)
+#endif
+#ifndef SOCKET_ERROR
+#define SOCKET_ERROR (-1)
+#endif
+
+inline int closesocket(SocketHandle s) {
+    return ::close(s);
+}
+#endif
+
+// Initialize the socket library (WSAStartup on Windows, no-op elsewhere)
+inline bool initSocketLibrary() {
+#ifdef _WIN32
+    static bool initialized = false;
+    if (!initialized) {
+        WSADATA wsaData;
+        initialized = (WSAStartup(MAKEWORD(2, 2), &wsaData) == 0);
+    }
+    return initialized;
+#else
+    return true;
+#endif
+}
+
+// Last socket error code for the calling thread
+inline int lastSocketError() {
+#ifdef _WIN32
+    return WSAGetLastError();
+#else
+    return errno;
+#endif
+}
+
+// True if the error means "try again later" on a non-blocking socket
+inline bool isWouldBlockError(int error) {
+#ifdef _WIN32
+    return error == WSAEWOULDBLOCK;
+#else
+    return error == EAGAIN || error == EWOULDBLOCK;
+#endif
+}
+
+// Switch a socket between blocking and non-blocking mode
+inline bool setSocketNonBlocking(SocketHandle s, bool nonBlocking) {
+#ifdef _WIN32
+    u_long mode = nonBlocking ? 1 : 0;
+    return ioctlsocket(s, FIONBIO, &mode) == 0;
+#else
+    int flags = fcntl(s, F_GETFL, 0);
+    if (flags < 0) return false;
+    flags = nonBlocking ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+    return fcntl(s, F_SETFL, flags) == 0;
+#endif
+}
+
+// Disable Nagle so small state updates leave immediately
+inline void setSocketNoDelay(SocketHandle s) {
+    int flag = 1;
+    setsockopt(s, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&flag), sizeof(flag));
+}
+
+// True if a non-blocking connect() has started and will finish asynchronously
+inline bool isConnectInProgressError(int error) {
+#ifdef _WIN32
+    return error == WSAEWOULDBLOCK;
+#else
+    return error == EINPROGRESS;
+#endif
+}
+
+// Pending error of a socket, e.g. the outcome of a non-blocking connect()
+inline int getSocketError(SocketHandle s) {
+    int error = 0;
+    socklen_t length = sizeof(error);
+    if (getsockopt(s, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &length) != 0) {
+        return lastSocketError();
+    }
+    return error;
+}
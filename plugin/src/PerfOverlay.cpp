@@ -0,0 +1,77 @@
+#include "PerfOverlay.h"
+#include "HookProfiler.h"
+#include "bakkesmod/wrappers/GameWrapper.h"
+#include "bakkesmod/wrappers/canvaswrapper.h"
+#include <cstdio>
+
+static const std::chrono::milliseconds kRefreshInterval(250);
+static const int kRowHeight = 16;
+static const int kLeft = 20;
+static const int kTop = 220;
+static const int kWidth = 560;
+
+PerfOverlay::PerfOverlay(BakkesMod::Plugin::BakkesModPlugin* plugin, HookProfiler& profiler)
+    : bakkesModPlugin(plugin), profiler(profiler), site(nullptr), registered(false), showing(false), lastTotalNs(0) {
+}
+
+void PerfOverlay::show() {
+    if (!bakkesModPlugin || !bakkesModPlugin->gameWrapper) return;
+
+    if (!registered) {
+        site = profiler.addSite(HookSiteKind::drawable, "perf overlay");
+        bakkesModPlugin->gameWrapper->RegisterDrawable(profiler.wrap(site, [this](CanvasWrapper canvas) {
+            draw(canvas);
+        }));
+        registered = true;
+    }
+    refreshedAt = std::chrono::steady_clock::time_point();
+    showing = true;
+}
+
+// Every rendered frame (game thread)
+void PerfOverlay::draw(CanvasWrapper& canvas) {
+    if (!showing) return;
+
+    if (std::chrono::steady_clock::now() - refreshedAt >= kRefreshInterval) {
+        refresh();
+    }
+
+    canvas.SetColor(0, 0, 0, 160);
+    canvas.SetPosition(Vector2{ kLeft - 6, kTop - 6 });
+    canvas.FillBox(Vector2{ kWidth, (int)lines.size() * kRowHeight + 10 });
+
+    canvas.SetColor((char)255, (char)255, (char)255, (char)255);
+    int y = kTop;
+    for (const std::string& line : lines) {
+        canvas.SetPosition(Vector2{ kLeft, y });
+        canvas.DrawString(line, 1.0f, 1.0f);
+        y += kRowHeight;
+    }
+}
+
+// Share of a core over the last refresh interval, then the top sites by
+// total time since load or reset
+void PerfOverlay::refresh() {
+    auto now = std::chrono::steady_clock::now();
+    std::vector<const HookSite*> sorted = profiler.getSitesByTotal();
+    std::uint64_t totalNs = profiler.getTotalNs();
+    double intervalNs = refreshedAt == std::chrono::steady_clock::time_point() ? 0.0
+        : (double)std::chrono::duration_cast<std::chrono::nanoseconds>(now - refreshedAt).count();
+    double share = intervalNs > 0 && totalNs >= lastTotalNs ? 100.0 * (double)(totalNs - lastTotalNs) / intervalNs : 0.0;
+    refreshedAt = now;
+    lastTotalNs = totalNs;
+
+    lines.clear();
+    char line[160];
+    snprintf(line, sizeof(line), "GameStatePlugin  %.3f%% of a core, %zu callsites", share, sorted.size());
+    lines.push_back(line);
+    for (const HookSite* entry : sorted) {
+        if (lines.size() > kMaxRows) break;
+        if (entry->cost.getCount() == 0) continue;
+
+        snprintf(line, sizeof(line), "%-8s %-36.36s p50 %6.1f us  p99 %6.1f us  max %7.1f us",
+                 kHookSiteKindNames[(size_t)entry->kind], shortHookName(entry->name).c_str(),
+                 entry->cost.percentile(0.50) / 1e3, entry->cost.percentile(0.99) / 1e3, entry->cost.getMax() / 1e3);
+        lines.push_back(line);
+    }
+}
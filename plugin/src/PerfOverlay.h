@@ -0,0 +1,45 @@
+#pragma once
+
+#include "bakkesmod/plugin/bakkesmodplugin.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+class CanvasWrapper;
+class HookProfiler;
+struct HookSite;
+
+// gamestate_perf overlay: the plugin's share of a core and its most
+// expensive callsites, drawn on the game canvas. The text is rebuilt four
+// times a second; a frame in between only replays it (a box and a dozen
+// DrawString calls). The drawable is timed like any other callsite.
+class PerfOverlay {
+public:
+    static constexpr size_t kMaxRows = 10;
+
+    PerfOverlay(BakkesMod::Plugin::BakkesModPlugin* plugin, HookProfiler& profiler);
+
+    // The drawable is registered on first show and stays registered until
+    // the plugin unloads (the SDK can only unregister every drawable)
+    void show();
+    void hide() { showing = false; }
+    bool isShowing() const { return showing; }
+
+private:
+    BakkesMod::Plugin::BakkesModPlugin* bakkesModPlugin;
+    HookProfiler& profiler;
+    HookSite* site;
+    bool registered;
+    bool showing;
+
+    std::vector<std::string> lines;
+    std::chrono::steady_clock::time_point refreshedAt;
+    std::uint64_t lastTotalNs;
+
+    void draw(CanvasWrapper& canvas);
+    void refresh();
+
+    // Disable copying
+    PerfOverlay(const PerfOverlay&) = delete;
+    PerfOverlay& operator=(const PerfOverlay&) = delete;
+};
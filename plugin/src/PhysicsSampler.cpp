@@ -0,0 +1,185 @@
+#include "PhysicsSampler.h"
+#include "HookProfiler.h"
+#include "bakkesmod/wrappers/GameWrapper.h"
+#include "bakkesmod/wrappers/GameEvent/ServerWrapper.h"
+#include "bakkesmod/wrappers/GameObject/BallWrapper.h"
+#include "bakkesmod/wrappers/GameObject/CarWrapper.h"
+#include "bakkesmod/wrappers/GameObject/CarComponent/BoostWrapper.h"
+#include "bakkesmod/wrappers/GameObject/PriWrapper.h"
+#include <chrono>
+#include <sstream>
+
+// Fires once per car per physics tick, before the car's input is applied
+static const char* kPhysicsTickEvent = "Function TAGame.Car_TA.SetVehicleInput";
+
+// Rocket League physics rate
+static const int kPhysicsTicksPerSecond = 120;
+
+static void toTelemetryBody(const RBState& state, TelemetryBody& body) {
+    body.location[0] = state.Location.X;
+    body.location[1] = state.Location.Y;
+    body.location[2] = state.Location.Z;
+    body.velocity[0] = state.LinearVelocity.X;
+    body.velocity[1] = state.LinearVelocity.Y;
+    body.velocity[2] = state.LinearVelocity.Z;
+    body.angularVelocity[0] = state.AngularVelocity.X;
+    body.angularVelocity[1] = state.AngularVelocity.Y;
+    body.angularVelocity[2] = state.AngularVelocity.Z;
+    body.quaternion[0] = state.Quaternion.W;
+    body.quaternion[1] = state.Quaternion.X;
+    body.quaternion[2] = state.Quaternion.Y;
+    body.quaternion[3] = state.Quaternion.Z;
+}
+
+std::uint32_t parseTelemetryEntities(const std::string& list) {
+    std::uint32_t bits = 0;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (item == "ball") {
+            bits |= kTelemetryEntityBall;
+        } else if (item == "cars") {
+            bits |= kTelemetryEntityCars;
+        } else if (item == "local") {
+            bits |= kTelemetryEntityLocalCar;
+        } else if (item == "all") {
+            bits |= kTelemetryEntityBall | kTelemetryEntityCars;
+        }
+    }
+    return bits;
+}
+
+PhysicsSampler::PhysicsSampler(BakkesMod::Plugin::BakkesModPlugin* plugin, HookProfiler& profiler, size_t capacityFrames)
+    : bakkesModPlugin(plugin), profiler(profiler), ring(std::make_unique<TelemetryRing>(capacityFrames)),
+      hooked(false), running(false), framesPerSample(1),
+      entities(kTelemetryEntityBall | kTelemetryEntityCars),
+      lastPhysicsFrame(-1), lastSampledFrame(-1), carsDropped(0) {
+}
+
+PhysicsSampler::~PhysicsSampler() {
+    stop();
+}
+
+void PhysicsSampler::setRateHz(int rateHz) {
+    framesPerSample = (rateHz <= 0 || rateHz >= kPhysicsTicksPerSecond)
+        ? 1 : (kPhysicsTicksPerSecond + rateHz / 2) / rateHz;
+}
+
+void PhysicsSampler::setEntities(std::uint32_t entityBits) {
+    entities = entityBits;
+}
+
+void PhysicsSampler::start() {
+    if (!bakkesModPlugin || !bakkesModPlugin->gameWrapper) return;
+
+    // Hooks live until the plugin unloads; stop() only mutes this one
+    if (!hooked) {
+        bakkesModPlugin->gameWrapper->HookEventWithCaller<CarWrapper>(kPhysicsTickEvent,
+            profiler.wrapHook(kPhysicsTickEvent, [this](CarWrapper car, void* params, std::string eventName) {
+                onPhysicsTick(car);
+            }));
+        hooked = true;
+    }
+
+    lastPhysicsFrame = -1;
+    lastSampledFrame = -1;
+    running = true;
+}
+
+void PhysicsSampler::stop() {
+    running = false;
+}
+
+// Per car, per physics tick (game thread)
+void PhysicsSampler::onPhysicsTick(CarWrapper& caller) {
+    if (!running || caller.IsNull()) return;
+
+    // Only the first car of each physics tick counts
+    int physicsFrame = caller.GetPhysicsFrame();
+    if (physicsFrame == lastPhysicsFrame) return;
+    lastPhysicsFrame = physicsFrame;
+
+    // Decimate to the configured rate; frame numbers restart with each match
+    if (lastSampledFrame >= 0 && physicsFrame > lastSampledFrame &&
+        physicsFrame - lastSampledFrame < framesPerSample) {
+        return;
+    }
+
+    auto gameWrapper = bakkesModPlugin->gameWrapper;
+    ServerWrapper server = gameWrapper->IsInOnlineGame() ? gameWrapper->GetOnlineGame()
+                                                         : gameWrapper->GetGameEventAsServer();
+    if (server.IsNull()) return;
+
+    lastSampledFrame = physicsFrame;
+    sample(server, physicsFrame);
+}
+
+// Capture one frame of the selected entities into the ring
+void PhysicsSampler::sample(ServerWrapper& server, int physicsFrame) {
+    auto start = std::chrono::steady_clock::now();
+
+    // The ball's clock stamps the frame even when the ball is filtered out
+    BallWrapper ball = server.GetBall();
+    RBState ballState = {};
+    if (!ball.IsNull()) {
+        ballState = ball.GetRBState();
+    }
+
+    ring->beginFrame((std::uint64_t)physicsFrame, ballState.Time);
+
+    TelemetryBody body;
+    if ((entities & kTelemetryEntityBall) && !ball.IsNull()) {
+        toTelemetryBody(ballState, body);
+        ring->setEntity(kTelemetryBall, body, 0.0f, ballState.bSleeping ? kTelemetrySleeping : 0, 0);
+    }
+
+    if (entities & (kTelemetryEntityCars | kTelemetryEntityLocalCar)) {
+        // Slots follow the server's car order; the id column tells which
+        // player a slot holds when that order changes
+        bool localOnly = (entities & kTelemetryEntityCars) == 0;
+        std::uintptr_t localCar = localOnly ? bakkesModPlugin->gameWrapper->GetLocalCar().memory_address : 0;
+
+        ArrayWrapper<CarWrapper> cars = server.GetCars();
+        size_t slot = 1;
+        for (int i = 0; i < cars.Count(); ++i) {
+            CarWrapper car = cars.Get(i);
+            if (car.IsNull() || (localOnly && car.memory_address != localCar)) continue;
+            if (slot > kTelemetryMaxCars) {
+                ++carsDropped;
+                continue;
+            }
+
+            RBState carState = car.GetRBState();
+            toTelemetryBody(carState, body);
+
+            BoostWrapper boostComponent = car.GetBoostComponent();
+            float boost = boostComponent.IsNull() ? 0.0f : boostComponent.GetCurrentBoostAmount() * 100.0f;
+
+            std::uint8_t flags = 0;
+            if (car.IsOnGround()) flags |= kTelemetryOnGround;
+            if (carState.bSleeping) flags |= kTelemetrySleeping;
+
+            PriWrapper pri = car.GetPRI();
+            std::uint32_t id = pri.IsNull() ? 0 : (std::uint32_t)pri.GetPlayerID();
+
+            ring->setEntity(slot++, body, boost, flags, id);
+        }
+    }
+
+    ring->commitFrame();
+
+    sampleCost.record((std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+void PhysicsSampler::logStats() {
+    auto cvarManager = bakkesModPlugin->cvarManager;
+    cvarManager->log(std::string("Telemetry ") + (running ? "running" : "stopped") +
+                     ", frames " + std::to_string(ring->getFrameCount()) +
+                     " (ring of " + std::to_string(ring->getCapacity()) +
+                     "), every " + std::to_string(framesPerSample) + " physics ticks");
+    cvarManager->log("Sample cost: p50 " + std::to_string(sampleCost.percentile(0.50)) +
+                     " ns, p99 " + std::to_string(sampleCost.percentile(0.99)) +
+                     " ns, max " + std::to_string(sampleCost.getMax()) +
+                     " ns; cars over the slot limit " + std::to_string(carsDropped));
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "bakkesmod/plugin/bakkesmodplugin.h"
+#include "TelemetryRing.h"
+#include "LatencyHistogram.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+class CarWrapper;
+class ServerWrapper;
+class HookProfiler;
+
+// Which entities the sampler captures (telemetry_entities)
+constexpr std::uint32_t kTelemetryEntityBall = 1u << 0;
+constexpr std::uint32_t kTelemetryEntityCars = 1u << 1;
+constexpr std::uint32_t kTelemetryEntityLocalCar = 1u << 2;    // only the local player's car
+
+// Parse "ball,cars", "ball,local", "all", ... into kTelemetryEntity* bits
+std::uint32_t parseTelemetryEntities(const std::string& list);
+
+// Captures ball and car physics into a TelemetryRing on the game thread.
+// Driven by the per-car vehicle input event, which fires once per car per
+// physics tick (120 Hz); the physics frame number collapses those into one
+// sample per tick.
+class PhysicsSampler {
+public:
+    // The physics tick hook is timed into `profiler`
+    PhysicsSampler(BakkesMod::Plugin::BakkesModPlugin* plugin, HookProfiler& profiler, size_t capacityFrames);
+    ~PhysicsSampler();
+
+    // rateHz of 0 (or >= 120) samples every physics tick
+    void setRateHz(int rateHz);
+    void setEntities(std::uint32_t entityBits);
+
+    // Hook the physics tick; sampling pauses outside matches
+    void start();
+    void stop();
+    bool isRunning() const { return running; }
+
+    const TelemetryRing& getRing() const { return *ring; }
+
+    // gamestate_telemetry: frames, rate and per-sample cost
+    void logStats();
+
+private:
+    BakkesMod::Plugin::BakkesModPlugin* bakkesModPlugin;
+    HookProfiler& profiler;
+    std::unique_ptr<TelemetryRing> ring;
+
+    bool hooked;
+    bool running;
+    int framesPerSample;
+    std::uint32_t entities;
+    int lastPhysicsFrame;
+    int lastSampledFrame;
+
+    // Sample cost in nanoseconds
+    LatencyHistogram sampleCost;
+    std::uint64_t carsDropped;      // cars beyond kTelemetryMaxCars
+
+    void onPhysicsTick(CarWrapper& caller);
+    void sample(ServerWrapper& server, int physicsFrame);
+
+    // Disable copying
+    PhysicsSampler(const PhysicsSampler&) = delete;
+    PhysicsSampler& operator=(const PhysicsSampler&) = delete;
+};
@@ -0,0 +1,203 @@
+#include "ProbeTrace.h"
+#include "WireProtocol.h"
+#include <cstdio>
+#include <cstring>
+
+// Reading flag bits; the first byte is MatchPhaseInputs order
+enum : std::uint8_t {
+    kReadingInGame = 1 << 0,
+    kReadingInMatch = 1 << 1,
+    kReadingInReplay = 1 << 2,
+    kReadingPaused = 1 << 3,
+    kReadingMatchEnded = 1 << 4,
+    kReadingRoundActive = 1 << 5,
+    kReadingBallHit = 1 << 6,
+    kReadingOvertime = 1 << 7
+};
+
+enum : std::uint8_t {
+    kReadingMatchOvertime = 1 << 0
+};
+
+static std::uint64_t zigzag(std::int64_t value) {
+    return ((std::uint64_t)value << 1) ^ (std::uint64_t)(value >> 63);
+}
+
+static std::int64_t unzigzag(std::uint64_t value) {
+    return (std::int64_t)(value >> 1) ^ -(std::int64_t)(value & 1);
+}
+
+static bool readVarint(const char* data, size_t length, size_t& pos, std::uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos >= length) return false;
+        std::uint8_t byte = (std::uint8_t)data[pos++];
+        value |= (std::uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+ProbeTraceRecorder::ProbeTraceRecorder(GameProbe& inner, std::int64_t startedAtMs)
+    : inner(inner), hasReading(false), lastTickMs(0), ticks(0) {
+    data.reserve(1 << 20);
+
+    ProbeTraceHeader header = {};
+    header.magic = kProbeTraceMagic;
+    header.version = kProbeTraceVersion;
+    header.startedAtMs = startedAtMs;
+    data.resize(sizeof(header));
+    std::memcpy(data.data(), &header, sizeof(header));
+}
+
+GameReading ProbeTraceRecorder::read() {
+    GameReading reading = inner.read();
+    if (hasReading && reading == lastReading) {
+        return reading;
+    }
+    lastReading = reading;
+    hasReading = true;
+
+    const MatchPhaseInputs& in = reading.phaseInputs;
+    char payload[2 + 4 * 10];
+    payload[0] = (char)((reading.inGame ? kReadingInGame : 0) | (in.inMatch ? kReadingInMatch : 0) |
+                        (in.inReplay ? kReadingInReplay : 0) | (in.paused ? kReadingPaused : 0) |
+                        (in.matchEnded ? kReadingMatchEnded : 0) | (in.roundActive ? kReadingRoundActive : 0) |
+                        (in.ballHasBeenHit ? kReadingBallHit : 0) | (in.overtime ? kReadingOvertime : 0));
+    payload[1] = (char)(reading.match.overtime ? kReadingMatchOvertime : 0);
+    size_t length = 2;
+    length += writeVarint(payload + length, zigzag(in.waitTimeRemaining));
+    length += writeVarint(payload + length, zigzag(reading.match.blueScore));
+    length += writeVarint(payload + length, zigzag(reading.match.orangeScore));
+    length += writeVarint(payload + length, zigzag(reading.match.secondsRemaining));
+    append(ProbeTraceRecord::reading, payload, length);
+    return reading;
+}
+
+void ProbeTraceRecorder::beginTick(std::int64_t nowMs) {
+    char payload[10];
+    std::int64_t elapsed = ticks == 0 ? 0 : nowMs - lastTickMs;
+    lastTickMs = nowMs;
+    ++ticks;
+    append(ProbeTraceRecord::tick, payload, writeVarint(payload, (std::uint64_t)(elapsed > 0 ? elapsed : 0)));
+    read();
+}
+
+void ProbeTraceRecorder::recordEvent(GameEvent event, int value) {
+    char payload[1 + 10];
+    payload[0] = (char)event;
+    append(ProbeTraceRecord::event, payload, 1 + writeVarint(payload + 1, zigzag(value)));
+}
+
+void ProbeTraceRecorder::append(ProbeTraceRecord record, const char* payload, size_t length) {
+    data.push_back((char)record);
+    data.insert(data.end(), payload, payload + length);
+}
+
+bool ProbeTraceRecorder::save(const std::string& path) const {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    bool written = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+    return std::fclose(file) == 0 && written;
+}
+
+bool ProbeTrace::load(const std::string& path, std::string& error) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    std::vector<char> bytes;
+    char buffer[1 << 16];
+    size_t got;
+    while ((got = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        bytes.insert(bytes.end(), buffer, buffer + got);
+    }
+    std::fclose(file);
+
+    return parse(bytes.data(), bytes.size(), error);
+}
+
+bool ProbeTrace::parse(const char* bytes, size_t length, std::string& error) {
+    steps.clear();
+    readings.clear();
+    ticks = 0;
+    durationMs = 0;
+
+    ProbeTraceHeader header;
+    if (length < sizeof(header)) {
+        error = "truncated header";
+        return false;
+    }
+    std::memcpy(&header, bytes, sizeof(header));
+    if (header.magic != kProbeTraceMagic || header.version != kProbeTraceVersion) {
+        error = "not a probe trace (or a newer version)";
+        return false;
+    }
+    startedAtMs = header.startedAtMs;
+
+    size_t pos = sizeof(header);
+    while (pos < length) {
+        ProbeTraceRecord record = (ProbeTraceRecord)(std::uint8_t)bytes[pos++];
+        std::uint64_t a = 0;
+        Step step = {};
+        step.record = record;
+
+        if (record == ProbeTraceRecord::tick) {
+            if (!readVarint(bytes, length, pos, a)) break;
+            step.value = (std::int32_t)a;
+            durationMs += (std::int64_t)a;
+            ++ticks;
+        } else if (record == ProbeTraceRecord::reading) {
+            if (pos + 2 > length) break;
+            std::uint8_t flags = (std::uint8_t)bytes[pos];
+            std::uint8_t matchFlags = (std::uint8_t)bytes[pos + 1];
+            pos += 2;
+
+            std::uint64_t wait, blue, orange, seconds;
+            if (!readVarint(bytes, length, pos, wait) || !readVarint(bytes, length, pos, blue) ||
+                !readVarint(bytes, length, pos, orange) || !readVarint(bytes, length, pos, seconds)) {
+                break;
+            }
+
+            GameReading reading;
+            MatchPhaseInputs& in = reading.phaseInputs;
+            reading.inGame = (flags & kReadingInGame) != 0;
+            in.inMatch = (flags & kReadingInMatch) != 0;
+            in.inReplay = (flags & kReadingInReplay) != 0;
+            in.paused = (flags & kReadingPaused) != 0;
+            in.matchEnded = (flags & kReadingMatchEnded) != 0;
+            in.roundActive = (flags & kReadingRoundActive) != 0;
+            in.ballHasBeenHit = (flags & kReadingBallHit) != 0;
+            in.overtime = (flags & kReadingOvertime) != 0;
+            in.waitTimeRemaining = (int)unzigzag(wait);
+            reading.match.overtime = (matchFlags & kReadingMatchOvertime) != 0;
+            reading.match.blueScore = (int)unzigzag(blue);
+            reading.match.orangeScore = (int)unzigzag(orange);
+            reading.match.secondsRemaining = (int)unzigzag(seconds);
+
+            step.value = (std::int32_t)readings.size();
+            readings.push_back(reading);
+        } else if (record == ProbeTraceRecord::event) {
+            if (pos >= length) break;
+            std::uint8_t event = (std::uint8_t)bytes[pos++];
+            if (event >= (std::uint8_t)GameEvent::count || !readVarint(bytes, length, pos, a)) {
+                error = "unknown event id " + std::to_string(event);
+                return false;
+            }
+            step.event = (GameEvent)event;
+            step.value = (std::int32_t)unzigzag(a);
+        } else {
+            error = "bad record tag at byte " + std::to_string(pos - 1);
+            return false;
+        }
+
+        steps.push_back(step);
+    }
+
+    // A trace cut off mid-record (crash while saving) replays up to the cut
+    return true;
+}
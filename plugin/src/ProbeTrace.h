@@ -0,0 +1,108 @@
+#pragma once
+
+#include "GameProbe.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Probe trace: what GameStateDetector read from the game on every tick,
+// and which engine events fired, so detection can be replayed offline
+// (tools/detector_replay.cpp). The file is a ProbeTraceHeader followed by
+// records, each starting with a ProbeTraceRecord tag byte:
+//
+//   tick      varint ms since the previous tick
+//   reading   GameReading: two flag bytes, then zigzag varints of the wait
+//             time, blue score, orange score and seconds remaining
+//   event     GameEvent id byte, zigzag varint value
+//
+// Readings are written only when they change. The recorder reads the game
+// at the start of every tick and writes events after the detector has
+// handled them, so on replay every reading comes before the code that
+// read it. About 2 bytes per tick.
+
+constexpr std::uint32_t kProbeTraceMagic = 0x54505347;     // "GSPT"
+constexpr std::uint16_t kProbeTraceVersion = 1;
+
+enum class ProbeTraceRecord : std::uint8_t {
+    tick = 1,
+    reading = 2,
+    event = 3
+};
+
+#pragma pack(push, 1)
+struct ProbeTraceHeader {
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t reserved;
+    std::int64_t startedAtMs;       // Unix ms
+};
+#pragma pack(pop)
+
+static_assert(sizeof(ProbeTraceHeader) == 16, "trace header layout is part of the file format");
+
+// Wraps the real probe and records every reading and event (game thread).
+// The trace is kept in memory (a few hundred KB per hour of play) and
+// written by save(), so recording never touches the disk mid-game.
+class ProbeTraceRecorder : public GameProbe {
+public:
+    ProbeTraceRecorder(GameProbe& inner, std::int64_t startedAtMs);
+
+    // Reads the wrapped probe; records the reading if it changed
+    GameReading read() override;
+
+    // Start of a viewport tick (steady ms): records the tick and a reading
+    void beginTick(std::int64_t nowMs);
+    // After the detector has handled the event
+    void recordEvent(GameEvent event, int value);
+
+    std::uint64_t getTickCount() const { return ticks; }
+    size_t getByteCount() const { return data.size(); }
+    bool save(const std::string& path) const;
+
+private:
+    GameProbe& inner;
+    std::vector<char> data;
+    GameReading lastReading;
+    bool hasReading;
+    std::int64_t lastTickMs;
+    std::uint64_t ticks;
+
+    void append(ProbeTraceRecord record, const char* payload, size_t length);
+};
+
+// A trace decoded for replay: one step per record, readings kept apart
+class ProbeTrace {
+public:
+    struct Step {
+        ProbeTraceRecord record;
+        GameEvent event;            // record == event
+        std::int32_t value;         // tick: ms since the previous tick; reading: index; event: value
+    };
+
+    bool load(const std::string& path, std::string& error);
+    bool parse(const char* bytes, size_t length, std::string& error);
+
+    std::int64_t getStartedAtMs() const { return startedAtMs; }
+    std::uint64_t getTickCount() const { return ticks; }
+    std::int64_t getDurationMs() const { return durationMs; }
+    const std::vector<Step>& getSteps() const { return steps; }
+    const GameReading& getReading(std::int32_t index) const { return readings[(size_t)index]; }
+
+private:
+    std::int64_t startedAtMs = 0;
+    std::uint64_t ticks = 0;
+    std::int64_t durationMs = 0;
+    std::vector<Step> steps;
+    std::vector<GameReading> readings;
+};
+
+// Serves the reading the replay last stepped over
+class TraceProbe : public GameProbe {
+public:
+    GameReading read() override { return current; }
+    void set(const GameReading& reading) { current = reading; }
+
+private:
+    GameReading current;
+};
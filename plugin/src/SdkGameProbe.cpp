@@ -0,0 +1,204 @@
+#include "SdkGameProbe.h"
+#include "GameStateDetector.h"
+#include "TickDispatcher.h"
+#include "HookProfiler.h"
+#include "Clock.h"
+#include "bakkesmod/wrappers/GameWrapper.h"
+#include "bakkesmod/wrappers/GameEvent/ServerWrapper.h"
+#include "bakkesmod/wrappers/GameEvent/ReplayWrapper.h"
+#include "bakkesmod/wrappers/GameObject/CameraWrapper.h"
+#include "bakkesmod/wrappers/GameObject/TeamWrapper.h"
+#include "bakkesmod/plugin/bakkesmodsdk.h"
+#include "utils/parser.h"
+#include "Logger.h"
+#include <vector>
+
+// Engine events behind DetectionMode::eventHooks. Transitions these miss
+// (renamed functions, modes that skip them) are picked up by the
+// reconciliation probe and counted as missed transitions.
+static const char* kCountdownBeginEvent = "Function GameEvent_Soccar_TA.Countdown.BeginState";
+static const char* kMatchEndedEvent = "Function TAGame.GameEvent_Soccar_TA.EventMatchEnded";
+static const char* kMatchDestroyedEvent = "Function TAGame.GameEvent_Soccar_TA.Destroyed";
+static const char* kReplayBeginEvent = "Function GameEvent_Soccar_TA.ReplayPlayback.BeginState";
+static const char* kReplayEndEvent = "Function GameEvent_Soccar_TA.ReplayPlayback.EndState";
+static const char* kPauseEvent = "Function ProjectX.GFxShell_X.SetGamePaused";
+static const char* kPreLoadMapEvent = "Function ProjectX.EngineShare_X.EventPreLoadMap";
+static const char* kPostLoadMapEvent = "Function TAGame.LoadingScreen_TA.HandlePostLoadMap";
+
+// The game event of the current match, online or local
+static ServerWrapper getActiveServer(GameWrapper& gameWrapper) {
+    return gameWrapper.IsInOnlineGame() ? gameWrapper.GetOnlineGame() : gameWrapper.GetGameEventAsServer();
+}
+
+SdkGameProbe::SdkGameProbe(BakkesMod::Plugin::BakkesModPlugin* plugin, const Clock& clock, HookProfiler& profiler)
+    : bakkesModPlugin(plugin), clock(clock), profiler(profiler), detector(nullptr) {
+}
+
+SdkGameProbe::~SdkGameProbe() = default;
+
+// Read everything the detector needs from the game in one pass (game thread)
+GameReading SdkGameProbe::read() {
+    GameReading reading;
+    if (!bakkesModPlugin || !bakkesModPlugin->gameWrapper) {
+        GS_LOG_ERROR("SdkGameProbe: No game wrapper!");
+        return reading;
+    }
+
+    auto gameWrapper = bakkesModPlugin->gameWrapper;
+    MatchPhaseInputs& in = reading.phaseInputs;
+    reading.inGame = gameWrapper->IsInGame();
+    in.inReplay = gameWrapper->IsInReplay();
+    if (!reading.inGame && !gameWrapper->IsInOnlineGame()) return reading;
+
+    ServerWrapper server = getActiveServer(*gameWrapper);
+    if (server.IsNull()) return reading;
+
+    in.inMatch = true;
+    in.matchEnded = server.GetbMatchEnded() != 0;
+    in.roundActive = server.GetbRoundActive() != 0;
+    in.ballHasBeenHit = server.GetbBallHasBeenHit() != 0;
+    in.overtime = server.GetbOverTime() != 0;
+    in.waitTimeRemaining = server.GetWaitTimeRemaining();
+    // Game speed of 0 typically indicates paused state
+    in.paused = server.GetGameSpeed() == 0.0f;
+
+    MatchInfo& match = reading.match;
+    match.secondsRemaining = server.GetSecondsRemaining();
+    match.overtime = in.overtime;
+
+    ArrayWrapper<TeamWrapper> teams = server.GetTeams();
+    for (int i = 0; i < teams.Count(); ++i) {
+        TeamWrapper team = teams.Get(i);
+        if (team.IsNull()) continue;
+        if (team.GetTeamNum() == 0) {
+            match.blueScore = team.GetScore();
+        } else if (team.GetTeamNum() == 1) {
+            match.orangeScore = team.GetScore();
+        }
+    }
+
+    return reading;
+}
+
+void SdkGameProbe::installHooks(GameStateDetector& target, TickDispatcher& ticks) {
+    if (!bakkesModPlugin) return;
+    detector = &target;
+
+    auto gameWrapper = bakkesModPlugin->gameWrapper;
+    auto cvarManager = bakkesModPlugin->cvarManager;
+
+    GS_LOG_DEBUG("SdkGameProbe: Setting up detector hooks...");
+
+    // Viewport tick: sampler and reconciliation probe. Every tick, since
+    // the detector counts ticks itself and traces replay tick by tick.
+    ticks.subscribe("detector", TickCadence::everyTick(), TickPriority::critical, [this]() {
+        onTick();
+    });
+
+    // Kickoff countdown: a match (or a new round of one) is live
+    gameWrapper->HookEvent(kCountdownBeginEvent, profiler.wrapHook(kCountdownBeginEvent, [this](std::string eventName) {
+        dispatch(GameEvent::countdownBegin);
+    }));
+
+    // Podium reached, or the match torn down when leaving it
+    gameWrapper->HookEvent(kMatchEndedEvent, profiler.wrapHook(kMatchEndedEvent, [this](std::string eventName) {
+        dispatch(GameEvent::matchEnded);
+    }));
+    gameWrapper->HookEvent(kMatchDestroyedEvent, profiler.wrapHook(kMatchDestroyedEvent, [this](std::string eventName) {
+        dispatch(GameEvent::matchDestroyed);
+    }));
+
+    // Goal replays; the server's ReplayDirector confirms one is playing
+    gameWrapper->HookEventWithCaller<ServerWrapper>(kReplayBeginEvent,
+        profiler.wrapHook(kReplayBeginEvent, [this](ServerWrapper server, void* params, std::string eventName) {
+            bool confirmed = !server.IsNull() && !server.GetReplayDirector().IsNull();
+            dispatch(GameEvent::replayBegin, confirmed ? 1 : 0);
+        }));
+    gameWrapper->HookEvent(kReplayEndEvent, profiler.wrapHook(kReplayEndEvent, [this](std::string eventName) {
+        dispatch(GameEvent::replayEnd);
+    }));
+
+    // Pause menu opened or closed
+    gameWrapper->HookEventPost(kPauseEvent, profiler.wrapHook(kPauseEvent, [this](std::string eventName) {
+        dispatch(GameEvent::pauseToggled);
+    }));
+
+    // Map loads (menu <-> arena, replay viewer)
+    gameWrapper->HookEvent(kPreLoadMapEvent, profiler.wrapHook(kPreLoadMapEvent, [this](std::string eventName) {
+        dispatch(GameEvent::preLoadMap);
+    }));
+    gameWrapper->HookEventPost(kPostLoadMapEvent, profiler.wrapHook(kPostLoadMapEvent, [this](std::string eventName) {
+        dispatch(GameEvent::postLoadMap);
+    }));
+
+    // Console commands for testing the detector by hand
+    cvarManager->registerNotifier("GameState_MatchStarted",
+        profiler.wrapCommand("GameState_MatchStarted", [this](std::vector<std::string> params) {
+            GS_LOG_DEBUG("SdkGameProbe: Match started event triggered!");
+            dispatch(GameEvent::matchStartedCommand);
+        }), "", PERMISSION_ALL);
+    cvarManager->registerNotifier("GameState_MatchEnded",
+        profiler.wrapCommand("GameState_MatchEnded", [this](std::vector<std::string> params) {
+            GS_LOG_DEBUG("SdkGameProbe: Match ended event triggered!");
+            dispatch(GameEvent::matchEndedCommand);
+        }), "", PERMISSION_ALL);
+    cvarManager->registerNotifier("GameState_ReplayStarted",
+        profiler.wrapCommand("GameState_ReplayStarted", [this](std::vector<std::string> params) {
+            dispatch(GameEvent::replayStartedCommand);
+        }), "", PERMISSION_ALL);
+    cvarManager->registerNotifier("GameState_ReplayEnded",
+        profiler.wrapCommand("GameState_ReplayEnded", [this](std::vector<std::string> params) {
+            dispatch(GameEvent::replayEndedCommand);
+        }), "", PERMISSION_ALL);
+    cvarManager->registerNotifier("GameState_PauseChanged",
+        profiler.wrapCommand("GameState_PauseChanged", [this](std::vector<std::string> params) {
+            if (!params.empty()) {
+                dispatch(GameEvent::pauseCommand, params[0] == "1" ? 1 : 0);
+            }
+        }), "", PERMISSION_ALL);
+    cvarManager->registerNotifier("gamestate_detect",
+        profiler.wrapCommand("gamestate_detect", [this](std::vector<std::string> params) {
+            GS_LOG_INFO("SdkGameProbe: Manual state detection triggered!");
+            dispatch(GameEvent::detectCommand);
+        }), "Manually trigger game state detection", PERMISSION_ALL);
+
+    // Per-frame hook cost, to compare detection modes in game
+    cvarManager->registerNotifier("gamestate_hook_cost",
+        profiler.wrapCommand("gamestate_hook_cost", [this](std::vector<std::string> params) {
+            for (const std::string& line : detector->describeHookCost()) {
+                bakkesModPlugin->cvarManager->log(line);
+            }
+        }), "Show the per-frame cost of the state detection tick hook", PERMISSION_ALL);
+
+    GS_LOG_DEBUG("SdkGameProbe: Detector hooks setup completed");
+}
+
+void SdkGameProbe::onTick() {
+    if (recorder) {
+        recorder->beginTick(clock.now().count());
+    }
+    detector->onTick();
+}
+
+// Events are recorded after the detector has handled them, behind any
+// reading the handler took
+void SdkGameProbe::dispatch(GameEvent event, int value) {
+    detector->onGameEvent(event, value);
+    if (recorder) {
+        recorder->recordEvent(event, value);
+    }
+}
+
+void SdkGameProbe::startTrace(std::int64_t startedAtMs) {
+    if (!detector || recorder) return;
+    recorder = std::make_unique<ProbeTraceRecorder>(*this, startedAtMs);
+    detector->setProbe(recorder.get());
+}
+
+bool SdkGameProbe::stopTrace(const std::string& path) {
+    if (!recorder) return false;
+    detector->setProbe(this);
+    bool saved = recorder->save(path);
+    recorder.reset();
+    return saved;
+}
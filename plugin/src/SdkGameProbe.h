@@ -0,0 +1,52 @@
+#pragma once
+
+#include "bakkesmod/plugin/bakkesmodplugin.h"
+#include "GameProbe.h"
+#include "ProbeTrace.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+class Clock;
+class HookProfiler;
+class GameStateDetector;
+class TickDispatcher;
+
+// The BakkesMod side of GameStateDetector: reads the game through the SDK
+// and forwards engine events and console commands to the detector. While
+// a trace is running (gamestate_trace), the detector reads through a
+// ProbeTraceRecorder and every tick and event is recorded for replay.
+// Must outlive the detector it drives.
+class SdkGameProbe : public GameProbe {
+public:
+    // Hooks and commands are timed into `profiler`
+    SdkGameProbe(BakkesMod::Plugin::BakkesModPlugin* plugin, const Clock& clock, HookProfiler& profiler);
+    ~SdkGameProbe();
+
+    // One SDK pass (game thread)
+    GameReading read() override;
+
+    // Register the engine hooks and console commands that drive the
+    // detector; its tick runs from the plugin's dispatcher
+    void installHooks(GameStateDetector& detector, TickDispatcher& ticks);
+
+    // Probe trace recording (game thread)
+    bool isTracing() const { return recorder != nullptr; }
+    void startTrace(std::int64_t startedAtMs);
+    // Write the trace to `path` and stop recording; false if the write failed
+    bool stopTrace(const std::string& path);
+
+private:
+    BakkesMod::Plugin::BakkesModPlugin* bakkesModPlugin;
+    const Clock& clock;
+    HookProfiler& profiler;
+    GameStateDetector* detector;
+    std::unique_ptr<ProbeTraceRecorder> recorder;
+
+    void onTick();
+    void dispatch(GameEvent event, int value = 0);
+
+    // Disable copying
+    SdkGameProbe(const SdkGameProbe&) = delete;
+    SdkGameProbe& operator=(const SdkGameProbe&) = delete;
+};
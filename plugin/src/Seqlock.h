@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// In-process seqlock around one trivially copyable value: a single writer
+// publishes, any number of threads copy the latest value out without locks
+// and without ever blocking the writer. Same scheme as the state board
+// (StateBoard.h): the value is stored as relaxed atomic 64-bit words and a
+// read that overlapped a store is retried.
+template <typename T>
+class Seqlock {
+public:
+    static_assert(std::is_trivially_copyable<T>::value, "value is copied word by word");
+
+    Seqlock() : sequence(0) {
+        for (auto& word : words) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Writer side; single writer only
+    void store(const T& value) {
+        std::uint64_t source[kWords] = {};
+        std::memcpy(source, &value, sizeof(T));
+
+        std::uint64_t current = sequence.load(std::memory_order_relaxed);
+        sequence.store(current + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < kWords; ++i) {
+            words[i].store(source[i], std::memory_order_relaxed);
+        }
+
+        sequence.store(current + 2, std::memory_order_release);
+    }
+
+    // One read attempt; false if the writer was mid-update
+    bool tryLoad(T& value) const {
+        std::uint64_t before = sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            return false;
+        }
+
+        std::uint64_t copy[kWords];
+        for (size_t i = 0; i < kWords; ++i) {
+            copy[i] = words[i].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) != before) {
+            return false;
+        }
+
+        std::memcpy(&value, copy, sizeof(T));
+        return true;
+    }
+
+    // Copy the latest value, retrying until a store is not in the way.
+    // Stores are short, so this spins for a few iterations at most.
+    T load() const {
+        T value;
+        while (!tryLoad(value)) {
+        }
+        return value;
+    }
+
+    // Number of stores so far
+    std::uint64_t getVersion() const {
+        return sequence.load(std::memory_order_acquire) / 2;
+    }
+
+private:
+    static constexpr size_t kWords = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    alignas(64) std::atomic<std::uint64_t> sequence;
+    std::atomic<std::uint64_t> words[kWords];
+
+    // Disable copying
+    Seqlock(const Seqlock&) = delete;
+    Seqlock& operator=(const Seqlock&) = delete;
+};
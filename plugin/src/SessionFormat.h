@@ -0,0 +1,114 @@
+#pragma once
+
+#include "TelemetryCodec.h"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// On-disk layout of a session recording (.gsr): telemetry frames and state
+// events, stored column by column in self-contained chunks so the recorder
+// only ever appends and a reader can map the file and jump to any time.
+//
+//   SessionFileHeader
+//   chunk*:   SessionChunkHeader, then blockCount blocks of
+//             SessionBlockHeader + byteLength bytes of encoded column
+//   footer:   SessionChunkIndex per chunk
+//   SessionTrailer (last 16 bytes)
+//
+// A file cut short (game crash) has no footer; readers then walk the chunk
+// headers from the start instead.
+//
+// Columns hold integers, encoded as zigzag varint deltas against the
+// previous row (the first against 0). Telemetry is stored quantized with
+// the TelemetryCodec scales; entities absent from a whole chunk have no
+// columns in it. All fields are little-endian.
+
+constexpr std::uint32_t kSessionFileMagic = 0x52534747;     // "GGSR"
+constexpr std::uint32_t kSessionChunkMagic = 0x4B4E4843;    // "CHNK"
+constexpr std::uint32_t kSessionFooterMagic = 0x52544F46;   // "FOTR"
+constexpr std::uint32_t kSessionVersion = 1;
+
+// Frames per chunk (about 8.5 s at 120 Hz); chunks also close after
+// kSessionChunkMaxAgeMs so events without telemetry still reach the disk
+constexpr size_t kSessionChunkFrames = 1024;
+constexpr std::int64_t kSessionChunkMaxAgeMs = 10000;
+
+// Column ids
+constexpr std::uint16_t kSessionFrameTimeColumn = 0;       // Unix ms of each frame
+constexpr std::uint16_t kSessionPhysicsFrameColumn = 1;
+constexpr std::uint16_t kSessionPresentColumn = 2;         // entity bit mask per frame
+constexpr std::uint16_t kSessionEventTimeColumn = 8;       // Unix ms of each event
+constexpr std::uint16_t kSessionEventKindColumn = 9;       // SessionEventKind
+constexpr std::uint16_t kSessionEventValueColumn = 10;
+constexpr std::uint16_t kSessionEntityColumnBase = 64;
+
+// Quantized TelemetryField of one entity
+constexpr std::uint16_t sessionEntityColumn(size_t entity, TelemetryField field) {
+    return (std::uint16_t)(kSessionEntityColumnBase + entity * kTelemetryFieldCount + (size_t)field);
+}
+
+// Column encodings
+constexpr std::uint8_t kSessionDeltaVarint = 1;
+
+enum class SessionEventKind : std::uint32_t {
+    state = 1,      // GameState
+    phase = 2,      // MatchPhase
+    score = 3       // blue << 16 | orange
+};
+
+struct SessionEvent {
+    std::int64_t timeMs;
+    SessionEventKind kind;
+    std::int64_t value;
+};
+
+struct SessionFileHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::int64_t createdAtMs;
+    std::uint32_t entityCount;      // kTelemetryEntities when written
+    std::uint32_t fieldCount;       // kTelemetryFieldCount when written
+    std::uint64_t reserved;
+};
+
+struct SessionChunkHeader {
+    std::uint32_t magic;
+    std::uint32_t byteLength;       // header and blocks
+    std::uint32_t frameCount;
+    std::uint32_t eventCount;
+    std::uint32_t blockCount;
+    std::uint32_t entityMask;       // entities with columns in this chunk
+    std::int64_t firstTimeMs;
+    std::int64_t lastTimeMs;
+};
+
+struct SessionBlockHeader {
+    std::uint16_t column;
+    std::uint8_t encoding;
+    std::uint8_t reserved;
+    std::uint32_t count;            // rows
+    std::uint32_t byteLength;       // encoded bytes after this header
+};
+
+struct SessionChunkIndex {
+    std::uint64_t offset;
+    std::uint32_t byteLength;
+    std::uint32_t frameCount;
+    std::uint32_t eventCount;
+    std::uint32_t entityMask;
+    std::int64_t firstTimeMs;
+    std::int64_t lastTimeMs;
+};
+
+struct SessionTrailer {
+    std::uint64_t footerOffset;
+    std::uint32_t chunkCount;
+    std::uint32_t magic;
+};
+
+static_assert(sizeof(SessionFileHeader) == 32, "file header layout");
+static_assert(sizeof(SessionChunkHeader) == 40, "chunk header layout");
+static_assert(sizeof(SessionBlockHeader) == 12, "block header layout");
+static_assert(sizeof(SessionChunkIndex) == 40, "chunk index layout");
+static_assert(sizeof(SessionTrailer) == 16, "trailer layout");
+static_assert(kTelemetryEntities <= 32, "entity masks are 32 bits");
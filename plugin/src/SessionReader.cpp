@@ -0,0 +1,179 @@
+#include "SessionReader.h"
+#include <algorithm>
+#include <cstring>
+
+// Copy a struct out of the mapping (the file gives no alignment guarantees)
+template <typename T>
+static T readStruct(const char* at) {
+    T value;
+    std::memcpy(&value, at, sizeof(T));
+    return value;
+}
+
+// Decode `count` zigzag varint deltas; false if the block is truncated
+static bool decodeDeltaVarints(const char* data, size_t length, std::uint32_t count, std::vector<std::int64_t>& out) {
+    out.resize(count);
+    const std::uint8_t* p = reinterpret_cast<const std::uint8_t*>(data);
+    const std::uint8_t* end = p + length;
+    std::int64_t value = 0;
+
+    for (std::uint32_t i = 0; i < count; ++i) {
+        // Most deltas fit in one byte
+        std::uint64_t zigzag;
+        if (p < end && *p < 0x80) {
+            zigzag = *p++;
+        } else {
+            zigzag = 0;
+            int shift = 0;
+            for (;;) {
+                if (p >= end || shift > 63) return false;
+                std::uint8_t byte = *p++;
+                zigzag |= (std::uint64_t)(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) break;
+                shift += 7;
+            }
+        }
+        value += (std::int64_t)(zigzag >> 1) ^ -(std::int64_t)(zigzag & 1);
+        out[i] = value;
+    }
+    return true;
+}
+
+SessionReader::SessionReader()
+    : createdAtMs(0), footerFound(false) {
+}
+
+bool SessionReader::open(const std::string& path) {
+    close();
+
+    if (!file.open(path) || file.size() < sizeof(SessionFileHeader)) {
+        file.close();
+        return false;
+    }
+
+    SessionFileHeader header = readStruct<SessionFileHeader>(file.data());
+    if (header.magic != kSessionFileMagic || header.version != kSessionVersion ||
+        header.entityCount != kTelemetryEntities || header.fieldCount != kTelemetryFieldCount) {
+        file.close();
+        return false;
+    }
+    createdAtMs = header.createdAtMs;
+
+    footerFound = loadFooter();
+    if (!footerFound) {
+        scanChunks();
+    }
+    return true;
+}
+
+void SessionReader::close() {
+    file.close();
+    chunks.clear();
+    createdAtMs = 0;
+    footerFound = false;
+}
+
+bool SessionReader::loadFooter() {
+    size_t size = file.size();
+    if (size < sizeof(SessionFileHeader) + sizeof(SessionTrailer)) return false;
+
+    SessionTrailer trailer = readStruct<SessionTrailer>(file.data() + size - sizeof(SessionTrailer));
+    if (trailer.magic != kSessionFooterMagic ||
+        trailer.footerOffset < sizeof(SessionFileHeader) ||
+        trailer.footerOffset + (std::uint64_t)trailer.chunkCount * sizeof(SessionChunkIndex) + sizeof(SessionTrailer) != size) {
+        return false;
+    }
+
+    chunks.resize(trailer.chunkCount);
+    if (trailer.chunkCount) {
+        std::memcpy(chunks.data(), file.data() + trailer.footerOffset, trailer.chunkCount * sizeof(SessionChunkIndex));
+    }
+    for (const SessionChunkIndex& chunk : chunks) {
+        if (chunk.offset + chunk.byteLength > trailer.footerOffset) {
+            chunks.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+// Recover the index of a file the recorder never closed: walk the chunk
+// headers and stop at the first incomplete one
+void SessionReader::scanChunks() {
+    size_t offset = sizeof(SessionFileHeader);
+    size_t size = file.size();
+
+    while (offset + sizeof(SessionChunkHeader) <= size) {
+        SessionChunkHeader header = readStruct<SessionChunkHeader>(file.data() + offset);
+        if (header.magic != kSessionChunkMagic || header.byteLength < sizeof(SessionChunkHeader) ||
+            offset + header.byteLength > size) {
+            break;
+        }
+
+        SessionChunkIndex entry = {};
+        entry.offset = offset;
+        entry.byteLength = header.byteLength;
+        entry.frameCount = header.frameCount;
+        entry.eventCount = header.eventCount;
+        entry.entityMask = header.entityMask;
+        entry.firstTimeMs = header.firstTimeMs;
+        entry.lastTimeMs = header.lastTimeMs;
+        chunks.push_back(entry);
+
+        offset += header.byteLength;
+    }
+}
+
+size_t SessionReader::findChunk(std::int64_t timeMs) const {
+    auto it = std::lower_bound(chunks.begin(), chunks.end(), timeMs,
+        [](const SessionChunkIndex& chunk, std::int64_t time) { return chunk.lastTimeMs < time; });
+    return (size_t)(it - chunks.begin());
+}
+
+bool SessionReader::readColumn(size_t chunk, std::uint16_t column, std::vector<std::int64_t>& out) const {
+    out.clear();
+    if (chunk >= chunks.size()) return false;
+
+    const SessionChunkIndex& entry = chunks[chunk];
+    if (entry.byteLength < sizeof(SessionChunkHeader)) return false;
+    const char* base = file.data() + entry.offset;
+    SessionChunkHeader header = readStruct<SessionChunkHeader>(base);
+    if (header.magic != kSessionChunkMagic) return false;
+
+    // Skip from block to block by length; nothing else is decoded
+    size_t offset = sizeof(SessionChunkHeader);
+    for (std::uint32_t block = 0; block < header.blockCount; ++block) {
+        if (offset + sizeof(SessionBlockHeader) > entry.byteLength) return false;
+        SessionBlockHeader blockHeader = readStruct<SessionBlockHeader>(base + offset);
+        offset += sizeof(SessionBlockHeader);
+        if (offset + blockHeader.byteLength > entry.byteLength) return false;
+
+        if (blockHeader.column == column) {
+            // Every varint takes at least a byte; a larger count is corrupt
+            // and must not size the output
+            return blockHeader.encoding == kSessionDeltaVarint && blockHeader.count <= blockHeader.byteLength &&
+                   decodeDeltaVarints(base + offset, blockHeader.byteLength, blockHeader.count, out);
+        }
+        offset += blockHeader.byteLength;
+    }
+    return false;
+}
+
+bool SessionReader::readEvents(size_t chunk, std::vector<SessionEvent>& out) const {
+    out.clear();
+    if (chunk >= chunks.size() || chunks[chunk].eventCount == 0) return chunk < chunks.size();
+
+    std::vector<std::int64_t> times, kinds, values;
+    if (!readColumn(chunk, kSessionEventTimeColumn, times) ||
+        !readColumn(chunk, kSessionEventKindColumn, kinds) ||
+        !readColumn(chunk, kSessionEventValueColumn, values) ||
+        times.size() != kinds.size() || times.size() != values.size()) {
+        return false;
+    }
+
+    out.resize(times.size());
+    for (size_t i = 0; i < times.size(); ++i) {
+        out[i] = SessionEvent{times[i], (SessionEventKind)kinds[i], values[i]};
+    }
+    return true;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "MappedFile.h"
+#include "SessionFormat.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Random access to a session recording (SessionFormat.h) through a memory
+// map. Only the chunk index is read on open; columns are decoded on
+// request, so a scan that needs a handful of columns skips the rest.
+//
+//   SessionReader reader;
+//   if (reader.open("session.gsr")) {
+//       size_t chunk = reader.findChunk(matchStartMs);
+//       std::vector<std::int64_t> ballZ;
+//       reader.readColumn(chunk, sessionEntityColumn(kTelemetryBall, TelemetryField::locationZ), ballZ);
+//   }
+class SessionReader {
+public:
+    SessionReader();
+
+    // Map the file and load its chunk index; a file without a footer (the
+    // recorder did not close) is indexed by walking its chunks
+    bool open(const std::string& path);
+    void close();
+
+    std::int64_t getCreatedAtMs() const { return createdAtMs; }
+    bool hasFooter() const { return footerFound; }
+    size_t getFileSize() const { return file.size(); }
+
+    size_t getChunkCount() const { return chunks.size(); }
+    const SessionChunkIndex& getChunk(size_t chunk) const { return chunks[chunk]; }
+
+    // First chunk whose time range ends at or after timeMs
+    // (getChunkCount() if none)
+    size_t findChunk(std::int64_t timeMs) const;
+
+    // Decode one column of a chunk into `out`. False if the chunk has no
+    // such column (an entity absent from it) or the block is damaged.
+    bool readColumn(size_t chunk, std::uint16_t column, std::vector<std::int64_t>& out) const;
+    bool readEvents(size_t chunk, std::vector<SessionEvent>& out) const;
+
+private:
+    MappedFile file;
+    std::int64_t createdAtMs;
+    bool footerFound;
+    std::vector<SessionChunkIndex> chunks;
+
+    bool loadFooter();
+    void scanChunks();
+};
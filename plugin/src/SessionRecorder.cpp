@@ -0,0 +1,353 @@
+#include "SessionRecorder.h"
+#include "WireProtocol.h"
+#include "Tracer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// Chunks waiting for the writer before new ones are dropped
+static const size_t kMaxPendingChunks = 8;
+
+// Columns of the open chunk; vectors keep their capacity between chunks,
+// so recording does not allocate once the pool is warm
+struct SessionRecorder::Chunk {
+    std::vector<std::int64_t> frameTimes;
+    std::vector<std::int64_t> physicsFrames;
+    std::vector<std::int64_t> present;
+    std::vector<std::int32_t> fields[kTelemetryEntities][kTelemetryFieldCount];
+    std::vector<std::int64_t> eventTimes;
+    std::vector<std::int64_t> eventKinds;
+    std::vector<std::int64_t> eventValues;
+    std::uint32_t entityMask = 0;
+    std::int64_t firstTimeMs = 0;
+    std::int64_t lastTimeMs = 0;
+
+    Chunk() {
+        frameTimes.reserve(kSessionChunkFrames);
+        physicsFrames.reserve(kSessionChunkFrames);
+        present.reserve(kSessionChunkFrames);
+        for (auto& entity : fields) {
+            for (auto& column : entity) {
+                column.reserve(kSessionChunkFrames);
+            }
+        }
+    }
+
+    bool empty() const { return frameTimes.empty() && eventTimes.empty(); }
+
+    void clear() {
+        frameTimes.clear();
+        physicsFrames.clear();
+        present.clear();
+        for (auto& entity : fields) {
+            for (auto& column : entity) {
+                column.clear();
+            }
+        }
+        eventTimes.clear();
+        eventKinds.clear();
+        eventValues.clear();
+        entityMask = 0;
+        firstTimeMs = 0;
+        lastTimeMs = 0;
+    }
+
+    void touch(std::int64_t timeMs) {
+        if (empty()) firstTimeMs = timeMs;
+        lastTimeMs = std::max(lastTimeMs, timeMs);
+    }
+};
+
+SessionRecorder::SessionRecorder()
+    : file(nullptr), ringCursor(0), lastScore(-1), framesRecorded(0), chunksDropped(0),
+      stopping(false), fileOffset(0), chunksWritten(0), bytesWritten(0) {
+}
+
+SessionRecorder::~SessionRecorder() {
+    close();
+}
+
+bool SessionRecorder::open(const std::string& path, std::int64_t createdAtMs) {
+    close();
+
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    std::setvbuf(file, nullptr, _IOFBF, 1 << 20);
+
+    SessionFileHeader header = {};
+    header.magic = kSessionFileMagic;
+    header.version = kSessionVersion;
+    header.createdAtMs = createdAtMs;
+    header.entityCount = (std::uint32_t)kTelemetryEntities;
+    header.fieldCount = (std::uint32_t)kTelemetryFieldCount;
+    std::fwrite(&header, sizeof(header), 1, file);
+
+    fileOffset = sizeof(header);
+    bytesWritten = sizeof(header);
+    chunksWritten = 0;
+    index.clear();
+    building = std::make_unique<Chunk>();
+    ringCursor = 0;
+    lastScore = -1;
+    framesRecorded = 0;
+    chunksDropped = 0;
+    stopping = false;
+    writerThread = std::thread(&SessionRecorder::writerLoop, this);
+    return true;
+}
+
+void SessionRecorder::close() {
+    if (!file) return;
+
+    if (building && !building->empty()) {
+        handOff();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        stopping = true;
+    }
+    pendingReady.notify_one();
+    if (writerThread.joinable()) {
+        writerThread.join();
+    }
+
+    writeFooter();
+    std::fclose(file);
+    file = nullptr;
+    building.reset();
+    pending.clear();
+    spare.clear();
+}
+
+void SessionRecorder::recordFrame(const TelemetryFrame& frame, std::int64_t timeMs) {
+    if (!file) return;
+    rotateIfDue(timeMs);
+
+    Chunk& chunk = *building;
+    chunk.touch(timeMs);
+    chunk.frameTimes.push_back(timeMs);
+    chunk.physicsFrames.push_back((std::int64_t)frame.physicsFrame);
+
+    // Absent entities repeat their last row, which costs one byte per
+    // field after delta coding
+    std::uint32_t present = 0;
+    TelemetryQuantized quantized;
+    for (size_t entity = 0; entity < kTelemetryEntities; ++entity) {
+        auto& columns = chunk.fields[entity];
+        if (frame.flags[entity] & kTelemetryPresent) {
+            present |= 1u << entity;
+            quantizeTelemetryEntity(frame, entity, quantized);
+            for (size_t field = 0; field < kTelemetryFieldCount; ++field) {
+                columns[field].push_back(quantized[field]);
+            }
+        } else {
+            for (size_t field = 0; field < kTelemetryFieldCount; ++field) {
+                columns[field].push_back(columns[field].empty() ? 0 : columns[field].back());
+            }
+        }
+    }
+    chunk.present.push_back(present);
+    chunk.entityMask |= present;
+    ++framesRecorded;
+
+    if (chunk.frameTimes.size() >= kSessionChunkFrames) {
+        handOff();
+    }
+}
+
+size_t SessionRecorder::recordFrames(const TelemetryRing& ring, std::int64_t nowMs) {
+    if (!file) return 0;
+
+    std::uint64_t end = ring.getFrameCount();
+    ringCursor = std::max(ringCursor, ring.getOldestFrame());
+    if (ringCursor >= end) {
+        rotateIfDue(nowMs);
+        return 0;
+    }
+
+    // Place earlier frames by their physics time relative to the newest
+    TelemetryFrame newest;
+    ring.readFrame(end - 1, newest);
+
+    size_t recorded = 0;
+    TelemetryFrame frame;
+    for (; ringCursor < end; ++ringCursor) {
+        if (!ring.readFrame(ringCursor, frame)) continue;
+        double behindMs = ((double)newest.physicsTime - frame.physicsTime) * 1000.0;
+        std::int64_t timeMs = (behindMs >= 0.0 && behindMs < (double)kSessionChunkMaxAgeMs)
+            ? nowMs - (std::int64_t)std::llround(behindMs) : nowMs;
+        recordFrame(frame, timeMs);
+        ++recorded;
+    }
+    return recorded;
+}
+
+void SessionRecorder::recordEvent(SessionEventKind kind, std::int64_t value, std::int64_t timeMs) {
+    if (!file) return;
+    rotateIfDue(timeMs);
+
+    Chunk& chunk = *building;
+    chunk.touch(timeMs);
+    chunk.eventTimes.push_back(timeMs);
+    chunk.eventKinds.push_back((std::int64_t)kind);
+    chunk.eventValues.push_back(value);
+}
+
+void SessionRecorder::recordScore(int blueScore, int orangeScore, std::int64_t timeMs) {
+    std::int64_t score = ((std::int64_t)blueScore << 16) | (std::int64_t)(orangeScore & 0xFFFF);
+    if (score == lastScore) return;
+    lastScore = score;
+    recordEvent(SessionEventKind::score, score, timeMs);
+}
+
+// Close the open chunk once it spans kSessionChunkMaxAgeMs
+void SessionRecorder::rotateIfDue(std::int64_t timeMs) {
+    if (!building->empty() && timeMs - building->firstTimeMs >= kSessionChunkMaxAgeMs) {
+        handOff();
+    }
+}
+
+// Give the open chunk to the writer and start a new one (game thread)
+void SessionRecorder::handOff() {
+    std::unique_ptr<Chunk> next;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        if (pending.size() >= kMaxPendingChunks) {
+            // Writer stuck (disk full, stalled drive); drop rather than grow
+            ++chunksDropped;
+            building->clear();
+            return;
+        }
+        pending.push_back(std::move(building));
+        if (!spare.empty()) {
+            next = std::move(spare.back());
+            spare.pop_back();
+        }
+    }
+    pendingReady.notify_one();
+
+    building = next ? std::move(next) : std::make_unique<Chunk>();
+}
+
+void SessionRecorder::writerLoop() {
+    Tracer::setThreadName("session writer");
+    std::unique_lock<std::mutex> lock(pendingMutex);
+    for (;;) {
+        pendingReady.wait(lock, [this] { return stopping || !pending.empty(); });
+        if (pending.empty()) {
+            return;
+        }
+
+        std::unique_ptr<Chunk> chunk = std::move(pending.front());
+        pending.erase(pending.begin());
+
+        lock.unlock();
+        {
+            GS_TRACE_SCOPE("session chunk write", "io");
+            writeChunk(*chunk);
+        }
+        chunk->clear();
+        lock.lock();
+
+        spare.push_back(std::move(chunk));
+    }
+}
+
+// Zigzag varint deltas of one column, appended to `out` behind its header
+template <typename T>
+static void appendColumn(std::vector<char>& out, std::uint16_t column, const std::vector<T>& values) {
+    size_t headerAt = out.size();
+    out.resize(headerAt + sizeof(SessionBlockHeader) + values.size() * 10);
+
+    char* data = out.data() + headerAt + sizeof(SessionBlockHeader);
+    size_t length = 0;
+    std::int64_t previous = 0;
+    for (T value : values) {
+        std::int64_t delta = (std::int64_t)value - previous;
+        previous = (std::int64_t)value;
+        length += writeVarint(data + length, ((std::uint64_t)delta << 1) ^ (std::uint64_t)(delta >> 63));
+    }
+
+    SessionBlockHeader header = {};
+    header.column = column;
+    header.encoding = kSessionDeltaVarint;
+    header.count = (std::uint32_t)values.size();
+    header.byteLength = (std::uint32_t)length;
+    std::memcpy(out.data() + headerAt, &header, sizeof(header));
+    out.resize(headerAt + sizeof(SessionBlockHeader) + length);
+}
+
+// Encode every column of a chunk and append it to the file (writer thread)
+void SessionRecorder::writeChunk(const Chunk& chunk) {
+    encodeBuffer.resize(sizeof(SessionChunkHeader));
+    std::uint32_t blocks = 0;
+
+    if (!chunk.frameTimes.empty()) {
+        appendColumn(encodeBuffer, kSessionFrameTimeColumn, chunk.frameTimes);
+        appendColumn(encodeBuffer, kSessionPhysicsFrameColumn, chunk.physicsFrames);
+        appendColumn(encodeBuffer, kSessionPresentColumn, chunk.present);
+        blocks += 3;
+
+        for (size_t entity = 0; entity < kTelemetryEntities; ++entity) {
+            if (!(chunk.entityMask & (1u << entity))) continue;
+            for (size_t field = 0; field < kTelemetryFieldCount; ++field) {
+                appendColumn(encodeBuffer, sessionEntityColumn(entity, (TelemetryField)field), chunk.fields[entity][field]);
+                ++blocks;
+            }
+        }
+    }
+
+    if (!chunk.eventTimes.empty()) {
+        appendColumn(encodeBuffer, kSessionEventTimeColumn, chunk.eventTimes);
+        appendColumn(encodeBuffer, kSessionEventKindColumn, chunk.eventKinds);
+        appendColumn(encodeBuffer, kSessionEventValueColumn, chunk.eventValues);
+        blocks += 3;
+    }
+
+    SessionChunkHeader header = {};
+    header.magic = kSessionChunkMagic;
+    header.byteLength = (std::uint32_t)encodeBuffer.size();
+    header.frameCount = (std::uint32_t)chunk.frameTimes.size();
+    header.eventCount = (std::uint32_t)chunk.eventTimes.size();
+    header.blockCount = blocks;
+    header.entityMask = chunk.entityMask;
+    header.firstTimeMs = chunk.firstTimeMs;
+    header.lastTimeMs = chunk.lastTimeMs;
+    std::memcpy(encodeBuffer.data(), &header, sizeof(header));
+
+    std::fwrite(encodeBuffer.data(), 1, encodeBuffer.size(), file);
+
+    SessionChunkIndex entry = {};
+    entry.offset = fileOffset;
+    entry.byteLength = header.byteLength;
+    entry.frameCount = header.frameCount;
+    entry.eventCount = header.eventCount;
+    entry.entityMask = header.entityMask;
+    entry.firstTimeMs = header.firstTimeMs;
+    entry.lastTimeMs = header.lastTimeMs;
+    index.push_back(entry);
+
+    fileOffset += encodeBuffer.size();
+    bytesWritten.fetch_add(encodeBuffer.size(), std::memory_order_relaxed);
+    chunksWritten.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Chunk index and trailer, after the writer thread has stopped
+void SessionRecorder::writeFooter() {
+    SessionTrailer trailer = {};
+    trailer.footerOffset = fileOffset;
+    trailer.chunkCount = (std::uint32_t)index.size();
+    trailer.magic = kSessionFooterMagic;
+
+    if (!index.empty()) {
+        std::fwrite(index.data(), sizeof(SessionChunkIndex), index.size(), file);
+    }
+    std::fwrite(&trailer, sizeof(trailer), 1, file);
+
+    size_t footerBytes = index.size() * sizeof(SessionChunkIndex) + sizeof(trailer);
+    fileOffset += footerBytes;
+    bytesWritten.fetch_add(footerBytes, std::memory_order_relaxed);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "SessionFormat.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Appends telemetry frames and state events to a session recording
+// (SessionFormat.h). The game thread only copies quantized values into the
+// open chunk; full chunks are handed to a writer thread, which encodes the
+// columns and writes them out sequentially. The handoff takes a mutex once
+// per chunk (every few seconds), never per frame.
+//
+//   SessionRecorder recorder;
+//   recorder.open("recordings/session-20261016-193000.gsr", nowMs);
+//   recorder.recordFrames(sampler.getRing(), nowMs);     // every tick
+//   recorder.recordEvent(SessionEventKind::phase, (int)phase, nowMs);
+//   recorder.close();                                   // writes the footer
+class SessionRecorder {
+public:
+    SessionRecorder();
+    ~SessionRecorder();
+
+    bool open(const std::string& path, std::int64_t createdAtMs);
+    // Flush the open chunk, write the footer and stop the writer thread
+    void close();
+    bool isOpen() const { return file != nullptr; }
+
+    // Game thread. recordFrames appends every ring frame not recorded yet;
+    // frame times are placed before nowMs by their physics time.
+    void recordFrame(const TelemetryFrame& frame, std::int64_t timeMs);
+    size_t recordFrames(const TelemetryRing& ring, std::int64_t nowMs);
+    void recordEvent(SessionEventKind kind, std::int64_t value, std::int64_t timeMs);
+    // Score events only when the score differs from the last one recorded
+    void recordScore(int blueScore, int orangeScore, std::int64_t timeMs);
+
+    std::uint64_t getFramesRecorded() const { return framesRecorded; }
+    std::uint64_t getChunksWritten() const { return chunksWritten.load(std::memory_order_relaxed); }
+    std::uint64_t getBytesWritten() const { return bytesWritten.load(std::memory_order_relaxed); }
+    // Chunks lost because the writer fell behind by kMaxPendingChunks
+    std::uint64_t getChunksDropped() const { return chunksDropped; }
+
+private:
+    struct Chunk;
+
+    FILE* file;
+    std::unique_ptr<Chunk> building;
+    std::uint64_t ringCursor;
+    std::int64_t lastScore;
+    std::uint64_t framesRecorded;
+    std::uint64_t chunksDropped;
+
+    // Writer thread
+    std::thread writerThread;
+    std::mutex pendingMutex;
+    std::condition_variable pendingReady;
+    std::vector<std::unique_ptr<Chunk>> pending;
+    std::vector<std::unique_ptr<Chunk>> spare;
+    bool stopping;
+
+    // Writer thread state
+    std::uint64_t fileOffset;
+    std::vector<SessionChunkIndex> index;
+    std::vector<char> encodeBuffer;
+    std::atomic<std::uint64_t> chunksWritten;
+    std::atomic<std::uint64_t> bytesWritten;
+
+    void rotateIfDue(std::int64_t timeMs);
+    void handOff();
+    void writerLoop();
+    void writeChunk(const Chunk& chunk);
+    void writeFooter();
+
+    // Disable copying
+    SessionRecorder(const SessionRecorder&) = delete;
+    SessionRecorder& operator=(const SessionRecorder&) = delete;
+};
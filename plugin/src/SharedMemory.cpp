@@ -0,0 +1,246 @@
+#include "SharedMemory.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <climits>
+#include <ctime>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+// Session-local names, so no elevation is needed
+static std::string windowsObjectName(const std::string& name, const char* suffix) {
+    return "Local\\" + name + suffix;
+}
+#else
+// POSIX shared memory names start with a single slash
+static std::string posixShmName(const std::string& name) {
+    return name.empty() || name[0] != '/' ? "/" + name : name;
+}
+#endif
+
+SharedMemoryRegion::SharedMemoryRegion()
+    : base(nullptr), length(0), owner(false),
+#ifdef _WIN32
+      mapping(nullptr) {
+#else
+      fd(-1) {
+#endif
+}
+
+SharedMemoryRegion::~SharedMemoryRegion() {
+    close();
+}
+
+bool SharedMemoryRegion::create(const std::string& name, size_t size) {
+    close();
+
+#ifdef _WIN32
+    std::string objectName = windowsObjectName(name, "");
+    HANDLE handle = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                       (DWORD)((unsigned long long)size >> 32), (DWORD)(size & 0xFFFFFFFF),
+                                       objectName.c_str());
+    if (!handle) {
+        return false;
+    }
+    void* view = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (!view) {
+        CloseHandle(handle);
+        return false;
+    }
+    mapping = handle;
+    base = view;
+#else
+    std::string objectName = posixShmName(name);
+    // A previous run that crashed may have left the name behind
+    shm_unlink(objectName.c_str());
+
+    int handle = shm_open(objectName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (handle < 0) {
+        return false;
+    }
+    if (ftruncate(handle, (off_t)size) != 0) {
+        ::close(handle);
+        shm_unlink(objectName.c_str());
+        return false;
+    }
+    void* view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, handle, 0);
+    if (view == MAP_FAILED) {
+        ::close(handle);
+        shm_unlink(objectName.c_str());
+        return false;
+    }
+    fd = handle;
+    base = view;
+#endif
+
+    length = size;
+    regionName = name;
+    owner = true;
+    return true;
+}
+
+bool SharedMemoryRegion::open(const std::string& name) {
+    close();
+
+#ifdef _WIN32
+    std::string objectName = windowsObjectName(name, "");
+    HANDLE handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, objectName.c_str());
+    if (!handle) {
+        return false;
+    }
+    void* view = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    if (!view) {
+        CloseHandle(handle);
+        return false;
+    }
+    MEMORY_BASIC_INFORMATION info;
+    VirtualQuery(view, &info, sizeof(info));
+    mapping = handle;
+    base = view;
+    length = info.RegionSize;
+#else
+    std::string objectName = posixShmName(name);
+    int handle = shm_open(objectName.c_str(), O_RDWR, 0);
+    if (handle < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(handle, &info) != 0 || info.st_size <= 0) {
+        ::close(handle);
+        return false;
+    }
+    void* view = mmap(nullptr, (size_t)info.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, handle, 0);
+    if (view == MAP_FAILED) {
+        ::close(handle);
+        return false;
+    }
+    fd = handle;
+    base = view;
+    length = (size_t)info.st_size;
+#endif
+
+    regionName = name;
+    owner = false;
+    return true;
+}
+
+void SharedMemoryRegion::close() {
+    if (!base) {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(base);
+    CloseHandle((HANDLE)mapping);
+    mapping = nullptr;
+#else
+    munmap(base, length);
+    ::close(fd);
+    fd = -1;
+    if (owner) {
+        shm_unlink(posixShmName(regionName).c_str());
+    }
+#endif
+
+    base = nullptr;
+    length = 0;
+    owner = false;
+}
+
+ShmDoorbell::ShmDoorbell()
+    : word(nullptr)
+#ifdef _WIN32
+    , event(nullptr)
+#endif
+{
+}
+
+ShmDoorbell::~ShmDoorbell() {
+    close();
+}
+
+bool ShmDoorbell::create(const std::string& name, std::atomic<std::uint32_t>* sequence) {
+    close();
+#ifdef _WIN32
+    // Auto-reset: one SetEvent releases one wait
+    event = CreateEventA(nullptr, FALSE, FALSE, windowsObjectName(name, "_doorbell").c_str());
+    if (!event) {
+        return false;
+    }
+#else
+    (void)name;
+#endif
+    word = sequence;
+    return true;
+}
+
+bool ShmDoorbell::open(const std::string& name, std::atomic<std::uint32_t>* sequence) {
+    close();
+#ifdef _WIN32
+    event = OpenEventA(EVENT_MODIFY_STATE | SYNCHRONIZE, FALSE, windowsObjectName(name, "_doorbell").c_str());
+    if (!event) {
+        return false;
+    }
+#else
+    (void)name;
+#endif
+    word = sequence;
+    return true;
+}
+
+void ShmDoorbell::close() {
+#ifdef _WIN32
+    if (event) {
+        CloseHandle((HANDLE)event);
+        event = nullptr;
+    }
+#endif
+    word = nullptr;
+}
+
+void ShmDoorbell::ring() {
+#ifdef _WIN32
+    if (event) {
+        SetEvent((HANDLE)event);
+    }
+#else
+    if (word) {
+        // Shared (not FUTEX_PRIVATE) because the waiter is another process
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+    }
+#endif
+}
+
+void ShmDoorbell::wait(std::uint32_t seen, int timeoutMs) {
+#ifdef _WIN32
+    if (event && word->load(std::memory_order_acquire) == seen) {
+        WaitForSingleObject((HANDLE)event, timeoutMs < 0 ? INFINITE : (DWORD)timeoutMs);
+    }
+#else
+    if (!word) {
+        return;
+    }
+    struct timespec timeout;
+    struct timespec* timeoutPtr = nullptr;
+    if (timeoutMs >= 0) {
+        timeout.tv_sec = timeoutMs / 1000;
+        timeout.tv_nsec = (long)(timeoutMs % 1000) * 1000000L;
+        timeoutPtr = &timeout;
+    }
+    // Returns at once if the word has already moved on
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), FUTEX_WAIT, seen, timeoutPtr, nullptr, 0);
+#endif
+}
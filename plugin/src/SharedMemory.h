@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Named shared memory and a cross-process wakeup, the OS layer under the
+// shared-memory ring transport. Windows uses a pagefile-backed file mapping
+// and a named event; Linux uses shm_open and a futex on a word inside the
+// region.
+
+// A named memory region mapped into this process
+class SharedMemoryRegion {
+public:
+    SharedMemoryRegion();
+    ~SharedMemoryRegion();
+
+    // Create (or take over) the region; the creator removes the name again
+    // on close where the OS needs that (Linux)
+    bool create(const std::string& name, size_t size);
+    // Map a region another process created
+    bool open(const std::string& name);
+    void close();
+
+    bool isOpen() const { return base != nullptr; }
+    void* data() const { return base; }
+    size_t size() const { return length; }
+
+private:
+    void* base;
+    size_t length;
+    std::string regionName;
+    bool owner;
+#ifdef _WIN32
+    void* mapping;      // HANDLE
+#else
+    int fd;
+#endif
+
+    // Disable copying
+    SharedMemoryRegion(const SharedMemoryRegion&) = delete;
+    SharedMemoryRegion& operator=(const SharedMemoryRegion&) = delete;
+};
+
+// Wakes a consumer sleeping on a 32-bit sequence word that lives in shared
+// memory. The producer bumps the word and rings; the consumer waits until
+// the word differs from the value it last saw.
+class ShmDoorbell {
+public:
+    ShmDoorbell();
+    ~ShmDoorbell();
+
+    bool create(const std::string& name, std::atomic<std::uint32_t>* word);
+    bool open(const std::string& name, std::atomic<std::uint32_t>* word);
+    void close();
+
+    // Producer: wake a waiting consumer
+    void ring();
+    // Consumer: sleep while the word still equals `seen`, up to timeoutMs
+    // (-1 = no limit). May return early; callers re-check their condition.
+    void wait(std::uint32_t seen, int timeoutMs);
+
+private:
+    std::atomic<std::uint32_t>* word;
+#ifdef _WIN32
+    void* event;        // HANDLE
+#endif
+
+    // Disable copying
+    ShmDoorbell(const ShmDoorbell&) = delete;
+    ShmDoorbell& operator=(const ShmDoorbell&) = delete;
+};
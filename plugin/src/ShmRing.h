@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Layout of the shared-memory ring between the plugin (single producer) and
+// the desktop app (single consumer). The region starts with ShmRingHeader;
+// ring data follows at kShmRingDataOffset.
+//
+// Each record is a 4-byte length followed by the message bytes, padded to
+// 8 bytes. Records never wrap: when one does not fit before the end of the
+// ring, the producer writes kShmPaddingRecord and starts again at offset 0,
+// so every message can be read in place. Positions grow monotonically; the
+// offset is position & (capacity - 1).
+//
+// Messages use the binary encoding from WireProtocol.h.
+
+constexpr std::uint32_t kShmRingMagic = 0x47535252;    // "RRSG"
+constexpr std::uint32_t kShmRingVersion = 1;
+constexpr std::uint32_t kShmPaddingRecord = 0xFFFFFFFFu;
+constexpr size_t kShmRecordAlign = 8;
+constexpr size_t kShmRingDataOffset = 256;
+
+struct ShmRingHeader {
+    std::atomic<std::uint32_t> magic;       // written last by the producer
+    std::uint32_t version;
+    std::uint64_t capacity;                 // data bytes, a power of two
+
+    alignas(64) std::atomic<std::uint64_t> writePos;   // producer
+    alignas(64) std::atomic<std::uint64_t> readPos;    // consumer
+
+    // Doorbell word, bumped per published batch, and whether the consumer
+    // is (about to be) asleep on it
+    alignas(64) std::atomic<std::uint32_t> doorbell;
+    std::atomic<std::uint32_t> consumerWaiting;
+    std::atomic<std::uint32_t> producerClosed;         // plugin unloaded
+    std::atomic<std::uint64_t> dropped;                // messages that did not fit
+};
+
+static_assert(sizeof(ShmRingHeader) <= kShmRingDataOffset, "ring header overlaps the data area");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "ring positions must be lock-free");
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "ring doorbell must be lock-free");
+
+// Bytes a message occupies in the ring, including its length prefix
+constexpr size_t shmRecordSize(size_t payloadLength) {
+    return (sizeof(std::uint32_t) + payloadLength + kShmRecordAlign - 1) & ~(kShmRecordAlign - 1);
+}
@@ -0,0 +1,71 @@
+#include "ShmRingReader.h"
+
+ShmRingReader::ShmRingReader()
+    : header(nullptr), ring(nullptr), capacity(0) {
+}
+
+ShmRingReader::~ShmRingReader() {
+    close();
+}
+
+bool ShmRingReader::open(const std::string& name) {
+    close();
+
+    if (!region.open(name) || region.size() < kShmRingDataOffset) {
+        region.close();
+        return false;
+    }
+
+    ShmRingHeader* mapped = static_cast<ShmRingHeader*>(region.data());
+    if (mapped->magic.load(std::memory_order_acquire) != kShmRingMagic ||
+        mapped->version != kShmRingVersion ||
+        region.size() < kShmRingDataOffset + mapped->capacity) {
+        region.close();
+        return false;
+    }
+
+    if (!doorbell.open(name, &mapped->doorbell)) {
+        region.close();
+        return false;
+    }
+
+    header = mapped;
+    ring = static_cast<const char*>(region.data()) + kShmRingDataOffset;
+    capacity = mapped->capacity;
+    return true;
+}
+
+void ShmRingReader::close() {
+    doorbell.close();
+    region.close();
+    header = nullptr;
+    ring = nullptr;
+    capacity = 0;
+}
+
+bool ShmRingReader::wait(int timeoutMs) {
+    if (!header) {
+        return false;
+    }
+
+    std::uint32_t seen = header->doorbell.load(std::memory_order_acquire);
+
+    // Announce the sleep, then re-check: a producer that published before
+    // seeing consumerWaiting has already bumped the doorbell past `seen`
+    header->consumerWaiting.store(1, std::memory_order_seq_cst);
+    if (header->writePos.load(std::memory_order_seq_cst) == header->readPos.load(std::memory_order_relaxed) &&
+        !header->producerClosed.load(std::memory_order_acquire)) {
+        doorbell.wait(seen, timeoutMs);
+    }
+    header->consumerWaiting.store(0, std::memory_order_relaxed);
+
+    return header->writePos.load(std::memory_order_acquire) != header->readPos.load(std::memory_order_relaxed);
+}
+
+bool ShmRingReader::isProducerClosed() const {
+    return header && header->producerClosed.load(std::memory_order_acquire) != 0;
+}
+
+std::uint64_t ShmRingReader::getMessagesDropped() const {
+    return header ? header->dropped.load(std::memory_order_relaxed) : 0;
+}
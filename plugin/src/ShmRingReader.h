@@ -0,0 +1,86 @@
+#pragma once
+
+#include "ShmRing.h"
+#include "SharedMemory.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+// Consumer side of the shared-memory transport, for the desktop app. Built
+// as the GameStateShmReader library; depends only on ShmRing.h and
+// SharedMemory.{h,cpp}.
+//
+//   ShmRingReader reader;
+//   if (reader.open("TTLxRL_GameState")) {
+//       for (;;) {
+//           reader.poll([](std::string_view message) { /* WireProtocol.h */ });
+//           reader.wait(100);
+//       }
+//   }
+class ShmRingReader {
+public:
+    ShmRingReader();
+    ~ShmRingReader();
+
+    // Map the region the plugin created; fails until the plugin is loaded
+    bool open(const std::string& name);
+    void close();
+    bool isOpen() const { return header != nullptr; }
+
+    // Hand every available message to `onMessage(std::string_view)`. The view
+    // points into shared memory and is only valid during the call.
+    // Returns the number of messages delivered.
+    template <typename Callback>
+    size_t poll(Callback&& onMessage);
+
+    // Sleep until a message may be available, the producer closes or
+    // timeoutMs passes (-1 = no limit). Returns true if messages are waiting.
+    bool wait(int timeoutMs);
+
+    // The plugin unloaded; close() and open() again to follow a new instance
+    bool isProducerClosed() const;
+    std::uint64_t getMessagesDropped() const;
+
+private:
+    SharedMemoryRegion region;
+    ShmDoorbell doorbell;
+    ShmRingHeader* header;
+    const char* ring;
+    std::uint64_t capacity;
+
+    // Disable copying
+    ShmRingReader(const ShmRingReader&) = delete;
+    ShmRingReader& operator=(const ShmRingReader&) = delete;
+};
+
+template <typename Callback>
+size_t ShmRingReader::poll(Callback&& onMessage) {
+    if (!header) {
+        return 0;
+    }
+
+    size_t delivered = 0;
+    std::uint64_t readPos = header->readPos.load(std::memory_order_relaxed);
+    std::uint64_t writePos = header->writePos.load(std::memory_order_acquire);
+
+    while (readPos != writePos) {
+        size_t offset = (size_t)(readPos & (capacity - 1));
+        std::uint32_t length;
+        std::memcpy(&length, ring + offset, sizeof(length));
+
+        if (length == kShmPaddingRecord) {
+            readPos += capacity - offset;
+        } else {
+            onMessage(std::string_view(ring + offset + sizeof(length), length));
+            readPos += shmRecordSize(length);
+            ++delivered;
+        }
+
+        // Release the slot only after the callback is done with the view
+        header->readPos.store(readPos, std::memory_order_release);
+    }
+
+    return delivered;
+}
@@ -0,0 +1,112 @@
+#include "ShmRingWriter.h"
+#include <cstring>
+#include <new>
+
+ShmRingWriter::ShmRingWriter()
+    : header(nullptr), ring(nullptr), capacity(0), writePos(0), messagesWritten(0) {
+}
+
+ShmRingWriter::~ShmRingWriter() {
+    close();
+}
+
+bool ShmRingWriter::create(const std::string& name, size_t capacityBytes) {
+    close();
+
+    std::uint64_t size = 4096;
+    while (size < capacityBytes) {
+        size *= 2;
+    }
+
+    if (!region.create(name, kShmRingDataOffset + (size_t)size)) {
+        return false;
+    }
+
+    // Fresh mapping: construct the header in place, publish magic last so a
+    // reader never sees a half-initialized ring
+    header = new (region.data()) ShmRingHeader();
+    header->version = kShmRingVersion;
+    header->capacity = size;
+    header->writePos.store(0, std::memory_order_relaxed);
+    header->readPos.store(0, std::memory_order_relaxed);
+    header->doorbell.store(0, std::memory_order_relaxed);
+    header->consumerWaiting.store(0, std::memory_order_relaxed);
+    header->producerClosed.store(0, std::memory_order_relaxed);
+    header->dropped.store(0, std::memory_order_relaxed);
+
+    if (!doorbell.create(name, &header->doorbell)) {
+        header = nullptr;
+        region.close();
+        return false;
+    }
+
+    ring = static_cast<char*>(region.data()) + kShmRingDataOffset;
+    capacity = size;
+    writePos = 0;
+    header->magic.store(kShmRingMagic, std::memory_order_release);
+    return true;
+}
+
+void ShmRingWriter::close() {
+    if (header) {
+        // Let a waiting reader notice that the producer is gone
+        header->producerClosed.store(1, std::memory_order_release);
+        header->doorbell.fetch_add(1, std::memory_order_seq_cst);
+        doorbell.ring();
+    }
+    doorbell.close();
+    region.close();
+    header = nullptr;
+    ring = nullptr;
+    capacity = 0;
+}
+
+bool ShmRingWriter::write(const char* message, size_t length) {
+    if (!header) {
+        return false;
+    }
+
+    size_t record = shmRecordSize(length);
+    if (record > capacity / 2) {
+        header->dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    std::uint64_t readPos = header->readPos.load(std::memory_order_acquire);
+    size_t offset = (size_t)(writePos & (capacity - 1));
+    size_t tail = (size_t)capacity - offset;
+    size_t needed = record + (tail < record ? tail : 0);
+
+    if (capacity - (writePos - readPos) < needed) {
+        header->dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Not enough room before the end: skip to the start of the ring
+    if (tail < record) {
+        std::uint32_t padding = kShmPaddingRecord;
+        std::memcpy(ring + offset, &padding, sizeof(padding));
+        writePos += tail;
+        offset = 0;
+    }
+
+    std::uint32_t prefix = (std::uint32_t)length;
+    std::memcpy(ring + offset, &prefix, sizeof(prefix));
+    std::memcpy(ring + offset + sizeof(prefix), message, length);
+    writePos += record;
+
+    header->writePos.store(writePos, std::memory_order_release);
+    messagesWritten.fetch_add(1, std::memory_order_relaxed);
+
+    // Dekker-style handshake with ShmRingReader::wait: bump the doorbell
+    // before checking whether the reader went to sleep
+    header->doorbell.fetch_add(1, std::memory_order_seq_cst);
+    if (header->consumerWaiting.load(std::memory_order_seq_cst)) {
+        doorbell.ring();
+    }
+    return true;
+}
+
+std::uint64_t ShmRingWriter::getMessagesDropped() const {
+    return header ? header->dropped.load(std::memory_order_relaxed) : 0;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "ShmRing.h"
+#include "SharedMemory.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Producer side of the shared-memory transport (GameStatePlugin.cfg:
+// transport=shm). Creates the named region and appends messages without
+// blocking or allocating; when the consumer falls behind and the ring is
+// full, messages are dropped and counted.
+//
+// Single producer: write() must only be called from one thread at a time.
+class ShmRingWriter {
+public:
+    ShmRingWriter();
+    ~ShmRingWriter();
+
+    // Create the region `name` with a ring of at least capacityBytes
+    bool create(const std::string& name, size_t capacityBytes);
+    void close();
+    bool isOpen() const { return header != nullptr; }
+
+    // Append one message and ring the doorbell if the reader is asleep
+    bool write(const char* message, size_t length);
+
+    std::uint64_t getMessagesWritten() const { return messagesWritten.load(std::memory_order_relaxed); }
+    std::uint64_t getMessagesDropped() const;
+    size_t getCapacity() const { return (size_t)capacity; }
+
+private:
+    SharedMemoryRegion region;
+    ShmDoorbell doorbell;
+    ShmRingHeader* header;
+    char* ring;
+    std::uint64_t capacity;
+    std::uint64_t writePos;     // producer's copy of header->writePos
+    std::atomic<std::uint64_t> messagesWritten;
+
+    // Disable copying
+    ShmRingWriter(const ShmRingWriter&) = delete;
+    ShmRingWriter& operator=(const ShmRingWriter&) = delete;
+};
@@ -0,0 +1,90 @@
+#include "SignalDebouncer.h"
+
+SignalDebouncer::SignalDebouncer(TimerWheel& timerWheel, EmitCallback emitCallback)
+    : wheel(timerWheel), onEmit(std::move(emitCallback)), emittedCount(0), suppressedCount(0) {
+}
+
+SignalDebouncer::~SignalDebouncer() {
+    for (auto& entry : signals) {
+        if (entry.second.timer != 0) {
+            wheel.cancelTimer(entry.second.timer);
+        }
+    }
+}
+
+void SignalDebouncer::setPolicy(SignalId id, const DebouncePolicy& policy) {
+    getSignal(id).policy = policy;
+}
+
+SignalDebouncer::Signal& SignalDebouncer::getSignal(SignalId id) {
+    auto found = signals.find(id);
+    if (found != signals.end()) {
+        return found->second;
+    }
+
+    Signal& signal = signals[id];
+    signal.policy = defaultPolicy;
+    return signal;
+}
+
+void SignalDebouncer::update(SignalId id, std::int64_t value) {
+    Signal& signal = getSignal(id);
+    signal.latest = value;
+
+    bool changed = !signal.hasEmitted || value != signal.lastEmitted;
+
+    if (signal.policy.minDwell.count() <= 0) {
+        if (changed) {
+            emit(id, signal, value);
+        }
+        return;
+    }
+
+    if (signal.policy.edge == DebounceEdge::leading) {
+        // Inside a dwell window the value is held for the window's end
+        if (signal.timer != 0) {
+            ++suppressedCount;
+            return;
+        }
+        if (changed) {
+            emit(id, signal, value);
+            signal.timer = wheel.addTimer(signal.policy.minDwell, [this, id] { onTimer(id); });
+        }
+        return;
+    }
+
+    // Trailing: every raw change restarts the quiet period
+    if (signal.timer != 0) {
+        wheel.cancelTimer(signal.timer);
+        signal.timer = 0;
+        ++suppressedCount;
+    }
+    if (changed) {
+        signal.timer = wheel.addTimer(signal.policy.minDwell, [this, id] { onTimer(id); });
+    }
+}
+
+void SignalDebouncer::onTimer(SignalId id) {
+    Signal& signal = getSignal(id);
+    signal.timer = 0;
+
+    if (signal.hasEmitted && signal.latest == signal.lastEmitted) {
+        return;
+    }
+
+    emit(id, signal, signal.latest);
+
+    // Leading edge: the trailing value opens a dwell window of its own
+    if (signal.policy.edge == DebounceEdge::leading) {
+        signal.timer = wheel.addTimer(signal.policy.minDwell, [this, id] { onTimer(id); });
+    }
+}
+
+void SignalDebouncer::emit(SignalId id, Signal& signal, std::int64_t value) {
+    signal.hasEmitted = true;
+    signal.lastEmitted = value;
+    ++emittedCount;
+    if (onEmit) {
+        onEmit(id, value);
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "TimerWheel.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+// Which edge of a burst of changes gets through
+enum class DebounceEdge {
+    leading,    // emit the first change at once, then hold for minDwell
+    trailing    // emit once the value has been stable for minDwell
+};
+
+struct DebouncePolicy {
+    std::chrono::milliseconds minDwell = std::chrono::milliseconds(100);
+    DebounceEdge edge = DebounceEdge::leading;
+};
+
+// Per-signal hysteresis filter (GameStatePlugin.cfg: state_change_throttle_ms).
+// Raw values go in through update(); the filter emits at most one change per
+// minDwell window per signal and, with either edge, the last value always
+// comes out once the signal settles, so a burst like
+// inGame -> inReplay -> inGame -> inReplay never leaves the receiver on a
+// stale state. Values equal to the last emitted one are never re-emitted.
+//
+// Timers live on the caller's TimerWheel, so thousands of signals cost O(1)
+// each. Same threading rules as the wheel: one thread only.
+class SignalDebouncer {
+public:
+    using SignalId = std::uint32_t;
+    using EmitCallback = std::function<void(SignalId signal, std::int64_t value)>;
+
+    SignalDebouncer(TimerWheel& wheel, EmitCallback onEmit);
+    ~SignalDebouncer();
+
+    // Policy for signals without their own
+    void setDefaultPolicy(const DebouncePolicy& policy) { defaultPolicy = policy; }
+    void setPolicy(SignalId signal, const DebouncePolicy& policy);
+
+    // Feed a raw value; may emit synchronously (leading edge)
+    void update(SignalId signal, std::int64_t value);
+
+    std::uint64_t getEmittedCount() const { return emittedCount; }
+    std::uint64_t getSuppressedCount() const { return suppressedCount; }
+
+private:
+    struct Signal {
+        DebouncePolicy policy;
+        bool hasEmitted = false;
+        std::int64_t lastEmitted = 0;
+        std::int64_t latest = 0;
+        TimerWheel::TimerId timer = 0;      // 0 = none pending
+    };
+
+    TimerWheel& wheel;
+    EmitCallback onEmit;
+    DebouncePolicy defaultPolicy;
+    std::unordered_map<SignalId, Signal> signals;
+    std::uint64_t emittedCount;
+    std::uint64_t suppressedCount;
+
+    Signal& getSignal(SignalId id);
+    void emit(SignalId id, Signal& signal, std::int64_t value);
+    void onTimer(SignalId id);
+
+    // Disable copying
+    SignalDebouncer(const SignalDebouncer&) = delete;
+    SignalDebouncer& operator=(const SignalDebouncer&) = delete;
+};
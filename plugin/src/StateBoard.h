@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Layout of the "latest state" board: one shared-memory page holding the
+// current StateBoardSnapshot behind a seqlock. The plugin is the only
+// writer; any number of readers (overlays, OBS scripts, the desktop app)
+// copy it out without locks or a connection, and never slow the writer.
+//
+// The snapshot is stored as relaxed atomic 64-bit words so a reader racing
+// the writer reads stale or mixed words, never undefined bytes; the
+// sequence check then throws the mixed copy away.
+
+constexpr std::uint32_t kStateBoardMagic = 0x47534253;  // "SBSG"
+constexpr std::uint32_t kStateBoardVersion = 2;
+constexpr size_t kStateBoardPageSize = 4096;
+
+// Why the board was last published with a new event (lastEvent)
+enum class StateBoardEvent : std::uint32_t {
+    none,
+    stateChanged,
+    matchEnded,
+    replayStarted
+};
+
+constexpr std::uint32_t kStateBoardOvertime = 1u << 0;
+
+struct StateBoardSnapshot {
+    std::uint32_t state;            // GameState value
+    std::uint32_t lastEvent;        // StateBoardEvent
+    std::int64_t stateSinceMs;      // Unix ms of the last state change
+    std::int64_t updatedAtMs;       // Unix ms of this snapshot
+    std::int64_t lastEventAtMs;     // Unix ms of lastEvent
+    std::int32_t blueScore;
+    std::int32_t orangeScore;
+    std::int32_t secondsRemaining;  // -1 outside a match
+    std::uint32_t flags;            // kStateBoardOvertime
+    std::uint32_t phase;            // MatchPhase value
+    std::uint32_t reserved;
+    std::uint64_t publishCount;     // snapshots published since load
+};
+
+static_assert(std::is_trivially_copyable<StateBoardSnapshot>::value, "snapshot is copied word by word");
+static_assert(sizeof(StateBoardSnapshot) % sizeof(std::uint64_t) == 0, "snapshot must be whole words");
+
+constexpr size_t kStateBoardWords = sizeof(StateBoardSnapshot) / sizeof(std::uint64_t);
+
+struct StateBoardPage {
+    std::atomic<std::uint32_t> magic;       // written last by the plugin
+    std::uint32_t version;
+    std::atomic<std::uint32_t> producerClosed;
+
+    // Odd while the writer is inside an update
+    alignas(64) std::atomic<std::uint64_t> sequence;
+    std::atomic<std::uint64_t> words[kStateBoardWords];
+};
+
+static_assert(sizeof(StateBoardPage) <= kStateBoardPageSize, "state board does not fit its page");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "state board words must be lock-free");
+
+// Writer side; single writer only
+inline void storeStateBoard(StateBoardPage& page, const StateBoardSnapshot& snapshot) {
+    std::uint64_t source[kStateBoardWords];
+    std::memcpy(source, &snapshot, sizeof(source));
+
+    std::uint64_t sequence = page.sequence.load(std::memory_order_relaxed);
+    page.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (size_t i = 0; i < kStateBoardWords; ++i) {
+        page.words[i].store(source[i], std::memory_order_relaxed);
+    }
+
+    page.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+// One read attempt; false if the writer was mid-update
+inline bool tryLoadStateBoard(const StateBoardPage& page, StateBoardSnapshot& snapshot) {
+    std::uint64_t before = page.sequence.load(std::memory_order_acquire);
+    if (before & 1) {
+        return false;
+    }
+
+    std::uint64_t copy[kStateBoardWords];
+    for (size_t i = 0; i < kStateBoardWords; ++i) {
+        copy[i] = page.words[i].load(std::memory_order_relaxed);
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (page.sequence.load(std::memory_order_relaxed) != before) {
+        return false;
+    }
+
+    std::memcpy(&snapshot, copy, sizeof(copy));
+    return true;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "StateBoard.h"
+#include "SharedMemory.h"
+#include <string>
+
+// Reader for the state board, for overlays and other local tools. Header
+// only; link GameStateShmReader for SharedMemoryRegion.
+//
+//   StateBoardReader board;
+//   StateBoardSnapshot snapshot;
+//   if (board.open("TTLxRL_StateBoard") && board.read(snapshot)) {
+//       // snapshot.state, snapshot.blueScore, ...
+//   }
+//
+// read() never blocks and never affects the plugin; poll it as often as
+// the tool redraws.
+class StateBoardReader {
+public:
+    StateBoardReader() : page(nullptr) {}
+    ~StateBoardReader() { close(); }
+
+    // Map the board the plugin created; fails until the plugin is loaded
+    bool open(const std::string& name) {
+        close();
+
+        if (!region.open(name) || region.size() < sizeof(StateBoardPage)) {
+            region.close();
+            return false;
+        }
+
+        StateBoardPage* mapped = static_cast<StateBoardPage*>(region.data());
+        if (mapped->magic.load(std::memory_order_acquire) != kStateBoardMagic ||
+            mapped->version != kStateBoardVersion) {
+            region.close();
+            return false;
+        }
+
+        page = mapped;
+        return true;
+    }
+
+    void close() {
+        region.close();
+        page = nullptr;
+    }
+
+    bool isOpen() const { return page != nullptr; }
+
+    // Copy the latest snapshot. Retries while the plugin is mid-update;
+    // returns false only if every attempt raced a write (or not open).
+    bool read(StateBoardSnapshot& snapshot, int maxAttempts = 64) const {
+        if (!page) {
+            return false;
+        }
+        for (int attempt = 0; attempt < maxAttempts; ++attempt) {
+            if (tryLoadStateBoard(*page, snapshot)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // The plugin unloaded; close() and open() again to follow a new instance
+    bool isProducerClosed() const {
+        return page && page->producerClosed.load(std::memory_order_acquire) != 0;
+    }
+
+private:
+    SharedMemoryRegion region;
+    const StateBoardPage* page;
+
+    // Disable copying
+    StateBoardReader(const StateBoardReader&) = delete;
+    StateBoardReader& operator=(const StateBoardReader&) = delete;
+};
@@ -0,0 +1,50 @@
+#include "StateBoardWriter.h"
+#include <new>
+
+StateBoardWriter::StateBoardWriter()
+    : page(nullptr), publishCount(0) {
+}
+
+StateBoardWriter::~StateBoardWriter() {
+    close();
+}
+
+bool StateBoardWriter::create(const std::string& name) {
+    close();
+
+    if (!region.create(name, kStateBoardPageSize)) {
+        return false;
+    }
+
+    // Fresh mapping: construct in place with an all-zero snapshot, publish
+    // magic last so a reader never maps a half-initialized board
+    page = new (region.data()) StateBoardPage();
+    page->version = kStateBoardVersion;
+    page->producerClosed.store(0, std::memory_order_relaxed);
+    page->sequence.store(0, std::memory_order_relaxed);
+    for (size_t i = 0; i < kStateBoardWords; ++i) {
+        page->words[i].store(0, std::memory_order_relaxed);
+    }
+
+    publishCount = 0;
+    page->magic.store(kStateBoardMagic, std::memory_order_release);
+    return true;
+}
+
+void StateBoardWriter::close() {
+    if (page) {
+        page->producerClosed.store(1, std::memory_order_release);
+    }
+    region.close();
+    page = nullptr;
+}
+
+void StateBoardWriter::publish(const StateBoardSnapshot& snapshot) {
+    if (!page) {
+        return;
+    }
+
+    StateBoardSnapshot stamped = snapshot;
+    stamped.publishCount = ++publishCount;
+    storeStateBoard(*page, stamped);
+}
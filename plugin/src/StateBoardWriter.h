@@ -0,0 +1,35 @@
+#pragma once
+
+#include "StateBoard.h"
+#include "SharedMemory.h"
+#include <string>
+
+// Plugin side of the state board (GameStatePlugin.cfg: state_board_enabled).
+// Creates the page and publishes whole snapshots; readers use
+// StateBoardReader.h.
+//
+// Single writer: publish() must only be called from one thread (the game
+// thread).
+class StateBoardWriter {
+public:
+    StateBoardWriter();
+    ~StateBoardWriter();
+
+    bool create(const std::string& name);
+    void close();
+    bool isOpen() const { return page != nullptr; }
+
+    // Publish `snapshot` as the latest board; fills in publishCount
+    void publish(const StateBoardSnapshot& snapshot);
+
+    std::uint64_t getPublishCount() const { return publishCount; }
+
+private:
+    SharedMemoryRegion region;
+    StateBoardPage* page;
+    std::uint64_t publishCount;
+
+    // Disable copying
+    StateBoardWriter(const StateBoardWriter&) = delete;
+    StateBoardWriter& operator=(const StateBoardWriter&) = delete;
+};
@@ -0,0 +1,268 @@
+#include "TelemetryCodec.h"
+#include "WireProtocol.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// Largest smallest-three component is 1/sqrt(2)
+static const float kQuatScale = (float)kTelemetryQuatMax * 1.41421356f;
+
+// Round half away from zero; std::lround is a libm call and dominates the
+// encoder otherwise
+static std::int32_t roundToInt(float value) {
+    return (std::int32_t)(value < 0.0f ? value - 0.5f : value + 0.5f);
+}
+
+static std::int32_t quantize(float value, float scale, float limit) {
+    float clamped = std::min(std::max(value, -limit), limit);
+    return roundToInt(clamped * scale);
+}
+
+static std::uint32_t zigzag(std::int32_t value) {
+    return ((std::uint32_t)value << 1) ^ (std::uint32_t)(value >> 31);
+}
+
+static std::int32_t unzigzag(std::uint32_t value) {
+    return (std::int32_t)(value >> 1) ^ -(std::int32_t)(value & 1);
+}
+
+// LEB128 varint, at most 10 bytes; false if truncated or too long
+static bool readVarint(const char* data, size_t length, size_t& pos, std::uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos >= length) return false;
+        std::uint8_t byte = (std::uint8_t)data[pos++];
+        value |= (std::uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+static std::int64_t toTimeMs(float seconds) {
+    return (std::int64_t)std::llround((double)seconds * 1000.0);
+}
+
+void quantizeTelemetryEntity(const TelemetryFrame& frame, size_t entity, TelemetryQuantized& out) {
+    const TelemetryBody& body = frame.bodies[entity];
+
+    for (int axis = 0; axis < 3; ++axis) {
+        out[(size_t)TelemetryField::locationX + axis] =
+            quantize(body.location[axis], kTelemetryLocationScale, kTelemetryArenaExtent[axis]);
+        out[(size_t)TelemetryField::velocityX + axis] =
+            quantize(body.velocity[axis], kTelemetryVelocityScale, kTelemetryMaxVelocity);
+        out[(size_t)TelemetryField::angularVelocityX + axis] =
+            quantize(body.angularVelocity[axis], kTelemetryAngularScale, kTelemetryMaxAngular);
+    }
+
+    // Smallest three: drop the largest component (recoverable from the unit
+    // norm) and flip the sign so the dropped one is positive
+    float q[4];
+    std::memcpy(q, body.quaternion, sizeof(q));
+    float norm = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    if (norm < 1e-6f) {
+        q[0] = 1.0f;
+        q[1] = q[2] = q[3] = 0.0f;
+        norm = 1.0f;
+    }
+
+    int largest = 0;
+    for (int i = 1; i < 4; ++i) {
+        if (std::fabs(q[i]) > std::fabs(q[largest])) largest = i;
+    }
+    float sign = q[largest] < 0.0f ? -1.0f : 1.0f;
+
+    out[(size_t)TelemetryField::rotationLargest] = largest;
+    size_t component = (size_t)TelemetryField::rotationA;
+    for (int i = 0; i < 4; ++i) {
+        if (i == largest) continue;
+        float value = sign * q[i] / norm;
+        out[component++] = std::min(std::max(roundToInt(value * kQuatScale),
+                                             -kTelemetryQuatMax), kTelemetryQuatMax);
+    }
+
+    out[(size_t)TelemetryField::boost] = roundToInt(std::min(std::max(frame.boost[entity], 0.0f), 100.0f) * 2.55f);
+    out[(size_t)TelemetryField::flags] = frame.flags[entity];
+    out[(size_t)TelemetryField::id] = (std::int32_t)frame.ids[entity];
+}
+
+void dequantizeTelemetryEntity(const TelemetryQuantized& in, size_t entity, TelemetryFrame& frame) {
+    TelemetryBody& body = frame.bodies[entity];
+
+    for (int axis = 0; axis < 3; ++axis) {
+        body.location[axis] = in[(size_t)TelemetryField::locationX + axis] / kTelemetryLocationScale;
+        body.velocity[axis] = in[(size_t)TelemetryField::velocityX + axis] / kTelemetryVelocityScale;
+        body.angularVelocity[axis] = in[(size_t)TelemetryField::angularVelocityX + axis] / kTelemetryAngularScale;
+    }
+
+    int largest = std::min(std::max(in[(size_t)TelemetryField::rotationLargest], 0), 3);
+    float sumSquares = 0.0f;
+    size_t component = (size_t)TelemetryField::rotationA;
+    for (int i = 0; i < 4; ++i) {
+        if (i == largest) continue;
+        float value = in[component++] / kQuatScale;
+        body.quaternion[i] = value;
+        sumSquares += value * value;
+    }
+    body.quaternion[largest] = std::sqrt(std::max(0.0f, 1.0f - sumSquares));
+
+    frame.boost[entity] = in[(size_t)TelemetryField::boost] / 2.55f;
+    frame.flags[entity] = (std::uint8_t)in[(size_t)TelemetryField::flags];
+    frame.ids[entity] = (std::uint32_t)in[(size_t)TelemetryField::id];
+}
+
+TelemetryEncoder::TelemetryEncoder(int keyframeInterval)
+    : keyframeInterval(std::max(1, keyframeInterval)), framesSinceKeyframe(0), keyframePending(true),
+      keyframes(0), previousFrame(0), previousTimeMs(0), previousPresent(0) {
+    std::memset(previous, 0, sizeof(previous));
+}
+
+size_t TelemetryEncoder::encode(const TelemetryFrame& frame, char* out) {
+    bool keyframe = keyframePending || ++framesSinceKeyframe >= keyframeInterval;
+    if (keyframe) {
+        keyframePending = false;
+        framesSinceKeyframe = 0;
+        ++keyframes;
+        previousFrame = 0;
+        previousTimeMs = 0;
+        previousPresent = 0;
+    }
+
+    size_t length = 0;
+    out[length++] = (char)(keyframe ? TelemetryFrameKind::keyframe : TelemetryFrameKind::delta);
+
+    std::int64_t timeMs = toTimeMs(frame.physicsTime);
+    if (keyframe) {
+        length += writeVarint(out + length, frame.physicsFrame);
+        length += writeVarint(out + length, zigzag((std::int32_t)timeMs));
+    } else {
+        length += writeVarint(out + length, zigzag((std::int32_t)(frame.physicsFrame - previousFrame)));
+        length += writeVarint(out + length, zigzag((std::int32_t)(timeMs - previousTimeMs)));
+    }
+    previousFrame = frame.physicsFrame;
+    previousTimeMs = timeMs;
+
+    std::uint32_t present = 0;
+    for (size_t entity = 0; entity < kTelemetryEntities; ++entity) {
+        if (frame.flags[entity] & kTelemetryPresent) present |= 1u << entity;
+    }
+    length += writeVarint(out + length, present);
+
+    for (size_t entity = 0; entity < kTelemetryEntities; ++entity) {
+        if (!(present & (1u << entity))) continue;
+
+        // Coded against zero when the entity just appeared
+        TelemetryQuantized& base = previous[entity];
+        if (!(previousPresent & (1u << entity))) {
+            std::memset(base, 0, sizeof(base));
+        }
+
+        TelemetryQuantized current;
+        quantizeTelemetryEntity(frame, entity, current);
+
+        std::uint32_t deltas[kTelemetryFieldCount];
+        std::uint32_t changed = 0;
+        for (size_t field = 0; field < kTelemetryFieldCount; ++field) {
+            deltas[field] = zigzag((std::int32_t)((std::uint32_t)current[field] - (std::uint32_t)base[field]));
+            if (deltas[field]) changed |= 1u << field;
+        }
+
+        length += writeVarint(out + length, changed);
+        for (size_t field = 0; field < kTelemetryFieldCount; ++field) {
+            if (changed & (1u << field)) {
+                length += writeVarint(out + length, deltas[field]);
+            }
+        }
+
+        std::memcpy(base, current, sizeof(base));
+    }
+
+    previousPresent = present;
+    return length;
+}
+
+TelemetryDecoder::TelemetryDecoder()
+    : synced(false), previousFrame(0), previousTimeMs(0), previousPresent(0) {
+    std::memset(previous, 0, sizeof(previous));
+}
+
+bool TelemetryDecoder::decode(const char* data, size_t length, TelemetryFrame& frame) {
+    if (length < 1) return false;
+
+    size_t pos = 0;
+    auto kind = (TelemetryFrameKind)data[pos++];
+    bool keyframe = kind == TelemetryFrameKind::keyframe;
+    if (!keyframe && (kind != TelemetryFrameKind::delta || !synced)) {
+        return false;
+    }
+    if (keyframe) {
+        previousFrame = 0;
+        previousTimeMs = 0;
+        previousPresent = 0;
+    }
+
+    // Decode into locals; the state only advances once the frame is whole
+    std::uint64_t frameField, timeField, present;
+    if (!readVarint(data, length, pos, frameField) ||
+        !readVarint(data, length, pos, timeField) ||
+        !readVarint(data, length, pos, present) ||
+        present >> kTelemetryEntities) {
+        synced = false;
+        return false;
+    }
+
+    std::uint64_t physicsFrame = keyframe ? frameField
+                                          : previousFrame + (std::int64_t)unzigzag((std::uint32_t)frameField);
+    std::int64_t timeMs = (keyframe ? 0 : previousTimeMs) + unzigzag((std::uint32_t)timeField);
+
+    TelemetryQuantized decoded[kTelemetryEntities];
+    for (size_t entity = 0; entity < kTelemetryEntities; ++entity) {
+        if (!(present & (1u << entity))) continue;
+
+        if (previousPresent & (1u << entity)) {
+            std::memcpy(decoded[entity], previous[entity], sizeof(decoded[entity]));
+        } else {
+            std::memset(decoded[entity], 0, sizeof(decoded[entity]));
+        }
+
+        std::uint64_t changed;
+        if (!readVarint(data, length, pos, changed) || changed >> kTelemetryFieldCount) {
+            synced = false;
+            return false;
+        }
+        for (size_t field = 0; field < kTelemetryFieldCount; ++field) {
+            if (!(changed & (1u << field))) continue;
+            std::uint64_t delta;
+            if (!readVarint(data, length, pos, delta)) {
+                synced = false;
+                return false;
+            }
+            decoded[entity][field] = (std::int32_t)((std::uint32_t)decoded[entity][field] +
+                                                    (std::uint32_t)unzigzag((std::uint32_t)delta));
+        }
+    }
+
+    if (pos != length) {
+        synced = false;
+        return false;
+    }
+
+    frame.physicsFrame = physicsFrame;
+    frame.physicsTime = (float)((double)timeMs / 1000.0);
+    for (size_t entity = 0; entity < kTelemetryEntities; ++entity) {
+        if (present & (1u << entity)) {
+            std::memcpy(previous[entity], decoded[entity], sizeof(previous[entity]));
+            dequantizeTelemetryEntity(decoded[entity], entity, frame);
+        } else {
+            frame.bodies[entity] = TelemetryBody();
+            frame.boost[entity] = 0.0f;
+            frame.flags[entity] = 0;
+            frame.ids[entity] = 0;
+        }
+    }
+
+    previousFrame = physicsFrame;
+    previousTimeMs = timeMs;
+    previousPresent = (std::uint32_t)present;
+    synced = true;
+    return true;
+}
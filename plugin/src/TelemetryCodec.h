@@ -0,0 +1,112 @@
+#pragma once
+
+#include "TelemetryRing.h"
+#include <cstddef>
+#include <cstdint>
+
+// Compact encoding of TelemetryFrame for streaming over loopback.
+//
+// Every field is quantized to an integer first:
+//
+//   location          1/50 uu, clamped to the arena box (kTelemetryArenaExtent)
+//   velocity          0.1 uu/s, clamped to +-8192 uu/s
+//   angular velocity  0.001 rad/s, clamped to +-8 rad/s
+//   rotation          smallest three: index of the largest component, then
+//                     the other three scaled to +-kTelemetryQuatMax
+//   boost             0-255 (boost * 2.55)
+//   flags, id         as is
+//
+// and then delta-coded against the same entity in the previous frame. A
+// frame is:
+//
+//   u8      kind (TelemetryFrameKind)
+//   varint  physics frame: absolute in a keyframe, zigzag delta otherwise
+//   varint  physics time in ms, same rule
+//   varint  mask of present entities (bit 0 = ball)
+//   per present entity:
+//     varint  mask of fields whose delta is not zero (TelemetryField order)
+//     zigzag varint per set bit
+//
+// A keyframe deltas against zero, so it is decodable on its own; the encoder
+// sends one every keyframeInterval frames and whenever requestKeyframe() is
+// called (a new consumer, a decode error on the other end). An entity that
+// was absent in the previous frame is also coded against zero.
+
+enum class TelemetryFrameKind : std::uint8_t {
+    keyframe = 0,
+    delta = 1
+};
+
+// Quantized fields of one entity, in wire order
+enum class TelemetryField : std::uint8_t {
+    locationX, locationY, locationZ,
+    velocityX, velocityY, velocityZ,
+    angularVelocityX, angularVelocityY, angularVelocityZ,
+    rotationLargest, rotationA, rotationB, rotationC,
+    boost, flags, id,
+    count
+};
+
+constexpr size_t kTelemetryFieldCount = (size_t)TelemetryField::count;
+
+// Half extents of the box positions are clamped to (walls plus goal depth)
+constexpr float kTelemetryArenaExtent[3] = {4608.0f, 6144.0f, 2304.0f};
+constexpr float kTelemetryLocationScale = 50.0f;
+constexpr float kTelemetryVelocityScale = 10.0f;
+constexpr float kTelemetryMaxVelocity = 8192.0f;
+constexpr float kTelemetryAngularScale = 1000.0f;
+constexpr float kTelemetryMaxAngular = 8.0f;
+constexpr std::int32_t kTelemetryQuatMax = 16383;
+
+// Header plus every entity with every field at its longest (5-byte varints)
+constexpr size_t kMaxTelemetryFrameSize = 1 + 10 + 10 + 2 + kTelemetryEntities * (3 + kTelemetryFieldCount * 5);
+
+using TelemetryQuantized = std::int32_t[kTelemetryFieldCount];
+
+// Quantize one entity, or restore it; exposed for error measurements
+void quantizeTelemetryEntity(const TelemetryFrame& frame, size_t entity, TelemetryQuantized& out);
+void dequantizeTelemetryEntity(const TelemetryQuantized& in, size_t entity, TelemetryFrame& frame);
+
+class TelemetryEncoder {
+public:
+    explicit TelemetryEncoder(int keyframeInterval = 120);
+
+    // Encode `frame` into `out` (at least kMaxTelemetryFrameSize bytes).
+    // Returns the number of bytes written.
+    size_t encode(const TelemetryFrame& frame, char* out);
+
+    // Make the next frame a keyframe
+    void requestKeyframe() { keyframePending = true; }
+
+    std::uint64_t getKeyframeCount() const { return keyframes; }
+
+private:
+    int keyframeInterval;
+    int framesSinceKeyframe;
+    bool keyframePending;
+    std::uint64_t keyframes;
+
+    std::uint64_t previousFrame;
+    std::int64_t previousTimeMs;
+    std::uint32_t previousPresent;
+    TelemetryQuantized previous[kTelemetryEntities];
+};
+
+class TelemetryDecoder {
+public:
+    TelemetryDecoder();
+
+    // Decode one frame. Returns false on malformed input and for delta
+    // frames until a keyframe has been seen; ask the encoder for a keyframe
+    // then.
+    bool decode(const char* data, size_t length, TelemetryFrame& frame);
+
+    bool isSynced() const { return synced; }
+
+private:
+    bool synced;
+    std::uint64_t previousFrame;
+    std::int64_t previousTimeMs;
+    std::uint32_t previousPresent;
+    TelemetryQuantized previous[kTelemetryEntities];
+};
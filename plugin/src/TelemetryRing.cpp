@@ -0,0 +1,146 @@
+#include "TelemetryRing.h"
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+static const size_t kMinTelemetryFrames = 16;
+static const std::align_val_t kTelemetryAlignment{64};
+
+static size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+TelemetryRing::TelemetryRing(size_t capacityFrames)
+    : capacity(roundUpToPowerOfTwo(std::max(capacityFrames, kMinTelemetryFrames))),
+      mask(capacity - 1), writeSlot(0), frameCount(0) {
+    size_t floatBytes = kTelemetryEntities * kTelemetryFloatColumns * capacity * sizeof(float);
+    size_t frameBytes = capacity * (sizeof(std::uint64_t) + sizeof(float));
+    size_t idBytes = kTelemetryEntities * capacity * sizeof(std::uint32_t);
+    size_t flagBytes = kTelemetryEntities * capacity;
+
+    char* base = static_cast<char*>(::operator new(floatBytes + frameBytes + idBytes + flagBytes, kTelemetryAlignment));
+    storage = base;
+
+    // Each block is a multiple of 64 bytes (capacity >= 16), so every
+    // column stays aligned
+    floats = reinterpret_cast<float*>(base);
+    frameNumbers = reinterpret_cast<std::uint64_t*>(base + floatBytes);
+    frameTimes = reinterpret_cast<float*>(base + floatBytes + capacity * sizeof(std::uint64_t));
+    entityIds = reinterpret_cast<std::uint32_t*>(base + floatBytes + frameBytes);
+    entityFlags = reinterpret_cast<std::uint8_t*>(base + floatBytes + frameBytes + idBytes);
+
+    std::memset(base, 0, floatBytes + frameBytes + idBytes + flagBytes);
+}
+
+TelemetryRing::~TelemetryRing() {
+    ::operator delete(storage, kTelemetryAlignment);
+}
+
+void TelemetryRing::beginFrame(std::uint64_t physicsFrame, float physicsTime) {
+    writeSlot = (size_t)(frameCount.load(std::memory_order_relaxed) & mask);
+    frameNumbers[writeSlot] = physicsFrame;
+    frameTimes[writeSlot] = physicsTime;
+
+    for (size_t entity = 0; entity < kTelemetryEntities; ++entity) {
+        entityFlags[entity * capacity + writeSlot] = 0;
+    }
+}
+
+void TelemetryRing::setEntity(size_t entity, const TelemetryBody& body, float boost,
+                              std::uint8_t entityFlagBits, std::uint32_t id) {
+    if (entity >= kTelemetryEntities) return;
+
+    const float values[kTelemetryFloatColumns] = {
+        body.location[0], body.location[1], body.location[2],
+        body.velocity[0], body.velocity[1], body.velocity[2],
+        body.angularVelocity[0], body.angularVelocity[1], body.angularVelocity[2],
+        body.quaternion[0], body.quaternion[1], body.quaternion[2], body.quaternion[3],
+        boost
+    };
+
+    float* entityColumns = floats + entity * kTelemetryFloatColumns * capacity;
+    for (size_t field = 0; field < kTelemetryFloatColumns; ++field) {
+        entityColumns[field * capacity + writeSlot] = values[field];
+    }
+
+    entityIds[entity * capacity + writeSlot] = id;
+    entityFlags[entity * capacity + writeSlot] = entityFlagBits | kTelemetryPresent;
+}
+
+void TelemetryRing::commitFrame() {
+    frameCount.store(frameCount.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+std::uint64_t TelemetryRing::getOldestFrame() const {
+    std::uint64_t count = getFrameCount();
+    return count >= capacity ? count - capacity + 1 : 0;
+}
+
+const float* TelemetryRing::column(size_t entity, TelemetryColumn field) const {
+    return columnAt(entity, field);
+}
+
+const std::uint8_t* TelemetryRing::flags(size_t entity) const {
+    return entityFlags + entity * capacity;
+}
+
+const std::uint32_t* TelemetryRing::ids(size_t entity) const {
+    return entityIds + entity * capacity;
+}
+
+bool TelemetryRing::readFrame(std::uint64_t frame, TelemetryFrame& out) const {
+    std::uint64_t end = frameCount.load(std::memory_order_relaxed);
+    if (frame >= end || frame + capacity <= end) return false;
+
+    size_t slot = (size_t)(frame & mask);
+    out.physicsFrame = frameNumbers[slot];
+    out.physicsTime = frameTimes[slot];
+
+    for (size_t entity = 0; entity < kTelemetryEntities; ++entity) {
+        const float* entityColumns = floats + entity * kTelemetryFloatColumns * capacity + slot;
+        float values[kTelemetryFloatColumns];
+        for (size_t field = 0; field < kTelemetryFloatColumns; ++field) {
+            values[field] = entityColumns[field * capacity];
+        }
+
+        TelemetryBody& body = out.bodies[entity];
+        std::memcpy(body.location, values, sizeof(body.location));
+        std::memcpy(body.velocity, values + 3, sizeof(body.velocity));
+        std::memcpy(body.angularVelocity, values + 6, sizeof(body.angularVelocity));
+        std::memcpy(body.quaternion, values + 9, sizeof(body.quaternion));
+        out.boost[entity] = values[(size_t)TelemetryColumn::boost];
+        out.flags[entity] = entityFlags[entity * capacity + slot];
+        out.ids[entity] = entityIds[entity * capacity + slot];
+    }
+
+    return true;
+}
+
+size_t TelemetryRing::copyColumn(size_t entity, TelemetryColumn field, std::uint64_t first,
+                                 size_t count, float* out) const {
+    if (entity >= kTelemetryEntities || field >= TelemetryColumn::count) return 0;
+
+    std::uint64_t end = getFrameCount();
+    if (first >= end) return 0;
+    if (first + capacity <= end) return 0;     // already overwritten
+    count = (size_t)std::min<std::uint64_t>(count, end - first);
+
+    // Up to two runs: slot..capacity, then 0..
+    const float* source = columnAt(entity, field);
+    size_t slot = (size_t)(first & mask);
+    size_t run = std::min(count, capacity - slot);
+    std::memcpy(out, source + slot, run * sizeof(float));
+    std::memcpy(out + run, source, (count - run) * sizeof(float));
+
+    // The writer may have lapped us while copying; the slot it is filling
+    // now is frame `after`, which overwrote frame after - capacity
+    std::atomic_thread_fence(std::memory_order_acquire);
+    std::uint64_t after = frameCount.load(std::memory_order_relaxed);
+    if (first + capacity <= after) return 0;
+
+    return count;
+}
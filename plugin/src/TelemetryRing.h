@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Fixed-capacity ring of physics frames stored as a structure of arrays:
+// every entity (ball, cars) has one contiguous column per field, so a
+// consumer that processes, say, ball height over the last second reads a
+// single run of floats instead of striding through frame records.
+//
+// Single writer (the game thread, PhysicsSampler). Frame n lives at slot
+// n & (capacity - 1) until it is overwritten capacity frames later. Readers
+// on other threads use copyColumn, which detects frames overwritten while
+// they were being copied.
+
+// Entity 0 is the ball, 1..kTelemetryMaxCars are car slots
+constexpr size_t kTelemetryMaxCars = 8;
+constexpr size_t kTelemetryEntities = 1 + kTelemetryMaxCars;
+constexpr size_t kTelemetryBall = 0;
+
+// Float columns of each entity
+enum class TelemetryColumn : std::uint8_t {
+    locationX, locationY, locationZ,
+    velocityX, velocityY, velocityZ,
+    angularVelocityX, angularVelocityY, angularVelocityZ,
+    quaternionW, quaternionX, quaternionY, quaternionZ,
+    boost,          // 0-100; always 0 for the ball
+    count
+};
+
+constexpr size_t kTelemetryFloatColumns = (size_t)TelemetryColumn::count;
+
+// Per-entity flags column
+constexpr std::uint8_t kTelemetryPresent = 1u << 0;    // entity was sampled this frame
+constexpr std::uint8_t kTelemetryOnGround = 1u << 1;   // cars: all wheels can drive
+constexpr std::uint8_t kTelemetrySleeping = 1u << 2;   // rigid body at rest
+
+// One entity's rigid body state for a frame, in column order
+struct TelemetryBody {
+    float location[3] = {};
+    float velocity[3] = {};
+    float angularVelocity[3] = {};
+    float quaternion[4] = {1.0f, 0.0f, 0.0f, 0.0f};     // W, X, Y, Z
+};
+
+// One frame gathered across the columns (row form), for encoding
+struct TelemetryFrame {
+    std::uint64_t physicsFrame = 0;
+    float physicsTime = 0.0f;
+    TelemetryBody bodies[kTelemetryEntities];
+    float boost[kTelemetryEntities] = {};
+    std::uint8_t flags[kTelemetryEntities] = {};    // kTelemetryPresent clear = absent
+    std::uint32_t ids[kTelemetryEntities] = {};
+};
+
+class TelemetryRing {
+public:
+    // Capacity is rounded up to a power of two, at least 16 frames so every
+    // column starts on a cache line
+    explicit TelemetryRing(size_t capacityFrames);
+    ~TelemetryRing();
+
+    size_t getCapacity() const { return capacity; }
+
+    // Writer side: beginFrame, setEntity for each sampled entity, commitFrame.
+    // Entities not set in a frame keep flags 0 (absent).
+    void beginFrame(std::uint64_t physicsFrame, float physicsTime);
+    void setEntity(size_t entity, const TelemetryBody& body, float boost, std::uint8_t flags, std::uint32_t id);
+    void commitFrame();
+
+    // Frames committed since creation. Frames [getOldestFrame(), getFrameCount())
+    // are readable; the slot after the newest may be mid-write.
+    std::uint64_t getFrameCount() const { return frameCount.load(std::memory_order_acquire); }
+    std::uint64_t getOldestFrame() const;
+
+    // Raw columns, `capacity` entries each, indexed by frame & (capacity - 1).
+    // Only safe on the writer thread or while the writer is stopped.
+    const float* column(size_t entity, TelemetryColumn field) const;
+    const std::uint8_t* flags(size_t entity) const;
+    const std::uint32_t* ids(size_t entity) const;     // PRI player id, 0 for the ball
+    const std::uint64_t* physicsFrames() const { return frameNumbers; }
+    const float* physicsTimes() const { return frameTimes; }
+
+    // Gather frame `frame` into row form; false if it is not in the ring.
+    // Writer thread only, like the raw columns.
+    bool readFrame(std::uint64_t frame, TelemetryFrame& out) const;
+
+    // Copy `count` frames of one column starting at frame `first`, unwrapped,
+    // from any thread. Returns the frames copied (fewer if the ring does not
+    // have them yet), or 0 if `first` was overwritten before or during the
+    // copy; restart from getOldestFrame() in that case.
+    size_t copyColumn(size_t entity, TelemetryColumn field, std::uint64_t first, size_t count, float* out) const;
+
+private:
+    size_t capacity;
+    size_t mask;
+
+    // One allocation, 64-byte aligned: float columns, then frame numbers,
+    // times, ids and flags
+    void* storage;
+    float* floats;                  // [entity][column][slot]
+    std::uint64_t* frameNumbers;    // [slot]
+    float* frameTimes;              // [slot]
+    std::uint32_t* entityIds;       // [entity][slot]
+    std::uint8_t* entityFlags;      // [entity][slot]
+
+    size_t writeSlot;
+    std::atomic<std::uint64_t> frameCount;
+
+    float* columnAt(size_t entity, TelemetryColumn field) const {
+        return floats + (entity * kTelemetryFloatColumns + (size_t)field) * capacity;
+    }
+
+    // Disable copying
+    TelemetryRing(const TelemetryRing&) = delete;
+    TelemetryRing& operator=(const TelemetryRing&) = delete;
+};
@@ -0,0 +1,187 @@
+#include "TickDispatcher.h"
+#include "Tracer.h"
+#include <algorithm>
+
+using DispatchClock = std::chrono::steady_clock;
+
+static const char* kPriorityNames[] = { "critical", "normal", "low" };
+
+TickDispatcher::TickDispatcher(const Clock& clock, std::chrono::microseconds frameBudget)
+    : clock(clock), profiler(nullptr), frameBudgetNs(frameBudget.count() * 1000), tickCount(0), framesOverBudget(0) {
+}
+
+TickDispatcher::SubscriberId TickDispatcher::subscribe(std::string name, TickCadence cadence, TickPriority priority,
+                                                       TickCallback callback, std::chrono::microseconds budget) {
+    auto subscriber = std::make_unique<Subscriber>();
+    subscriber->name = std::move(name);
+    subscriber->callback = std::move(callback);
+    subscriber->cadence = cadence;
+    subscriber->priority = priority;
+    subscriber->budgetNs = budget.count() * 1000;
+    if (profiler) {
+        subscriber->site = profiler->addSite(HookSiteKind::tick, subscriber->name);
+    }
+
+    // First run on the next tick, then every period
+    subscriber->due = cadence.unit == TickCadence::Unit::ticks ? (std::int64_t)tickCount + 1 : clock.now().count();
+
+    std::uint32_t index = (std::uint32_t)subscribers.size();
+    subscribers.push_back(std::move(subscriber));
+    schedule(index);
+    return index + 1;
+}
+
+bool TickDispatcher::unsubscribe(SubscriberId id) {
+    if (id == 0 || id > subscribers.size() || !subscribers[id - 1]->active) {
+        return false;
+    }
+
+    // Left in the schedule, and the callback alive in case it is the one
+    // running; both go when it next comes due
+    subscribers[id - 1]->active = false;
+    return true;
+}
+
+size_t TickDispatcher::getSubscriberCount() const {
+    return (size_t)std::count_if(subscribers.begin(), subscribers.end(),
+                                 [](const std::unique_ptr<Subscriber>& s) { return s->active; });
+}
+
+void TickDispatcher::onTick() {
+    ++tickCount;
+    std::int64_t nowMs = clock.now().count();
+    auto frameStart = DispatchClock::now();
+
+    dueScratch.clear();
+    popDue(tickSchedule, (std::int64_t)tickCount);
+    popDue(timeSchedule, nowMs);
+    if (dueScratch.empty()) return;
+
+    // Critical first; within a priority, in due order
+    std::stable_sort(dueScratch.begin(), dueScratch.end(), [this](std::uint32_t a, std::uint32_t b) {
+        return subscribers[a]->priority < subscribers[b]->priority;
+    });
+
+    bool overBudget = false;
+    auto runStart = frameStart;
+    for (std::uint32_t index : dueScratch) {
+        Subscriber& subscriber = *subscribers[index];
+        if (!subscriber.active) {
+            subscriber.callback = nullptr;
+            continue;
+        }
+
+        if (subscriber.priority != TickPriority::critical && frameBudgetNs > 0) {
+            std::int64_t spentNs = std::chrono::duration_cast<std::chrono::nanoseconds>(runStart - frameStart).count();
+            if (spentNs + subscriber.budgetNs > frameBudgetNs) {
+                overBudget = true;
+                if (subscriber.priority == TickPriority::low) {
+                    ++subscriber.skipped;
+                    reschedule(subscriber, nowMs);
+                    schedule(index);
+                    continue;
+                }
+                if (subscriber.deferrals < kMaxDeferrals) {
+                    // Still due, so it comes up again next tick
+                    ++subscriber.deferrals;
+                    ++subscriber.deferred;
+                    schedule(index);
+                    continue;
+                }
+            }
+        }
+
+        subscriber.deferrals = 0;
+        subscriber.callback();
+
+        auto runEnd = DispatchClock::now();
+        std::int64_t costNs = std::chrono::duration_cast<std::chrono::nanoseconds>(runEnd - runStart).count();
+        subscriber.cost.record((std::uint64_t)costNs);
+        if (subscriber.site) {
+            subscriber.site->record((std::uint64_t)costNs);
+        }
+        if (Tracer::isEnabled()) {
+            Tracer::complete(subscriber.name.c_str(), "tick", Tracer::toNs(runStart), Tracer::toNs(runEnd));
+        }
+        ++subscriber.runs;
+        if (subscriber.budgetNs > 0 && costNs > subscriber.budgetNs) {
+            ++subscriber.overBudget;
+        }
+        runStart = runEnd;
+
+        // The callback may have unsubscribed itself
+        if (subscriber.active) {
+            reschedule(subscriber, nowMs);
+            schedule(index);
+        } else {
+            subscriber.callback = nullptr;
+        }
+    }
+
+    std::int64_t frameNs = std::chrono::duration_cast<std::chrono::nanoseconds>(runStart - frameStart).count();
+    frameCost.record((std::uint64_t)frameNs);
+    if (overBudget || (frameBudgetNs > 0 && frameNs > frameBudgetNs)) {
+        ++framesOverBudget;
+    }
+}
+
+void TickDispatcher::schedule(std::uint32_t index) {
+    const Subscriber& subscriber = *subscribers[index];
+    auto& heap = subscriber.cadence.unit == TickCadence::Unit::ticks ? tickSchedule : timeSchedule;
+    heap.push_back({ subscriber.due, index });
+    std::push_heap(heap.begin(), heap.end(), dueLater);
+}
+
+// Next due time one period on; a subscriber that fell more than a period
+// behind (stalled frames, deferrals) resumes from now instead of catching up
+void TickDispatcher::reschedule(Subscriber& subscriber, std::int64_t nowMs) {
+    std::int64_t now = subscriber.cadence.unit == TickCadence::Unit::ticks ? (std::int64_t)tickCount : nowMs;
+    subscriber.due += subscriber.cadence.period;
+    if (subscriber.due <= now) {
+        subscriber.due = now + subscriber.cadence.period;
+    }
+}
+
+// Move every entry due at `now` into dueScratch, earliest first
+void TickDispatcher::popDue(std::vector<ScheduleEntry>& heap, std::int64_t now) {
+    while (!heap.empty() && heap.front().due <= now) {
+        std::pop_heap(heap.begin(), heap.end(), dueLater);
+        std::uint32_t index = heap.back().index;
+        heap.pop_back();
+        if (subscribers[index]->active) {
+            dueScratch.push_back(index);
+        } else {
+            subscribers[index]->callback = nullptr;
+        }
+    }
+}
+
+std::vector<std::string> TickDispatcher::describe() const {
+    std::vector<std::string> lines;
+    lines.push_back("Tick dispatcher: ticks " + std::to_string(tickCount) + ", frame budget " +
+                    (frameBudgetNs > 0 ? std::to_string(frameBudgetNs / 1000) + " us" : std::string("off")) +
+                    ", frames over budget " + std::to_string(framesOverBudget));
+    lines.push_back("Frame cost: p50 " + std::to_string(frameCost.percentile(0.50)) + " ns, p99 " +
+                    std::to_string(frameCost.percentile(0.99)) + " ns, max " + std::to_string(frameCost.getMax()) + " ns");
+
+    for (const auto& subscriber : subscribers) {
+        if (!subscriber->active) continue;
+
+        const TickCadence& cadence = subscriber->cadence;
+        std::string every = cadence.unit == TickCadence::Unit::ticks
+            ? std::to_string(cadence.period) + (cadence.period == 1 ? " tick" : " ticks")
+            : std::to_string(cadence.period) + " ms";
+        std::string line = "  " + subscriber->name + " (every " + every + ", " +
+                           kPriorityNames[(size_t)subscriber->priority] + "): runs " + std::to_string(subscriber->runs) +
+                           ", p50 " + std::to_string(subscriber->cost.percentile(0.50)) + " ns, p99 " +
+                           std::to_string(subscriber->cost.percentile(0.99)) + " ns";
+        if (subscriber->deferred > 0) line += ", deferred " + std::to_string(subscriber->deferred);
+        if (subscriber->skipped > 0) line += ", skipped " + std::to_string(subscriber->skipped);
+        if (subscriber->budgetNs > 0) {
+            line += ", over its " + std::to_string(subscriber->budgetNs / 1000) + " us " +
+                    std::to_string(subscriber->overBudget) + "x";
+        }
+        lines.push_back(line);
+    }
+    return lines;
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Clock.h"
+#include "HookProfiler.h"
+#include "LatencyHistogram.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// How often a subscriber runs: every N viewport ticks, or every N
+// milliseconds of wall time whatever the frame rate
+struct TickCadence {
+    enum class Unit : std::uint8_t { ticks, milliseconds };
+
+    Unit unit = Unit::ticks;
+    std::int64_t period = 1;
+
+    static TickCadence everyTick() { return { Unit::ticks, 1 }; }
+    static TickCadence everyTicks(std::int64_t ticks) { return { Unit::ticks, ticks > 0 ? ticks : 1 }; }
+    static TickCadence every(std::chrono::milliseconds interval) {
+        return { Unit::milliseconds, interval.count() > 0 ? interval.count() : 1 };
+    }
+};
+
+// What happens to a due subscriber once the frame budget is spent
+enum class TickPriority : std::uint8_t {
+    critical,   // always runs when due
+    normal,     // deferred to the next tick, at most kMaxDeferrals in a row
+    low         // skipped until its next period
+};
+
+// Owns the viewport tick for the whole plugin. The single
+// "Function Engine.GameViewportClient.Tick" hook calls onTick(); everything
+// that used to hook the tick itself subscribes here with a cadence and a
+// priority. Due subscribers come off a time-ordered schedule (one min-heap
+// for tick cadences, one for wall-time cadences) and run critical first,
+// then in due order.
+//
+// With a frame budget set, a non-critical subscriber only starts if what
+// the frame has spent so far plus its own budget (its expected cost per
+// run, 0 if not given) still fits; otherwise it is deferred or skipped as
+// its priority says. Budgets are measured on the steady clock, cadences on
+// the Clock passed in.
+//
+// Game thread only, like TimerWheel. Callbacks may subscribe and
+// unsubscribe.
+class TickDispatcher {
+public:
+    using SubscriberId = std::uint32_t;     // never 0
+    using TickCallback = std::function<void()>;
+
+    static constexpr int kMaxDeferrals = 4;
+
+    // frameBudget 0 = no budget, everything due runs
+    TickDispatcher(const Clock& clock, std::chrono::microseconds frameBudget = std::chrono::microseconds(0));
+
+    SubscriberId subscribe(std::string name, TickCadence cadence, TickPriority priority, TickCallback callback,
+                           std::chrono::microseconds budget = std::chrono::microseconds(0));
+    // Returns false if the id is unknown or already unsubscribed
+    bool unsubscribe(SubscriberId id);
+
+    // The tick hook body
+    void onTick();
+
+    void setFrameBudget(std::chrono::microseconds budget) { frameBudgetNs = budget.count() * 1000; }
+    // Subscribers added from now on also report their cost as tick sites
+    void setProfiler(HookProfiler* hookProfiler) { profiler = hookProfiler; }
+    std::uint64_t getTickCount() const { return tickCount; }
+    size_t getSubscriberCount() const;
+
+    // Frame cost, budget overruns and per-subscriber counters for the console
+    std::vector<std::string> describe() const;
+
+private:
+    struct Subscriber {
+        std::string name;
+        TickCallback callback;
+        TickCadence cadence;
+        TickPriority priority;
+        std::int64_t budgetNs;
+        std::int64_t due;               // tick number or milliseconds
+        bool active = true;
+        int deferrals = 0;              // in a row
+
+        std::uint64_t runs = 0;
+        std::uint64_t deferred = 0;
+        std::uint64_t skipped = 0;
+        std::uint64_t overBudget = 0;   // runs longer than budgetNs
+        LatencyHistogram cost;          // nanoseconds
+        HookSite* site = nullptr;       // same cost, in the profiler
+    };
+
+    struct ScheduleEntry {
+        std::int64_t due;
+        std::uint32_t index;
+    };
+
+    const Clock& clock;
+    HookProfiler* profiler;
+    std::int64_t frameBudgetNs;
+    std::uint64_t tickCount;
+    std::uint64_t framesOverBudget;
+    LatencyHistogram frameCost;         // nanoseconds, all subscribers
+
+    std::vector<std::unique_ptr<Subscriber>> subscribers;  // index = id - 1
+    std::vector<ScheduleEntry> tickSchedule;
+    std::vector<ScheduleEntry> timeSchedule;
+    std::vector<std::uint32_t> dueScratch;
+
+    // Min-heap order for std::push_heap / std::pop_heap; ties run in
+    // subscription order
+    static bool dueLater(const ScheduleEntry& a, const ScheduleEntry& b) {
+        return a.due != b.due ? a.due > b.due : a.index > b.index;
+    }
+
+    void schedule(std::uint32_t index);
+    void reschedule(Subscriber& subscriber, std::int64_t nowMs);
+    void popDue(std::vector<ScheduleEntry>& heap, std::int64_t now);
+
+    // Disable copying
+    TickDispatcher(const TickDispatcher&) = delete;
+    TickDispatcher& operator=(const TickDispatcher&) = delete;
+};
@@ -0,0 +1,149 @@
+#include "TimerWheel.h"
+
+TimerWheel::TimerWheel(std::chrono::milliseconds now, std::chrono::milliseconds tickLength, size_t slotCount)
+    : tick(tickLength.count() > 0 ? tickLength : std::chrono::milliseconds(1)),
+      currentTick(0), originMs(now.count()), pendingCount(0) {
+    size_t slots = 1;
+    while (slots < slotCount) {
+        slots *= 2;
+    }
+    slotMask = slots - 1;
+    slotHeads.assign(slots, kNoNode);
+}
+
+TimerWheel::TimerId TimerWheel::addTimer(std::chrono::milliseconds delay, TimerCallback callback) {
+    // Whole ticks, rounded up, and at least one so a timer never fires in
+    // the advance() that is currently running it
+    std::int64_t delayMs = delay.count() > 0 ? delay.count() : 0;
+    std::uint64_t ticks = (std::uint64_t)((delayMs + tick.count() - 1) / tick.count());
+    if (ticks == 0) {
+        ticks = 1;
+    }
+
+    std::uint32_t index;
+    if (!freeNodes.empty()) {
+        index = freeNodes.back();
+        freeNodes.pop_back();
+    } else {
+        index = (std::uint32_t)nodes.size();
+        nodes.emplace_back();
+    }
+
+    Node& node = nodes[index];
+    node.callback = std::move(callback);
+    node.rounds = (ticks - 1) / (slotMask + 1);
+    node.slot = (std::uint32_t)((currentTick + ticks) & slotMask);
+    node.pending = true;
+
+    // Push onto the front of the slot's list
+    node.prev = kNoNode;
+    node.next = slotHeads[node.slot];
+    if (node.next != kNoNode) {
+        nodes[node.next].prev = index;
+    }
+    slotHeads[node.slot] = index;
+
+    ++pendingCount;
+    return makeId(index, node.generation);
+}
+
+bool TimerWheel::cancelTimer(TimerId id) {
+    Node* node = findPending(id);
+    if (!node) {
+        return false;
+    }
+
+    std::uint32_t index = (std::uint32_t)(id & 0xFFFFFFFFu);
+    unlink(index);
+    release(index);
+    return true;
+}
+
+size_t TimerWheel::advance(std::chrono::milliseconds now) {
+    std::int64_t elapsedMs = now.count() - originMs;
+    if (elapsedMs < 0) {
+        return 0;
+    }
+
+    std::uint64_t targetTick = (std::uint64_t)elapsedMs / (std::uint64_t)tick.count();
+    size_t fired = 0;
+
+    while (currentTick < targetTick) {
+        // Nothing pending: jump straight to the target
+        if (pendingCount == 0) {
+            currentTick = targetTick;
+            break;
+        }
+
+        ++currentTick;
+        std::uint32_t slot = (std::uint32_t)(currentTick & slotMask);
+
+        // Unlink what is due first, so callbacks can freely add or cancel
+        dueScratch.clear();
+        std::uint32_t index = slotHeads[slot];
+        while (index != kNoNode) {
+            Node& node = nodes[index];
+            std::uint32_t next = node.next;
+            if (node.rounds == 0) {
+                unlink(index);
+                dueScratch.push_back(makeId(index, node.generation));
+            } else {
+                --node.rounds;
+            }
+            index = next;
+        }
+
+        // Slot lists are LIFO; fire in the order the timers were added
+        for (size_t i = dueScratch.size(); i-- > 0;) {
+            TimerId id = dueScratch[i];
+            Node* node = findPending(id);
+            if (!node) {
+                continue;   // cancelled by an earlier callback
+            }
+
+            std::uint32_t nodeIndex = (std::uint32_t)(id & 0xFFFFFFFFu);
+            TimerCallback callback = std::move(node->callback);
+            release(nodeIndex);
+            ++fired;
+            callback();
+        }
+    }
+
+    return fired;
+}
+
+TimerWheel::Node* TimerWheel::findPending(TimerId id) {
+    std::uint32_t index = (std::uint32_t)(id & 0xFFFFFFFFu);
+    std::uint32_t generation = (std::uint32_t)(id >> 32);
+    if (index >= nodes.size()) {
+        return nullptr;
+    }
+
+    Node& node = nodes[index];
+    return node.pending && node.generation == generation ? &node : nullptr;
+}
+
+void TimerWheel::unlink(std::uint32_t index) {
+    Node& node = nodes[index];
+    if (node.prev != kNoNode) {
+        nodes[node.prev].next = node.next;
+    } else if (slotHeads[node.slot] == index) {
+        slotHeads[node.slot] = node.next;
+    }
+    if (node.next != kNoNode) {
+        nodes[node.next].prev = node.prev;
+    }
+    node.prev = kNoNode;
+    node.next = kNoNode;
+}
+
+void TimerWheel::release(std::uint32_t index) {
+    Node& node = nodes[index];
+    node.callback = nullptr;
+    node.pending = false;
+    if (++node.generation == 0) {
+        node.generation = 1;
+    }
+    freeNodes.push_back(index);
+    --pendingCount;
+}
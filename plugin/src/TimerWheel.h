@@ -0,0 +1,70 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Hashed timer wheel: a ring of slots, one per tick. A timer lands in the
+// slot of its expiry tick and carries the number of full revolutions still
+// to wait, so adding and cancelling are O(1) and advancing one tick only
+// visits that slot, however many timers are pending.
+//
+// Not thread-safe; owned and advanced by one thread (the game thread in the
+// plugin). Time only moves when advance() is called, which makes the wheel
+// deterministic under a VirtualClock.
+class TimerWheel {
+public:
+    using TimerId = std::uint64_t;     // never 0
+    using TimerCallback = std::function<void()>;
+
+    // `now` is the starting time; expiry is rounded up to whole ticks
+    TimerWheel(std::chrono::milliseconds now,
+               std::chrono::milliseconds tick = std::chrono::milliseconds(10),
+               size_t slotCount = 256);
+
+    // Run callback once, no earlier than `delay` after the current wheel time
+    TimerId addTimer(std::chrono::milliseconds delay, TimerCallback callback);
+    // Returns false if the timer already fired or was cancelled
+    bool cancelTimer(TimerId id);
+
+    // Move the wheel to `now`, firing every timer that came due, in expiry
+    // order. Callbacks may add or cancel timers. Returns the number fired.
+    size_t advance(std::chrono::milliseconds now);
+
+    size_t getPendingCount() const { return pendingCount; }
+    std::chrono::milliseconds getTick() const { return tick; }
+
+private:
+    static constexpr std::uint32_t kNoNode = 0xFFFFFFFFu;
+
+    struct Node {
+        TimerCallback callback;
+        std::uint64_t rounds = 0;
+        std::uint32_t generation = 1;  // never 0, so no id is 0
+        std::uint32_t slot = 0;
+        std::uint32_t prev = kNoNode;
+        std::uint32_t next = kNoNode;
+        bool pending = false;
+    };
+
+    std::chrono::milliseconds tick;
+    std::uint64_t slotMask;
+    std::uint64_t currentTick;
+    std::int64_t originMs;              // time of tick 0
+
+    std::vector<std::uint32_t> slotHeads;
+    std::vector<Node> nodes;            // pooled; ids are index + generation
+    std::vector<std::uint32_t> freeNodes;
+    std::vector<TimerId> dueScratch;
+    size_t pendingCount;
+
+    static TimerId makeId(std::uint32_t index, std::uint32_t generation) {
+        return ((TimerId)generation << 32) | index;
+    }
+
+    Node* findPending(TimerId id);
+    void unlink(std::uint32_t index);
+    void release(std::uint32_t index);
+};
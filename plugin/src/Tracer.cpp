@@ -0,0 +1,250 @@
+#include "Tracer.h"
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// One event; fields are relaxed atomics so a dump can read a slot the
+// owning thread is overwriting (that copy is thrown away, see copyRing)
+struct TraceEvent {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<const char*> category{nullptr};
+    std::atomic<std::int64_t> startNs{0};
+    std::atomic<std::int64_t> durationNs{0};   // -1 = instant
+    std::atomic<std::int64_t> value{0};
+};
+
+struct EventCopy {
+    const char* name;
+    const char* category;
+    std::int64_t startNs;
+    std::int64_t durationNs;
+    std::int64_t value;
+    std::uint32_t threadId;
+};
+
+// One thread's events; the thread is the only writer. head counts every
+// event ever written, so slot = head & mask and nothing is ever reset.
+struct TraceRing {
+    std::unique_ptr<TraceEvent[]> events;
+    size_t mask = 0;
+    std::atomic<std::uint64_t> head{0};
+    std::atomic<std::uint64_t> startedAt{0};    // head when tracing last started
+    std::atomic<const char*> threadName{nullptr};
+    std::uint32_t threadId = 0;
+};
+
+struct TracerState {
+    // Rings live as long as the process, like the logger's, so a thread's
+    // cached pointer never dangles
+    std::mutex ringsMutex;
+    std::vector<std::unique_ptr<TraceRing>> rings;
+    std::atomic<size_t> eventsPerThread{Tracer::kDefaultEventsPerThread};
+    std::atomic<std::int64_t> startedAtNs{0};
+
+    std::mutex dumpMutex;
+    std::thread dumpThread;
+    std::atomic<bool> dumping{false};
+
+    ~TracerState() {
+        if (dumpThread.joinable()) dumpThread.join();
+    }
+};
+
+TracerState& state() {
+    static TracerState instance;
+    return instance;
+}
+
+thread_local TraceRing* tlsRing = nullptr;
+thread_local const char* tlsThreadName = nullptr;
+
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+TraceRing* threadRing() {
+    if (!tlsRing) {
+        TracerState& s = state();
+        auto ring = std::make_unique<TraceRing>();
+        size_t capacity = roundUpToPowerOfTwo(std::max<size_t>(s.eventsPerThread.load(), 64));
+        ring->events = std::make_unique<TraceEvent[]>(capacity);
+        ring->mask = capacity - 1;
+        ring->threadName.store(tlsThreadName, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(s.ringsMutex);
+        ring->threadId = (std::uint32_t)s.rings.size() + 1;
+        s.rings.push_back(std::move(ring));
+        tlsRing = s.rings.back().get();
+    }
+    return tlsRing;
+}
+
+void push(const char* name, const char* category, std::int64_t startNs, std::int64_t durationNs, std::int64_t value) {
+    TraceRing* ring = threadRing();
+    std::uint64_t head = ring->head.load(std::memory_order_relaxed);
+    TraceEvent& event = ring->events[head & ring->mask];
+    event.name.store(name, std::memory_order_relaxed);
+    event.category.store(category, std::memory_order_relaxed);
+    event.startNs.store(startNs, std::memory_order_relaxed);
+    event.durationNs.store(durationNs, std::memory_order_relaxed);
+    event.value.store(value, std::memory_order_relaxed);
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+// Append the ring's events since start() to `out`. The owner may be
+// writing meanwhile: whatever it could have overwritten during the copy
+// (everything up to head - capacity, read again afterwards) is dropped.
+void copyRing(const TraceRing& ring, std::vector<EventCopy>& out) {
+    std::uint64_t capacity = ring.mask + 1;
+    std::uint64_t head = ring.head.load(std::memory_order_acquire);
+    std::uint64_t first = std::max(ring.startedAt.load(std::memory_order_relaxed),
+                                   head > capacity ? head - capacity : 0);
+
+    size_t base = out.size();
+    for (std::uint64_t i = first; i < head; ++i) {
+        const TraceEvent& event = ring.events[i & ring.mask];
+        out.push_back({ event.name.load(std::memory_order_relaxed), event.category.load(std::memory_order_relaxed),
+                        event.startNs.load(std::memory_order_relaxed), event.durationNs.load(std::memory_order_relaxed),
+                        event.value.load(std::memory_order_relaxed), ring.threadId });
+    }
+
+    std::uint64_t headAfter = ring.head.load(std::memory_order_acquire);
+    if (headAfter >= capacity && headAfter - capacity + 1 > first) {
+        size_t stale = (size_t)std::min<std::uint64_t>(headAfter - capacity + 1 - first, head - first);
+        out.erase(out.begin() + (std::ptrdiff_t)base, out.begin() + (std::ptrdiff_t)(base + stale));
+    }
+}
+
+struct ThreadInfo {
+    std::uint32_t threadId;
+    const char* name;
+};
+
+bool writeChromeJson(const std::string& path, const std::vector<EventCopy>& events,
+                     const std::vector<ThreadInfo>& threads, std::int64_t originNs) {
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) return false;
+
+    // ts and dur are microseconds; names are plain ASCII, nothing to escape
+    std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", file);
+    std::fputs("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"GameStatePlugin\"}}", file);
+    for (const ThreadInfo& thread : threads) {
+        char fallback[32];
+        if (!thread.name) snprintf(fallback, sizeof(fallback), "thread %u", (unsigned)thread.threadId);
+        std::fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                     (unsigned)thread.threadId, thread.name ? thread.name : fallback);
+    }
+
+    for (const EventCopy& event : events) {
+        if (!event.name) continue;
+        double ts = (double)(event.startNs - originNs) / 1000.0;
+        if (event.durationNs < 0) {
+            std::fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":1,\"tid\":%u",
+                         event.name, event.category ? event.category : "", ts, (unsigned)event.threadId);
+        } else {
+            std::fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u",
+                         event.name, event.category ? event.category : "", ts, (double)event.durationNs / 1000.0,
+                         (unsigned)event.threadId);
+        }
+        if (event.value != Tracer::kNoValue) {
+            std::fprintf(file, ",\"args\":{\"value\":%lld}}", (long long)event.value);
+        } else {
+            std::fputc('}', file);
+        }
+    }
+
+    std::fputs("\n]}\n", file);
+    bool ok = !std::ferror(file);
+    return std::fclose(file) == 0 && ok;
+}
+
+} // namespace
+
+std::atomic<bool> Tracer::enabled(false);
+
+void Tracer::start(size_t eventsPerThread) {
+    TracerState& s = state();
+    s.eventsPerThread.store(eventsPerThread);
+    s.startedAtNs.store(nowNs());
+    {
+        std::lock_guard<std::mutex> lock(s.ringsMutex);
+        for (const auto& ring : s.rings) {
+            ring->startedAt.store(ring->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+        }
+    }
+    enabled.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::stop() {
+    enabled.store(false, std::memory_order_relaxed);
+}
+
+void Tracer::setThreadName(const char* name) {
+    tlsThreadName = name;
+    if (tlsRing) {
+        tlsRing->threadName.store(name, std::memory_order_relaxed);
+    }
+}
+
+void Tracer::complete(const char* name, const char* category, std::int64_t startNs, std::int64_t endNs,
+                      std::int64_t value) {
+    push(name, category, startNs, endNs - startNs, value);
+}
+
+void Tracer::instant(const char* name, const char* category, std::int64_t value) {
+    push(name, category, nowNs(), -1, value);
+}
+
+bool Tracer::dump(const std::string& path, std::function<void(bool ok, size_t events)> done) {
+    TracerState& s = state();
+    std::lock_guard<std::mutex> dumpLock(s.dumpMutex);
+    if (s.dumping.load()) return false;
+    if (s.dumpThread.joinable()) s.dumpThread.join();
+
+    // The copy is the only part on the calling thread
+    std::vector<EventCopy> events;
+    std::vector<ThreadInfo> threads;
+    {
+        std::lock_guard<std::mutex> lock(s.ringsMutex);
+        for (const auto& ring : s.rings) {
+            copyRing(*ring, events);
+            threads.push_back({ ring->threadId, ring->threadName.load(std::memory_order_relaxed) });
+        }
+    }
+
+    s.dumping.store(true);
+    std::int64_t originNs = s.startedAtNs.load();
+    s.dumpThread = std::thread([path, done = std::move(done), events = std::move(events),
+                                threads = std::move(threads), originNs]() mutable {
+        // Perfetto does not need them sorted; people reading the file do
+        std::stable_sort(events.begin(), events.end(),
+                         [](const EventCopy& a, const EventCopy& b) { return a.startNs < b.startNs; });
+        bool ok = writeChromeJson(path, events, threads, originNs);
+        if (done) done(ok, events.size());
+        state().dumping.store(false);
+    });
+    return true;
+}
+
+void Tracer::waitForDump() {
+    TracerState& s = state();
+    std::lock_guard<std::mutex> dumpLock(s.dumpMutex);
+    if (s.dumpThread.joinable()) s.dumpThread.join();
+}
+
+std::uint64_t Tracer::getEventCount() {
+    TracerState& s = state();
+    std::lock_guard<std::mutex> lock(s.ringsMutex);
+    std::uint64_t count = 0;
+    for (const auto& ring : s.rings) {
+        count += ring->head.load(std::memory_order_relaxed) - ring->startedAt.load(std::memory_order_relaxed);
+    }
+    return count;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// Opt-in timeline of plugin activity (gamestate_timeline, timeline_enabled),
+// dumped as Chrome trace-event JSON for Perfetto or chrome://tracing. Hook
+// and tick callbacks, state changes, queued and sent messages and socket
+// reads land in the calling thread's own ring; a full ring overwrites its
+// oldest events, so a dump holds the last few seconds per thread.
+//
+// While tracing is off every call site costs one relaxed load and a branch;
+// nothing is timed or written.
+//
+//   GS_TRACE_SCOPE("sendStateUpdate", "state");
+//   GS_TRACE_INSTANT("ws enqueue", "net", (std::int64_t)length);
+//
+// Event names and categories are stored as pointers: pass literals, or
+// strings that outlive the trace (hook sites, tick subscriber names).
+class Tracer {
+public:
+    static constexpr size_t kDefaultEventsPerThread = 32768;
+    static constexpr std::int64_t kNoValue = INT64_MIN;
+
+    // Start recording; earlier events are discarded. Rings are allocated
+    // per thread on its first event and keep the size they were made with.
+    static void start(size_t eventsPerThread = kDefaultEventsPerThread);
+    // Stop recording; events stay in the rings until the next start()
+    static void stop();
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+    // Shown as the thread's name in the viewer; cheap, call at thread start
+    static void setThreadName(const char* name);
+
+    // A finished slice [startNs, endNs) on steady-clock nanoseconds
+    static void complete(const char* name, const char* category, std::int64_t startNs, std::int64_t endNs,
+                         std::int64_t value = kNoValue);
+    static void instant(const char* name, const char* category, std::int64_t value = kNoValue);
+
+    // Copy every thread's ring now, write the JSON to `path` on a worker
+    // thread and call done(ok, events) there. False if a dump is running.
+    static bool dump(const std::string& path, std::function<void(bool ok, size_t events)> done);
+    // Wait for a running dump (plugin unload)
+    static void waitForDump();
+
+    // Events recorded since start(), including overwritten ones
+    static std::uint64_t getEventCount();
+
+    static std::int64_t nowNs() { return toNs(std::chrono::steady_clock::now()); }
+    static std::int64_t toNs(std::chrono::steady_clock::time_point time) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    }
+
+private:
+    static std::atomic<bool> enabled;
+};
+
+// Records the enclosing scope as a slice when tracing was on at entry
+class TraceScope {
+public:
+    TraceScope(const char* name, const char* category)
+        : name(name), category(category), startNs(Tracer::isEnabled() ? Tracer::nowNs() : 0), value(Tracer::kNoValue) {
+    }
+
+    ~TraceScope() {
+        if (startNs != 0) {
+            Tracer::complete(name, category, startNs, Tracer::nowNs(), value);
+        }
+    }
+
+    // Shown as args.value on the slice (bytes written, frames taken, ...)
+    void setValue(std::int64_t v) { value = v; }
+
+private:
+    const char* name;
+    const char* category;
+    std::int64_t startNs;
+    std::int64_t value;
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+};
+
+#define GS_TRACE_CONCAT_INNER(a, b) a##b
+#define GS_TRACE_CONCAT(a, b) GS_TRACE_CONCAT_INNER(a, b)
+#define GS_TRACE_SCOPE(name, category) TraceScope GS_TRACE_CONCAT(traceScope, __LINE__)(name, category)
+#define GS_TRACE_INSTANT(name, category, value) \
+    do { if (Tracer::isEnabled()) Tracer::instant(name, category, value); } while (0)
@@ -1,30 +1,67 @@
 #include "WebSocketClient.h"
-#include <iostream>
-#include <sstream>
+#include "WebSocketFrame.h"
+#include "WebSocketHandshake.h"
+#include "JsonWriter.h"
+#include "Logger.h"
+#include "Tracer.h"
 #include <random>
 #include <iomanip>
+#include <cstring>
 
-// Initialize Winsock
-static bool winsockInitialized = false;
-static void initWinsock() {
-    if (!winsockInitialized) {
-        WSADATA wsaData;
-        if (WSAStartup(MAKEWORD(2, 2), &wsaData) == 0) {
-            winsockInitialized = true;
-        }
+// Reactor waits are unbounded; disconnect() and sendMessage() wake the loop
+static const int kNoTimeout = -1;
+
+// How long disconnect() waits for the server to answer our close frame
+static const int kCloseHandshakeTimeoutMs = 100;
+
+// Stack buffer for one outgoing JSON message
+static const size_t kMaxJsonMessageSize = 256;
+
+// The writer stops coalescing queued frames into one send() past this size
+static const size_t kMaxCoalesceBytes = 64 * 1024;
+
+static const char* wireFormatName(WireFormat format) {
+    switch (format) {
+        case WireFormat::Binary: return "binary";
+        case WireFormat::JsonEvents: return "JSON with events";
+        default: return "JSON";
     }
 }
 
 // Create WebSocket client with specified URL
-WebSocketClient::WebSocketClient(const std::string& url)
-    : websocketUrl(url), sock(INVALID_SOCKET), running(false), connected(false) {
+WebSocketClient::WebSocketClient(const std::string& url, size_t sendQueueCapacity)
+    : websocketUrl(url), sock(INVALID_SOCKET), running(false), connected(false),
+      state(ConnectionState::Disconnected),
+      phase(SocketPhase::Idle), setupTimer(0), lastConnectLatencyMs(-1), closeSent(false),
+      heartbeatTimer(0), pingOutstanding(false), missedPongs(0),
+      pingsSent(0), pongsReceived(0), deadPeerDisconnects(0),
+      offerBinaryProtocol(false), wireFormat(WireFormat::Json), wireSequence(0),
+      bytesReceived(0),
+      sendQueue(sendQueueCapacity), outboundOffset(0), writeInterest(false),
+      framesQueued(0), framesDropped(0), framesSent(0), sendCalls(0), bytesSent(0) {
     
-    // Initialize Winsock
-    initWinsock();
+    // Initialize the socket library
+    initSocketLibrary();
+
+    // The event loop lives as long as the client so producers can always wake it
+    eventLoop = std::make_unique<EventLoop>();
+    eventLoop->setWakeCallback([this]() {
+        flushOutbound();
+    });
+
+    parser.setMessageCallback([this](std::string_view payload, bool isBinary) {
+        if (onMessage) {
+            onMessage(payload, isBinary);
+        }
+    });
+
+    parser.setControlCallback([this](WebSocketOpcode opcode, std::string_view payload) {
+        handleControlFrame(opcode, payload);
+    });
     
     // Parse the WebSocket URL
     if (!parseWebSocketUrl(url)) {
-        std::cout << "WebSocketClient: Failed to parse URL: " << url << std::endl;
+        GS_LOG_ERROR("WebSocketClient: Failed to parse URL: %s", url.c_str());
     }
 }
 
@@ -60,99 +97,248 @@ bool WebSocketClient::parseWebSocketUrl(const std::string& url) {
     return true;
 }
 
-// Connect to WebSocket server
+// Start the network thread, which opens the connection (and keeps retrying
+// if auto-reconnect is enabled). Never blocks on the network.
 bool WebSocketClient::connect() {
     if (running) {
-        return connected.load();
+        return true;
     }
 
-    if (!parseWebSocketUrl(websocketUrl)) {
-        std::cout << "WebSocketClient: Invalid URL format" << std::endl;
-        return false;
+    // A previous network thread may have given up on its own
+    if (networkThread.joinable()) {
+        networkThread.join();
     }
 
-    if (!connectToServer()) {
-        std::cout << "WebSocketClient: Failed to connect to server" << std::endl;
+    if (!eventLoop->isValid()) {
+        GS_LOG_ERROR("WebSocketClient: Failed to create event loop");
         return false;
     }
 
-    if (!performWebSocketHandshake()) {
-        std::cout << "WebSocketClient: WebSocket handshake failed" << std::endl;
-        cleanup();
+    if (!parseWebSocketUrl(websocketUrl)) {
+        GS_LOG_ERROR("WebSocketClient: Invalid URL format");
         return false;
     }
 
-    connected = true;
     running = true;
-
-    // Start network thread
+    state = ConnectionState::Connecting;
     networkThread = std::thread(&WebSocketClient::networkLoop, this);
+    return true;
+}
 
-    std::cout << "WebSocketClient: Connected to " << websocketUrl << std::endl;
-    
-    if (onConnected) {
-        onConnected();
+// Open the TCP connection, run the handshake and leave the socket registered
+// with the event loop (network thread). Both steps are non-blocking and
+// bounded by the configured timeouts; disconnect() interrupts them.
+bool WebSocketClient::openConnection() {
+    parser.reset();
+    discardQueuedFrames();
+    outbound.clear();
+    outboundOffset = 0;
+    writeInterest = false;
+    handshakeResponse.clear();
+    setupError.clear();
+    closeSent = false;
+
+    connectStartedAt = std::chrono::steady_clock::now();
+    if (!startConnect()) {
+        GS_LOG_WARN("WebSocketClient: Failed to connect to server");
+        return false;
     }
 
+    armSetupTimer(connectTimeouts.connectTimeoutMs, "TCP connect");
+
+    while (running && phase != SocketPhase::Open && setupError.empty()) {
+        if (eventLoop->runOnce(kNoTimeout) < 0) {
+            setupError = "Event loop failed";
+            break;
+        }
+    }
+
+    eventLoop->cancelTimer(setupTimer);
+
+    if (phase != SocketPhase::Open) {
+        if (!setupError.empty()) {
+            GS_LOG_WARN("WebSocketClient: %s", setupError.c_str());
+        }
+        closeConnection();
+        return false;
+    }
+
+    auto openedAt = std::chrono::steady_clock::now();
+    auto tcpMs = std::chrono::duration_cast<std::chrono::milliseconds>(tcpConnectedAt - connectStartedAt).count();
+    auto handshakeMs = std::chrono::duration_cast<std::chrono::milliseconds>(openedAt - tcpConnectedAt).count();
+    lastConnectLatencyMs = (int)(tcpMs + handshakeMs);
+
+    wireSequence = 0;
+
+    GS_LOG_INFO("WebSocketClient: Connected to %s in %lld ms (TCP %lld ms, handshake %lld ms, %s messages)",
+                websocketUrl.c_str(), (long long)(tcpMs + handshakeMs), (long long)tcpMs, (long long)handshakeMs,
+                wireFormatName(wireFormat));
     return true;
 }
 
-// Connect to TCP server
-bool WebSocketClient::connectToServer() {
-    sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
-    if (sock == INVALID_SOCKET) {
-        return false;
+// Unregister and close the current socket (network thread)
+void WebSocketClient::closeConnection() {
+    if (sock != INVALID_SOCKET) {
+        eventLoop->unwatch(sock);
     }
+    cleanup();
+    phase = SocketPhase::Idle;
+    connected = false;
+}
 
-    struct addrinfo hints, *result;
-    ZeroMemory(&hints, sizeof(hints));
+// Create a non-blocking socket and start connecting; completion is reported
+// to handleConnectEvent as writability
+bool WebSocketClient::startConnect() {
+    // Name resolution still blocks, but only the network thread; the
+    // desktop app is normally addressed as localhost/127.0.0.1
+    struct addrinfo hints = {}, *result;
     hints.ai_family = AF_INET;
     hints.ai_socktype = SOCK_STREAM;
     hints.ai_protocol = IPPROTO_TCP;
 
     if (getaddrinfo(host.c_str(), port.c_str(), &hints, &result) != 0) {
-        closesocket(sock);
-        sock = INVALID_SOCKET;
         return false;
     }
 
-    if (::connect(sock, result->ai_addr, (int)result->ai_addrlen) == SOCKET_ERROR) {
+    sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (sock == INVALID_SOCKET) {
         freeaddrinfo(result);
-        closesocket(sock);
-        sock = INVALID_SOCKET;
         return false;
     }
 
+    setSocketNonBlocking(sock, true);
+    setSocketNoDelay(sock);
+
+    int rc = ::connect(sock, result->ai_addr, (int)result->ai_addrlen);
     freeaddrinfo(result);
+
+    if (rc == SOCKET_ERROR && !isConnectInProgressError(lastSocketError())) {
+        cleanup();
+        return false;
+    }
+
+    phase = SocketPhase::TcpConnecting;
+    if (!eventLoop->watch(sock, EventLoop::Writable, [this](unsigned events) {
+            handleSocketEvent(events);
+        })) {
+        cleanup();
+        phase = SocketPhase::Idle;
+        return false;
+    }
+
     return true;
 }
 
-// Perform WebSocket handshake
-bool WebSocketClient::performWebSocketHandshake() {
-    std::string key = generateWebSocketKey();
-    
-    std::string request = "GET " + path + " HTTP/1.1\r\n";
-    request += "Host: " + host + ":" + port + "\r\n";
-    request += "Upgrade: websocket\r\n";
-    request += "Connection: Upgrade\r\n";
-    request += "Sec-WebSocket-Key: " + key + "\r\n";
-    request += "Sec-WebSocket-Version: 13\r\n";
-    request += "\r\n";
-
-    if (send(sock, request.c_str(), (int)request.length(), 0) == SOCKET_ERROR) {
-        return false;
+// The non-blocking connect() finished one way or the other (network thread).
+// WSAPoll on older Windows builds may never report a refused connect, which
+// is what the connect timeout is for.
+void WebSocketClient::handleConnectEvent(unsigned events) {
+    if (!(events & (EventLoop::Writable | EventLoop::Closed))) {
+        return;
     }
 
-    // Read response (simplified - just check for 101 status)
-    char buffer[1024];
-    int bytesReceived = recv(sock, buffer, sizeof(buffer) - 1, 0);
-    if (bytesReceived > 0) {
-        buffer[bytesReceived] = '\0';
-        std::string response(buffer);
-        return response.find("HTTP/1.1 101") != std::string::npos;
+    int error = getSocketError(sock);
+    if (error != 0) {
+        abortSetup("TCP connect failed (error " + std::to_string(error) + ")");
+        return;
     }
 
-    return false;
+    tcpConnectedAt = std::chrono::steady_clock::now();
+    eventLoop->cancelTimer(setupTimer);
+    armSetupTimer(connectTimeouts.handshakeTimeoutMs, "Handshake");
+
+    // Send the upgrade request through the regular writer
+    phase = SocketPhase::Handshaking;
+    handshakeKey = generateWebSocketKey();
+    // Legacy JSON first: a server that takes the first offer (ws without
+    // handleProtocols) must still get the format it can parse
+    std::string protocols = std::string(kJsonWireProtocol) + ", " + kJsonEventsWireProtocol;
+    if (offerBinaryProtocol) {
+        protocols += std::string(", ") + kBinaryWireProtocol;
+    }
+    outbound = buildHandshakeRequest(host, port, path, handshakeKey, protocols);
+    outboundOffset = 0;
+    writeInterest = false;
+    eventLoop->updateInterest(sock, EventLoop::Readable);
+    flushOutbound();
+}
+
+// Accumulate the upgrade response until the blank line, then validate it
+// (network thread)
+void WebSocketClient::handleHandshakeEvent(unsigned events) {
+    if (events & EventLoop::Writable) {
+        flushOutbound();
+    }
+
+    if (!(events & (EventLoop::Readable | EventLoop::Closed))) {
+        return;
+    }
+
+    char buffer[4096];
+    HandshakeResponse response;
+    while (phase == SocketPhase::Handshaking && setupError.empty()) {
+        int bytesRead = recv(sock, buffer, (int)sizeof(buffer), 0);
+        if (bytesRead > 0) {
+            bytesReceived.fetch_add((std::uint64_t)bytesRead, std::memory_order_relaxed);
+            handshakeResponse.append(buffer, (size_t)bytesRead);
+
+            response = parseHandshakeResponse(handshakeResponse, handshakeKey);
+            if (response.status == HandshakeResponse::Status::Rejected) {
+                abortSetup("WebSocket handshake failed: " + response.error);
+            } else if (response.status == HandshakeResponse::Status::Accepted) {
+                // No protocol (a server unaware of the offer) means JSON
+                if (response.protocol.empty() || response.protocol == kJsonWireProtocol) {
+                    wireFormat = WireFormat::Json;
+                    phase = SocketPhase::Open;
+                } else if (response.protocol == kJsonEventsWireProtocol) {
+                    wireFormat = WireFormat::JsonEvents;
+                    phase = SocketPhase::Open;
+                } else if (offerBinaryProtocol && response.protocol == kBinaryWireProtocol) {
+                    wireFormat = WireFormat::Binary;
+                    phase = SocketPhase::Open;
+                } else {
+                    abortSetup("Server selected an unknown subprotocol: " + response.protocol);
+                }
+            }
+        } else if (bytesRead == 0) {
+            abortSetup("Server closed the connection during the handshake");
+        } else {
+            if (!isWouldBlockError(lastSocketError())) {
+                abortSetup("WebSocket handshake failed: socket error");
+            }
+            return;
+        }
+    }
+
+    if (phase != SocketPhase::Open) {
+        return;
+    }
+
+    // Frames the server sent right behind the handshake belong to the parser
+    size_t extra = handshakeResponse.size() - response.headerLength;
+    if (extra > 0) {
+        size_t available;
+        char* dest = parser.prepareWrite(available);
+        std::memcpy(dest, handshakeResponse.data() + response.headerLength, extra);
+        parser.commitWrite(extra);
+    }
+    handshakeResponse.clear();
+}
+
+// Fail the connection attempt in progress (network thread)
+void WebSocketClient::abortSetup(const std::string& reason) {
+    if (setupError.empty()) {
+        setupError = reason;
+    }
+}
+
+// Bound the current setup step; the attempt fails if the timer fires first
+void WebSocketClient::armSetupTimer(int timeoutMs, const char* what) {
+    std::string reason = std::string(what) + " timed out after " + std::to_string(timeoutMs) + " ms";
+    setupTimer = eventLoop->addTimer(std::chrono::milliseconds(timeoutMs > 0 ? timeoutMs : 1),
+        [this, reason]() {
+            abortSetup(reason);
+        });
 }
 
 // Generate WebSocket key for handshake
@@ -169,45 +355,22 @@ std::string WebSocketClient::generateWebSocketKey() {
     return base64Encode(key);
 }
 
-// Simple base64 encoding
-std::string WebSocketClient::base64Encode(const std::string& input) {
-    const std::string chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-    std::string result;
-    int val = 0, valb = -6;
-    
-    for (unsigned char c : input) {
-        val = (val << 8) + c;
-        valb += 8;
-        while (valb >= 0) {
-            result.push_back(chars[(val >> valb) & 0x3F]);
-            valb -= 6;
-        }
-    }
-    
-    if (valb > -6) result.push_back(chars[((val << 8) >> (valb + 8)) & 0x3F]);
-    while (result.size() % 4) result.push_back('=');
-    
-    return result;
-}
-
-// Disconnect from WebSocket server
+// Disconnect from WebSocket server and stop reconnecting. The network thread
+// is woken rather than polled, sends a close frame and exits within
+// kCloseHandshakeTimeoutMs even if the server never answers.
 void WebSocketClient::disconnect() {
-    if (!running) return;
-
-    running = false;
-    connected = false;
+    bool wasRunning = running.exchange(false);
+    if (wasRunning) {
+        eventLoop->wakeup();
+    }
 
     if (networkThread.joinable()) {
         networkThread.join();
     }
 
-    cleanup();
-
-    if (onDisconnected) {
-        onDisconnected();
+    if (wasRunning) {
+        GS_LOG_INFO("WebSocketClient: Disconnected");
     }
-
-    std::cout << "WebSocketClient: Disconnected" << std::endl;
 }
 
 // Check if WebSocket is connected
@@ -215,60 +378,165 @@ bool WebSocketClient::isConnected() const {
     return connected.load();
 }
 
-// Send text message to WebSocket server
-void WebSocketClient::sendMessage(const std::string& message) {
+// Current position in the connection state machine
+WebSocketClient::ConnectionState WebSocketClient::getState() const {
+    return state.load();
+}
+
+// Configure auto-reconnect (call before connect)
+void WebSocketClient::setReconnectPolicy(const ReconnectPolicy& policy) {
+    reconnectPolicy = policy;
+}
+
+// Configure connect/handshake timeouts (call before connect)
+void WebSocketClient::setConnectTimeouts(const ConnectTimeouts& timeouts) {
+    connectTimeouts = timeouts;
+}
+
+// Configure ping interval and dead-peer threshold (call before connect)
+void WebSocketClient::setHeartbeatPolicy(const HeartbeatPolicy& policy) {
+    heartbeatPolicy = policy;
+}
+
+// Heartbeat RTT distribution (readable from any thread)
+const LatencyHistogram& WebSocketClient::getRttHistogram() const {
+    return rttHistogram;
+}
+
+// Duration of the most recent successful connection setup
+int WebSocketClient::getLastConnectLatencyMs() const {
+    return lastConnectLatencyMs.load(std::memory_order_relaxed);
+}
+
+// Total bytes read from the socket since construction
+std::uint64_t WebSocketClient::getBytesReceived() const {
+    return bytesReceived.load(std::memory_order_relaxed);
+}
+
+// Snapshot of the outbound queue and writer counters
+WebSocketStats WebSocketClient::getStats() const {
+    WebSocketStats stats;
+    stats.framesQueued = framesQueued.load(std::memory_order_relaxed);
+    stats.framesDropped = framesDropped.load(std::memory_order_relaxed);
+    stats.framesSent = framesSent.load(std::memory_order_relaxed);
+    stats.sendCalls = sendCalls.load(std::memory_order_relaxed);
+    stats.bytesSent = bytesSent.load(std::memory_order_relaxed);
+    stats.bytesReceived = bytesReceived.load(std::memory_order_relaxed);
+    stats.pingsSent = pingsSent.load(std::memory_order_relaxed);
+    stats.pongsReceived = pongsReceived.load(std::memory_order_relaxed);
+    stats.deadPeerDisconnects = deadPeerDisconnects.load(std::memory_order_relaxed);
+    stats.queueDepth = sendQueue.size();
+    stats.queueCapacity = sendQueue.capacity();
+    return stats;
+}
+
+// Queue a text message for the network thread (safe from any thread)
+bool WebSocketClient::sendMessage(const std::string& message) {
+    return queueFrame(WebSocketOpcode::Text, message.data(), message.size());
+}
+
+// Same, from a caller's buffer; the text is copied into the queue slot
+bool WebSocketClient::sendMessage(const char* text, size_t length) {
+    return queueFrame(WebSocketOpcode::Text, text, length);
+}
+
+// Encode a data frame and hand it to the network thread (safe from any thread)
+bool WebSocketClient::queueFrame(WebSocketOpcode opcode, const char* payload, size_t length) {
     if (!connected) {
-        std::cout << "WebSocketClient: Not connected, cannot send message" << std::endl;
-        return;
+        GS_LOG_DEBUG("WebSocketClient: Not connected, cannot send message");
+        return false;
     }
 
-    // Create WebSocket frame with proper masking (required for client->server)
-    std::string frame;
-    frame += (char)0x81; // FIN + text frame
-    
-    // Generate random 4-byte mask key
-    unsigned char maskKey[4];
-    for (int i = 0; i < 4; ++i) {
-        maskKey[i] = rand() % 256;
+    // Encode the frame straight into a queue slot (client->server frames are masked)
+    bool queued = sendQueue.tryPush([opcode, payload, length](std::string& frame) {
+        encodeClientFrame(frame, opcode, payload, length);
+    });
+
+    if (!queued) {
+        framesDropped.fetch_add(1, std::memory_order_relaxed);
+        GS_TRACE_INSTANT("ws drop", "net", (std::int64_t)length);
+        return false;
     }
-    
-    size_t payloadLen = message.length();
-    
-    if (payloadLen < 126) {
-        frame += (char)(0x80 | payloadLen); // MASK bit set + length
-    } else if (payloadLen < 65536) {
-        frame += (char)126;
-        frame += (char)((payloadLen >> 8) & 0xFF);
-        frame += (char)(payloadLen & 0xFF);
-    } else {
-        frame += (char)127;
-        for (int i = 7; i >= 0; --i) {
-            frame += (char)((payloadLen >> (i * 8)) & 0xFF);
-        }
+
+    framesQueued.fetch_add(1, std::memory_order_relaxed);
+    GS_TRACE_INSTANT("ws enqueue", "net", (std::int64_t)length);
+    eventLoop->wakeup();
+    return true;
+}
+
+// Send JSON message with game state and timestamp. Formats on the stack and
+// encodes straight into a queue slot, so steady state does not allocate.
+bool WebSocketClient::sendJsonMessage(std::string_view state, long long timestamp) {
+    char buffer[kMaxJsonMessageSize];
+    JsonWriter json(buffer, sizeof(buffer));
+    json.beginObject();
+    json.field("state", state);
+    json.field("timestamp", timestamp);
+    json.endObject();
+
+    return queueJson(json);
+}
+
+// Queue a finished JSON document as a text frame
+bool WebSocketClient::queueJson(const JsonWriter& json) {
+    if (!json.ok()) {
+        GS_LOG_WARN("WebSocketClient: JSON message exceeds %zu bytes", kMaxJsonMessageSize);
+        return false;
     }
-    
-    // Add mask key
-    frame.append((char*)maskKey, 4);
-    
-    // XOR payload with mask key
-    for (size_t i = 0; i < message.size(); i++) {
-        frame += (char)(message[i] ^ maskKey[i % 4]);
+    return queueFrame(WebSocketOpcode::Text, json.data(), json.size());
+}
+
+// Send a state update using the negotiated wire format
+bool WebSocketClient::sendStateMessage(std::uint32_t stateId, std::string_view stateName,
+                                       long long timestamp) {
+    if (wireFormat.load(std::memory_order_relaxed) != WireFormat::Binary) {
+        return sendJsonMessage(stateName, timestamp);
     }
 
-    if (send(sock, frame.c_str(), (int)frame.length(), 0) == SOCKET_ERROR) {
-        std::cout << "WebSocketClient: Failed to send message" << std::endl;
-        connected = false;
-    } else {
-        std::cout << "WebSocketClient: Sent message: " << message << std::endl;
+    char message[kMaxWireMessageSize];
+    size_t length = encodeStateMessage(message, wireSequence.fetch_add(1, std::memory_order_relaxed),
+                                       stateId, (std::uint64_t)timestamp);
+    return queueFrame(WebSocketOpcode::Binary, message, length);
+}
+
+// Send an event using the negotiated wire format; skipped (not a drop) on
+// a legacy JSON connection, whose consumers only understand state messages
+bool WebSocketClient::sendEventMessage(std::uint32_t eventId, std::string_view eventName,
+                                       std::int64_t value, long long timestamp) {
+    WireFormat format = wireFormat.load(std::memory_order_relaxed);
+    if (format == WireFormat::Json) {
+        return false;
+    }
+    if (format == WireFormat::JsonEvents) {
+        char buffer[kMaxJsonMessageSize];
+        JsonWriter json(buffer, sizeof(buffer));
+        json.beginObject();
+        json.field("event", eventName);
+        json.field("value", (long long)value);
+        json.field("timestamp", timestamp);
+        json.endObject();
+        return queueJson(json);
     }
+
+    char message[kMaxWireMessageSize];
+    size_t length = encodeEventMessage(message, wireSequence.fetch_add(1, std::memory_order_relaxed),
+                                       eventId, (std::uint64_t)timestamp, value);
+    return queueFrame(WebSocketOpcode::Binary, message, length);
 }
 
-// Send JSON message with game state and timestamp
-void WebSocketClient::sendJsonMessage(const std::string& state, long long timestamp) {
-    std::stringstream jsonStream;
-    jsonStream << "{\"state\":\"" << state << "\",\"timestamp\":" << timestamp << "}";
-    
-    sendMessage(jsonStream.str());
+// Encoding negotiated for the current (or last) connection
+WireFormat WebSocketClient::getWireFormat() const {
+    return wireFormat.load();
+}
+
+// Whether the server selected a format that carries event and perf messages
+bool WebSocketClient::carriesEvents() const {
+    return wireFormat.load(std::memory_order_relaxed) != WireFormat::Json;
+}
+
+// Offer kBinaryWireProtocol in the handshake (call before connect)
+void WebSocketClient::setOfferBinaryProtocol(bool offer) {
+    offerBinaryProtocol = offer;
 }
 
 // Set callback for connection established
@@ -286,30 +554,397 @@ void WebSocketClient::setErrorCallback(ErrorCallback callback) {
     onError = callback;
 }
 
-// Network loop for receiving messages
+// Set callback for inbound messages
+void WebSocketClient::setMessageCallback(MessageCallback callback) {
+    onMessage = callback;
+}
+
+// Network thread: makes the first connection attempt, runs the connected
+// session, and after a failure or drop walks the reconnect state machine
+// (Reconnecting -> Connecting -> Connected) until it succeeds, runs out of
+// attempts or disconnect() is called
 void WebSocketClient::networkLoop() {
-    char buffer[1024];
-    
+    Tracer::setThreadName("network");
+    int attempt = 0;
+    bool firstAttempt = true;
+
+    while (running) {
+        if (connected) {
+            runSession();
+            if (!running && connected) {
+                closeGracefully();
+            }
+            closeConnection();
+            attempt = 0;
+            GS_TRACE_INSTANT("ws disconnected", "net", Tracer::kNoValue);
+
+            // Only report drops; disconnect() runs during plugin unload,
+            // when the owner's callbacks may no longer be safe to post
+            if (running && onDisconnected) {
+                onDisconnected();
+            }
+        }
+
+        if (!running) {
+            break;
+        }
+
+        if (!firstAttempt) {
+            if (!reconnectPolicy.enabled ||
+                (reconnectPolicy.maxAttempts > 0 && attempt >= reconnectPolicy.maxAttempts)) {
+                GS_LOG_WARN("WebSocketClient: Giving up after %d reconnect attempts", attempt);
+                break;
+            }
+
+            ++attempt;
+            state = ConnectionState::Reconnecting;
+            if (!waitForReconnect(attempt)) {
+                break;
+            }
+        }
+        firstAttempt = false;
+
+        state = ConnectionState::Connecting;
+        if (openConnection()) {
+            connected = true;
+            state = ConnectionState::Connected;
+            GS_TRACE_INSTANT("ws connected", "net", lastConnectLatencyMs.load());
+            if (attempt > 0) {
+                GS_LOG_INFO("WebSocketClient: Reconnected after %d attempt(s)", attempt);
+            }
+            attempt = 0;
+
+            // Lets the owner resend its current state straight away
+            if (onConnected) {
+                onConnected();
+            }
+        }
+    }
+
+    state = ConnectionState::Disconnected;
+    running = false;
+}
+
+// Serve one connection until it drops or disconnect() is called
+void WebSocketClient::runSession() {
+    // Frames queued between the handshake and this point did not wake anyone,
+    // and the handshake read may already have pulled in the first frames
+    flushOutbound();
+    if (parser.parse() != WebSocketParser::Result::Ok) {
+        failConnection("Malformed frame from server", 1002);
+    }
+
+    pingOutstanding = false;
+    missedPongs = 0;
+    heartbeatTimer = 0;
+    if (heartbeatPolicy.intervalMs > 0) {
+        heartbeatTimer = eventLoop->addPeriodicTimer(std::chrono::milliseconds(heartbeatPolicy.intervalMs),
+            [this]() {
+                sendHeartbeat();
+            });
+    }
+
     while (running && connected) {
-        int bytesReceived = recv(sock, buffer, sizeof(buffer) - 1, 0);
-        
-        if (bytesReceived > 0) {
-            buffer[bytesReceived] = '\0';
-            // Handle incoming WebSocket messages (simplified)
-            std::cout << "WebSocketClient: Received: " << buffer << std::endl;
-        } else if (bytesReceived == 0) {
-            // Connection closed by server
+        if (eventLoop->runOnce(kNoTimeout) < 0) {
             connected = false;
             break;
+        }
+    }
+
+    if (heartbeatTimer != 0) {
+        eventLoop->cancelTimer(heartbeatTimer);
+    }
+}
+
+// Heartbeat tick: give up on a peer that left too many pings unanswered,
+// otherwise send the next ping carrying its send time (network thread)
+void WebSocketClient::sendHeartbeat() {
+    if (!connected || closeSent) {
+        return;
+    }
+
+    int maxMissed = heartbeatPolicy.maxMissedPongs > 0 ? heartbeatPolicy.maxMissedPongs : 1;
+    if (pingOutstanding && ++missedPongs >= maxMissed) {
+        deadPeerDisconnects.fetch_add(1, std::memory_order_relaxed);
+        failConnection("No pong for " + std::to_string(missedPongs) + " pings, treating the server as dead", 1001);
+        return;
+    }
+
+    std::uint64_t sentAtNs = (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    char payload[8];
+    for (int i = 0; i < 8; ++i) {
+        payload[i] = (char)(sentAtNs >> (i * 8));
+    }
+
+    sendControlFrame(WebSocketOpcode::Ping, std::string_view(payload, sizeof(payload)));
+    pingOutstanding = true;
+    pingsSent.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Any pong proves the peer alive; ours also yield a round-trip sample
+void WebSocketClient::handlePong(std::string_view payload) {
+    pingOutstanding = false;
+    missedPongs = 0;
+    pongsReceived.fetch_add(1, std::memory_order_relaxed);
+
+    if (payload.size() != 8) {
+        return;  // unsolicited pong
+    }
+
+    std::uint64_t sentAtNs = 0;
+    for (int i = 0; i < 8; ++i) {
+        sentAtNs |= (std::uint64_t)(unsigned char)payload[i] << (i * 8);
+    }
+    std::uint64_t nowNs = (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    if (sentAtNs <= nowNs) {
+        rttHistogram.record((nowNs - sentAtNs) / 1000);
+    }
+}
+
+// Start the closing handshake and give the server a short, bounded time to
+// answer before the socket is closed (network thread)
+void WebSocketClient::closeGracefully() {
+    // Push out what is already queued; nothing may follow the close frame
+    flushOutbound();
+
+    char code[2] = { (char)(1001 >> 8), (char)(1001 & 0xFF) };  // going away
+    sendControlFrame(WebSocketOpcode::Close, std::string_view(code, 2));
+
+    bool expired = false;
+    EventLoop::TimerId timer = eventLoop->addTimer(std::chrono::milliseconds(kCloseHandshakeTimeoutMs),
+        [&expired]() {
+            expired = true;
+        });
+
+    // The server's close frame or EOF clears `connected`
+    while (connected && !expired) {
+        if (eventLoop->runOnce(kNoTimeout) < 0) {
+            break;
+        }
+    }
+
+    eventLoop->cancelTimer(timer);
+}
+
+// Sleep on the event loop for the backoff delay of the given attempt.
+// Returns false if disconnect() was called in the meantime.
+bool WebSocketClient::waitForReconnect(int attempt) {
+    std::chrono::milliseconds delay = computeReconnectDelay(attempt);
+    GS_LOG_INFO("WebSocketClient: Reconnecting in %lld ms (attempt %d)", (long long)delay.count(), attempt);
+
+    bool due = false;
+    EventLoop::TimerId timer = eventLoop->addTimer(delay, [&due]() {
+        due = true;
+    });
+
+    while (running && !due) {
+        if (eventLoop->runOnce(kNoTimeout) < 0) {
+            break;
+        }
+    }
+
+    eventLoop->cancelTimer(timer);
+    return running && due;
+}
+
+// Exponential backoff with "equal jitter": the delay doubles per attempt up
+// to the cap, and a random half of it is shaved off so restarts of the
+// desktop app are not met by synchronized retries
+std::chrono::milliseconds WebSocketClient::computeReconnectDelay(int attempt) const {
+    long long base = reconnectPolicy.baseDelayMs > 0 ? reconnectPolicy.baseDelayMs : 1;
+    long long cap = reconnectPolicy.maxDelayMs > base ? reconnectPolicy.maxDelayMs : base;
+
+    long long delay = base;
+    for (int i = 1; i < attempt && delay < cap; ++i) {
+        delay *= 2;
+    }
+    if (delay > cap) {
+        delay = cap;
+    }
+
+    long long half = delay / 2;
+    long long jitter = half > 0 ? (long long)(nextWebSocketMaskKey() % (std::uint32_t)(half + 1)) : 0;
+    return std::chrono::milliseconds(delay - half + jitter);
+}
+
+// Handle readiness on the socket (runs on the network thread)
+void WebSocketClient::handleSocketEvent(unsigned events) {
+    if (phase == SocketPhase::TcpConnecting) {
+        handleConnectEvent(events);
+        return;
+    }
+    if (phase == SocketPhase::Handshaking) {
+        handleHandshakeEvent(events);
+        return;
+    }
+
+    if (events & EventLoop::Writable) {
+        flushOutbound();
+    }
+
+    if (!(events & (EventLoop::Readable | EventLoop::Closed))) {
+        return;
+    }
+
+    // Drain the socket straight into the parser's ring, then decode
+    while (connected) {
+        size_t available;
+        char* dest = parser.prepareWrite(available);
+        TraceScope recvTrace("socket recv", "net");
+        int bytesRead = recv(sock, dest, (int)available, 0);
+        recvTrace.setValue(bytesRead);
+
+        if (bytesRead > 0) {
+            parser.commitWrite((size_t)bytesRead);
+            bytesReceived.fetch_add((std::uint64_t)bytesRead, std::memory_order_relaxed);
+
+            WebSocketParser::Result result = parser.parse();
+            if (result == WebSocketParser::Result::MessageTooBig) {
+                failConnection("Inbound message too large", 1009);
+            } else if (result != WebSocketParser::Result::Ok) {
+                failConnection("Malformed frame from server", 1002);
+            }
+        } else if (bytesRead == 0) {
+            // Connection closed by server
+            connected = false;
         } else {
-            // Error
-            if (WSAGetLastError() != WSAEWOULDBLOCK) {
+            if (!isWouldBlockError(lastSocketError())) {
+                // Error
                 connected = false;
-                break;
             }
+            break;
+        }
+    }
+}
+
+// Ping, pong and close frames from the server (network thread)
+void WebSocketClient::handleControlFrame(WebSocketOpcode opcode, std::string_view payload) {
+    switch (opcode) {
+        case WebSocketOpcode::Ping:
+            // Answer with the same application data
+            sendControlFrame(WebSocketOpcode::Pong, payload);
+            break;
+
+        case WebSocketOpcode::Pong:
+            handlePong(payload);
+            break;
+
+        case WebSocketOpcode::Close:
+            // Either the server's reply to our close, or its own close, which we echo
+            if (!closeSent) {
+                sendControlFrame(WebSocketOpcode::Close, payload.substr(0, payload.size() >= 2 ? 2 : 0));
+                GS_LOG_INFO("WebSocketClient: Server closed the connection");
+            }
+            connected = false;
+            break;
+
+        default:
+            break;
+    }
+}
+
+// Write a control frame ahead of anything still queued (network thread).
+// Appending to the coalescing buffer keeps frame boundaries intact.
+void WebSocketClient::sendControlFrame(WebSocketOpcode opcode, std::string_view payload) {
+    char frame[kMaxClientFrameHeaderSize + 125];
+    std::uint32_t maskKey = nextWebSocketMaskKey();
+    size_t headerSize = writeClientFrameHeader(frame, opcode, payload.size(), maskKey);
+    maskWebSocketPayload(frame + headerSize, payload.data(), payload.size(), maskKey);
+
+    if (outboundOffset == outbound.size()) {
+        outbound.clear();
+        outboundOffset = 0;
+    }
+    outbound.append(frame, headerSize + payload.size());
+    if (opcode == WebSocketOpcode::Close) {
+        closeSent = true;
+    }
+    flushOutbound();
+}
+
+// Close the connection after a protocol violation (network thread)
+void WebSocketClient::failConnection(const std::string& reason, std::uint16_t closeCode) {
+    GS_LOG_WARN("WebSocketClient: %s", reason.c_str());
+
+    char code[2] = { (char)(closeCode >> 8), (char)(closeCode & 0xFF) };
+    sendControlFrame(WebSocketOpcode::Close, std::string_view(code, 2));
+    connected = false;
+
+    if (onError) {
+        onError(reason);
+    }
+}
+
+// Writer: coalesce queued frames and push them to the socket (network thread).
+// During the handshake only the upgrade request in `outbound` is written.
+void WebSocketClient::flushOutbound() {
+    bool open = connected && phase == SocketPhase::Open;
+    if (sock == INVALID_SOCKET || (!open && phase != SocketPhase::Handshaking)) {
+        return;
+    }
+
+    // Data frames may not follow a close frame
+    bool takeQueued = open && !closeSent;
+
+    for (;;) {
+        if (outboundOffset == outbound.size()) {
+            outbound.clear();
+            outboundOffset = 0;
+        }
+
+        // Gather as many queued frames as fit into one syscall
+        std::int64_t taken = 0;
+        while (takeQueued && outbound.size() < kMaxCoalesceBytes &&
+               sendQueue.tryPop([this](std::string& frame) { outbound.append(frame); })) {
+            framesSent.fetch_add(1, std::memory_order_relaxed);
+            ++taken;
+        }
+        if (taken > 0) {
+            GS_TRACE_INSTANT("ws dequeue", "net", taken);
+        }
+
+        size_t remaining = outbound.size() - outboundOffset;
+        if (remaining == 0) {
+            break;
+        }
+
+        TraceScope sendTrace("socket send", "net");
+        int written = send(sock, outbound.data() + outboundOffset, (int)remaining, kSocketSendFlags);
+        sendCalls.fetch_add(1, std::memory_order_relaxed);
+        sendTrace.setValue(written);
+
+        if (written > 0) {
+            // A short write just means the kernel buffer filled; keep the rest
+            outboundOffset += (size_t)written;
+            bytesSent.fetch_add((std::uint64_t)written, std::memory_order_relaxed);
+        } else if (isWouldBlockError(lastSocketError())) {
+            // Resume when the socket becomes writable again
+            if (!writeInterest) {
+                writeInterest = true;
+                eventLoop->updateInterest(sock, EventLoop::Readable | EventLoop::Writable);
+            }
+            return;
+        } else if (open) {
+            GS_LOG_WARN("WebSocketClient: Failed to send message");
+            connected = false;
+            return;
+        } else {
+            abortSetup("Failed to send the handshake request");
+            return;
         }
-        
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    if (writeInterest) {
+        writeInterest = false;
+        eventLoop->updateInterest(sock, EventLoop::Readable);
+    }
+}
+
+// Drop frames left over from a previous connection
+void WebSocketClient::discardQueuedFrames() {
+    while (sendQueue.tryPop([](std::string&) {})) {
     }
 }
 
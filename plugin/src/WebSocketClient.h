@@ -1,12 +1,20 @@
 #pragma once
 
+#include "NetPlatform.h"
+#include "EventLoop.h"
+#include "MpscQueue.h"
+#include "WebSocketParser.h"
+#include "WireProtocol.h"
+#include "LatencyHistogram.h"
 #include <string>
+#include <string_view>
 #include <memory>
 #include <functional>
 #include <thread>
 #include <atomic>
-#include <winsock2.h>
-#include <ws2tcpip.h>
+#include <vector>
+#include <cstdint>
+#include <chrono>
 
 // WebSocket message structure
 struct WebSocketMessage {
@@ -14,26 +22,112 @@ struct WebSocketMessage {
     bool isBinary;
 };
 
+// Outbound path counters (readable from any thread)
+struct WebSocketStats {
+    std::uint64_t framesQueued;     // frames accepted by sendMessage
+    std::uint64_t framesDropped;    // frames rejected because the queue was full
+    std::uint64_t framesSent;       // frames handed to the socket by the writer
+    std::uint64_t sendCalls;        // send() syscalls made by the writer
+    std::uint64_t bytesSent;
+    std::uint64_t bytesReceived;
+    std::uint64_t pingsSent;        // heartbeat pings
+    std::uint64_t pongsReceived;
+    std::uint64_t deadPeerDisconnects;  // connections dropped for missed pongs
+    size_t queueDepth;
+    size_t queueCapacity;
+};
+
 // Callbacks for connection events
 using ConnectedCallback = std::function<void()>;
 using DisconnectedCallback = std::function<void()>;
 using ErrorCallback = std::function<void(const std::string&)>;
 
+// Called on the network thread for each complete inbound message. The view
+// points into the receive buffer and is only valid during the call.
+using MessageCallback = std::function<void(std::string_view payload, bool isBinary)>;
+
+// Auto-reconnect settings (GameStatePlugin.cfg: auto_reconnect_enabled,
+// websocket_reconnect_interval_ms, websocket_max_reconnect_delay_ms,
+// websocket_max_reconnect_attempts)
+struct ReconnectPolicy {
+    bool enabled = true;
+    int baseDelayMs = 5000;     // delay before the first retry, doubled per attempt
+    int maxDelayMs = 60000;     // backoff cap
+    int maxAttempts = 10;       // consecutive failed attempts before giving up; <= 0 retries forever
+};
+
+// Keepalive settings (GameStatePlugin.cfg: websocket_ping_interval_ms,
+// websocket_max_missed_pongs)
+struct HeartbeatPolicy {
+    int intervalMs = 1000;      // ping period while connected; <= 0 disables
+    int maxMissedPongs = 3;     // unanswered pings before the peer is declared dead
+};
+
+// Connection setup limits (GameStatePlugin.cfg: websocket_connect_timeout_ms,
+// websocket_handshake_timeout_ms)
+struct ConnectTimeouts {
+    int connectTimeoutMs = 2000;    // TCP connect
+    int handshakeTimeoutMs = 2000;  // HTTP upgrade request until the 101 response
+};
+
+class JsonWriter;
+
 class WebSocketClient {
 public:
-    WebSocketClient(const std::string& url);
+    // Connection state machine, advanced by the network thread
+    enum class ConnectionState {
+        Disconnected,
+        Connecting,
+        Connected,
+        Reconnecting    // waiting out the backoff delay
+    };
+
+    WebSocketClient(const std::string& url, size_t sendQueueCapacity = 1024);
     ~WebSocketClient();
 
+    // Start connecting on the network thread and return immediately; the
+    // connected callback fires once the handshake completes
     bool connect();
     void disconnect();
     bool isConnected() const;
-    void sendMessage(const std::string& message);
-    void sendJsonMessage(const std::string& state, long long timestamp);
+    ConnectionState getState() const;
+    void setReconnectPolicy(const ReconnectPolicy& policy);
+    void setConnectTimeouts(const ConnectTimeouts& timeouts);
+    void setHeartbeatPolicy(const HeartbeatPolicy& policy);
+    // Encode a text frame and queue it for the network thread. Never blocks;
+    // returns false (and counts a drop) if the queue is full.
+    bool sendMessage(const std::string& message);
+    bool sendMessage(const char* text, size_t length);
+    bool sendJsonMessage(std::string_view state, long long timestamp);
+
+    // Send a state or event update in the format negotiated for the current
+    // connection: binary frames if the server chose kBinaryWireProtocol,
+    // JSON text otherwise. Events are not sent to a server that chose
+    // kJsonWireProtocol or nothing (returns false, no drop counted).
+    bool sendStateMessage(std::uint32_t stateId, std::string_view stateName, long long timestamp);
+    bool sendEventMessage(std::uint32_t eventId, std::string_view eventName, std::int64_t value,
+                          long long timestamp);
+    WireFormat getWireFormat() const;
+    // True when the negotiated format carries event and perf messages
+    bool carriesEvents() const;
+    // Offer the binary format after JSON in the handshake (off by default;
+    // call before connect)
+    void setOfferBinaryProtocol(bool offer);
+
+    // Transport statistics
+    std::uint64_t getBytesReceived() const;
+    WebSocketStats getStats() const;
+    // Time from starting the TCP connect to the accepted handshake of the
+    // most recent connection, or -1 before the first one
+    int getLastConnectLatencyMs() const;
+    // Heartbeat round-trip times in microseconds, across all connections
+    const LatencyHistogram& getRttHistogram() const;
 
     // Callback setters
     void setConnectedCallback(ConnectedCallback callback);
     void setDisconnectedCallback(DisconnectedCallback callback);
     void setErrorCallback(ErrorCallback callback);
+    void setMessageCallback(MessageCallback callback);
 
 private:
     // WebSocket connection details
@@ -43,24 +137,96 @@ private:
     std::string path;
     
     // Network connection
-    SOCKET sock;
+    SocketHandle sock;
     std::thread networkThread;
     std::atomic<bool> running;
     std::atomic<bool> connected;
+    std::atomic<ConnectionState> state;
+    ReconnectPolicy reconnectPolicy;
+    ConnectTimeouts connectTimeouts;
+
+    // Where the current socket is in connection setup (network thread only)
+    enum class SocketPhase {
+        Idle,
+        TcpConnecting,  // non-blocking connect() in flight
+        Handshaking,    // upgrade request sent, reading the response
+        Open            // WebSocket frames flow
+    };
+
+    SocketPhase phase;
+    std::string handshakeKey;
+    std::string handshakeResponse;  // response bytes received so far
+    std::string setupError;         // set when the current attempt fails
+    EventLoop::TimerId setupTimer;
+    std::chrono::steady_clock::time_point connectStartedAt;
+    std::chrono::steady_clock::time_point tcpConnectedAt;
+    std::atomic<int> lastConnectLatencyMs;
+    bool closeSent;                 // our close frame is out; no more data frames
+
+    // Heartbeat (network thread, except the counters and histogram)
+    HeartbeatPolicy heartbeatPolicy;
+    EventLoop::TimerId heartbeatTimer;
+    bool pingOutstanding;
+    int missedPongs;
+    LatencyHistogram rttHistogram;
+    std::atomic<std::uint64_t> pingsSent;
+    std::atomic<std::uint64_t> pongsReceived;
+    std::atomic<std::uint64_t> deadPeerDisconnects;
+
+    // Message encoding chosen by the server during the handshake
+    bool offerBinaryProtocol;
+    std::atomic<WireFormat> wireFormat;
+    std::atomic<std::uint16_t> wireSequence;
+
+    // Reactor driving the socket on the network thread
+    std::unique_ptr<EventLoop> eventLoop;
+    WebSocketParser parser;
+    std::atomic<std::uint64_t> bytesReceived;
+
+    // Outbound frames: game/producer threads push, the network thread writes
+    MpscQueue<std::string> sendQueue;
+    std::string outbound;          // coalesced frames awaiting send()
+    size_t outboundOffset;         // bytes of `outbound` already written
+    bool writeInterest;
+
+    std::atomic<std::uint64_t> framesQueued;
+    std::atomic<std::uint64_t> framesDropped;
+    std::atomic<std::uint64_t> framesSent;
+    std::atomic<std::uint64_t> sendCalls;
+    std::atomic<std::uint64_t> bytesSent;
 
     // Callbacks
     ConnectedCallback onConnected;
     DisconnectedCallback onDisconnected;
     ErrorCallback onError;
+    MessageCallback onMessage;
 
     // Private methods
     bool parseWebSocketUrl(const std::string& url);
-    bool connectToServer();
-    bool performWebSocketHandshake();
+    bool startConnect();
+    void handleConnectEvent(unsigned events);
+    void handleHandshakeEvent(unsigned events);
+    void abortSetup(const std::string& reason);
+    void armSetupTimer(int timeoutMs, const char* what);
+    bool openConnection();
+    void closeConnection();
     void networkLoop();
+    void runSession();
+    void closeGracefully();
+    void sendHeartbeat();
+    void handlePong(std::string_view payload);
+    bool waitForReconnect(int attempt);
+    std::chrono::milliseconds computeReconnectDelay(int attempt) const;
+    void handleSocketEvent(unsigned events);
+    void flushOutbound();
+    void handleControlFrame(WebSocketOpcode opcode, std::string_view payload);
+    void sendControlFrame(WebSocketOpcode opcode, std::string_view payload);
+    void failConnection(const std::string& reason, std::uint16_t closeCode);
+    void discardQueuedFrames();
     void cleanup();
+    bool queueFrame(WebSocketOpcode opcode, const char* payload, size_t length);
+    bool queueJson(const JsonWriter& json);
     std::string generateWebSocketKey();
-    std::string base64Encode(const std::string& input);
 
     // Disable copying
     WebSocketClient(const WebSocketClient&) = delete;
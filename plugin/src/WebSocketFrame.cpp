@@ -0,0 +1,164 @@
+#include "WebSocketFrame.h"
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <thread>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define WEBSOCKET_FRAME_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// Write a masked client frame header (the mask key is stored in memory order,
+// which is the same order the masking routines read it back in)
+size_t writeClientFrameHeader(char* out, WebSocketOpcode opcode, size_t payloadLength,
+                              std::uint32_t maskKey, bool fin) {
+    unsigned char* p = reinterpret_cast<unsigned char*>(out);
+    p[0] = (unsigned char)((fin ? 0x80 : 0x00) | (unsigned char)opcode);
+
+    size_t pos;
+    if (payloadLength < 126) {
+        p[1] = (unsigned char)(0x80 | payloadLength);
+        pos = 2;
+    } else if (payloadLength < 65536) {
+        p[1] = 0x80 | 126;
+        p[2] = (unsigned char)(payloadLength >> 8);
+        p[3] = (unsigned char)payloadLength;
+        pos = 4;
+    } else {
+        p[1] = 0x80 | 127;
+        std::uint64_t len64 = payloadLength;
+        for (int i = 0; i < 8; ++i) {
+            p[2 + i] = (unsigned char)(len64 >> ((7 - i) * 8));
+        }
+        pos = 10;
+    }
+
+    std::memcpy(p + pos, &maskKey, 4);
+    return pos + 4;
+}
+
+// Portable path: eight bytes per step, then a byte tail
+static void maskScalar(char* dst, const char* src, size_t length, std::uint32_t maskKey, size_t start) {
+    std::uint64_t key64 = ((std::uint64_t)maskKey << 32) | maskKey;
+    size_t i = start;
+
+    for (; i + 8 <= length; i += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, src + i, 8);
+        word ^= key64;
+        std::memcpy(dst + i, &word, 8);
+    }
+
+    const unsigned char* key = reinterpret_cast<const unsigned char*>(&maskKey);
+    for (; i < length; ++i) {
+        dst[i] = (char)(src[i] ^ key[i & 3]);
+    }
+}
+
+#ifdef WEBSOCKET_FRAME_X86
+
+// SSE2 is part of the x86-64 baseline, so this path needs no dispatch there
+static size_t maskSse2(char* dst, const char* src, size_t length, std::uint32_t maskKey) {
+    const __m128i key = _mm_set1_epi32((int)maskKey);
+    size_t i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(data, key));
+    }
+
+    return i;
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("avx2")))
+#endif
+static size_t maskAvx2(char* dst, const char* src, size_t length, std::uint32_t maskKey) {
+    const __m256i key = _mm256_set1_epi32((int)maskKey);
+    size_t i = 0;
+
+    for (; i + 32 <= length; i += 32) {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_xor_si256(data, key));
+    }
+
+    return i;
+}
+
+// CPU and OS support for AVX2 (checked once)
+static bool detectAvx2() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx) return false;
+    if ((_xgetbv(0) & 0x6) != 0x6) return false;   // XMM and YMM state enabled
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+static const bool hasAvx2 = detectAvx2();
+
+#endif
+
+// XOR payload bytes with the repeating mask. A 16/32-byte vector holds the
+// key four/eight times, so every vector step stays in phase with index 0.
+void maskWebSocketPayload(char* dst, const char* src, size_t length, std::uint32_t maskKey) {
+    size_t done = 0;
+
+#ifdef WEBSOCKET_FRAME_X86
+    if (hasAvx2 && length >= 32) {
+        done = maskAvx2(dst, src, length, maskKey);
+    }
+    if (length - done >= 16) {
+        done += maskSse2(dst + done, src + done, length - done, maskKey);
+    }
+#endif
+
+    // done is always a multiple of 16, so the mask is still in phase here
+    maskScalar(dst, src, length, maskKey, done);
+}
+
+// Encode a full client frame, writing the header in place and masking
+// the payload directly into the destination buffer
+void encodeClientFrame(std::string& frame, WebSocketOpcode opcode, const char* payload, size_t length) {
+    std::uint32_t maskKey = nextWebSocketMaskKey();
+
+    char header[kMaxClientFrameHeaderSize];
+    size_t headerSize = writeClientFrameHeader(header, opcode, length, maskKey);
+
+    frame.resize(headerSize + length);
+    char* out = &frame[0];
+    std::memcpy(out, header, headerSize);
+    maskWebSocketPayload(out + headerSize, payload, length, maskKey);
+}
+
+// Per-thread xorshift64* generator; seeded from random_device, the thread id
+// and the clock so concurrent producers never share a sequence
+std::uint32_t nextWebSocketMaskKey() {
+    static thread_local std::uint64_t state = []() {
+        std::random_device rd;
+        std::uint64_t seed = ((std::uint64_t)rd() << 32) ^ rd();
+        seed ^= (std::uint64_t)std::hash<std::thread::id>()(std::this_thread::get_id());
+        seed ^= (std::uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+        return seed ? seed : 0x9E3779B97F4A7C15ull;
+    }();
+
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return (std::uint32_t)((state * 0x2545F4914F6CDD1Dull) >> 32);
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// RFC 6455 frame opcodes
+enum class WebSocketOpcode : std::uint8_t {
+    Continuation = 0x0,
+    Text = 0x1,
+    Binary = 0x2,
+    Close = 0x8,
+    Ping = 0x9,
+    Pong = 0xA
+};
+
+// Largest header a masked client frame can need (2 + 8 length + 4 mask)
+constexpr size_t kMaxClientFrameHeaderSize = 14;
+
+// Write a masked client frame header into `out` (at least
+// kMaxClientFrameHeaderSize bytes). Returns the number of bytes written.
+size_t writeClientFrameHeader(char* out, WebSocketOpcode opcode, size_t payloadLength,
+                              std::uint32_t maskKey, bool fin = true);
+
+// XOR `length` bytes of `src` with the repeating 4-byte mask into `dst`
+// (which may alias `src`). Uses AVX2 or SSE2 where available.
+void maskWebSocketPayload(char* dst, const char* src, size_t length, std::uint32_t maskKey);
+
+// Encode a complete masked client frame into `frame`, replacing its contents.
+// Reuses the string's capacity, so steady-state encoding does not allocate.
+void encodeClientFrame(std::string& frame, WebSocketOpcode opcode, const char* payload, size_t length);
+
+// Mask key from a fast per-thread PRNG (xorshift, seeded once per thread)
+std::uint32_t nextWebSocketMaskKey();
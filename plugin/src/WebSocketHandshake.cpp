@@ -0,0 +1,179 @@
+#include "WebSocketHandshake.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+
+// GUID appended to the client key before hashing (RFC 6455 section 1.3)
+static const char* kWebSocketGuid = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+// Minimal SHA-1, only used to verify Sec-WebSocket-Accept
+static std::string sha1(const std::string& message) {
+    std::uint32_t h[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+
+    std::string data = message;
+    std::uint64_t bitLength = (std::uint64_t)message.size() * 8;
+    data += (char)0x80;
+    while (data.size() % 64 != 56) {
+        data += (char)0x00;
+    }
+    for (int i = 7; i >= 0; --i) {
+        data += (char)((bitLength >> (i * 8)) & 0xFF);
+    }
+
+    auto rotl = [](std::uint32_t value, int bits) {
+        return (value << bits) | (value >> (32 - bits));
+    };
+
+    for (size_t chunk = 0; chunk < data.size(); chunk += 64) {
+        std::uint32_t w[80];
+        for (int i = 0; i < 16; ++i) {
+            const unsigned char* p = reinterpret_cast<const unsigned char*>(data.data() + chunk + i * 4);
+            w[i] = ((std::uint32_t)p[0] << 24) | ((std::uint32_t)p[1] << 16) | ((std::uint32_t)p[2] << 8) | p[3];
+        }
+        for (int i = 16; i < 80; ++i) {
+            w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        }
+
+        std::uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for (int i = 0; i < 80; ++i) {
+            std::uint32_t f, k;
+            if (i < 20)      { f = (b & c) | (~b & d);          k = 0x5A827999; }
+            else if (i < 40) { f = b ^ c ^ d;                   k = 0x6ED9EBA1; }
+            else if (i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8F1BBCDC; }
+            else             { f = b ^ c ^ d;                   k = 0xCA62C1D6; }
+
+            std::uint32_t temp = rotl(a, 5) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = rotl(b, 30);
+            b = a;
+            a = temp;
+        }
+
+        h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e;
+    }
+
+    std::string digest;
+    for (std::uint32_t word : h) {
+        for (int i = 3; i >= 0; --i) {
+            digest += (char)((word >> (i * 8)) & 0xFF);
+        }
+    }
+    return digest;
+}
+
+// Simple base64 encoding
+std::string base64Encode(const std::string& input) {
+    const std::string chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string result;
+    int val = 0, valb = -6;
+
+    for (unsigned char c : input) {
+        val = (val << 8) + c;
+        valb += 8;
+        while (valb >= 0) {
+            result.push_back(chars[(val >> valb) & 0x3F]);
+            valb -= 6;
+        }
+    }
+
+    if (valb > -6) result.push_back(chars[((val << 8) >> (valb + 8)) & 0x3F]);
+    while (result.size() % 4) result.push_back('=');
+
+    return result;
+}
+
+// Expected Sec-WebSocket-Accept for the key we sent
+std::string computeWebSocketAccept(const std::string& key) {
+    return base64Encode(sha1(key + kWebSocketGuid));
+}
+
+// Build the HTTP upgrade request
+std::string buildHandshakeRequest(const std::string& host, const std::string& port,
+                                  const std::string& path, const std::string& key,
+                                  const std::string& protocols) {
+    std::string request = "GET " + path + " HTTP/1.1\r\n";
+    request += "Host: " + host + ":" + port + "\r\n";
+    request += "Upgrade: websocket\r\n";
+    request += "Connection: Upgrade\r\n";
+    request += "Sec-WebSocket-Key: " + key + "\r\n";
+    request += "Sec-WebSocket-Version: 13\r\n";
+    if (!protocols.empty()) {
+        request += "Sec-WebSocket-Protocol: " + protocols + "\r\n";
+    }
+    request += "\r\n";
+    return request;
+}
+
+static std::string toLower(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(),
+        [](unsigned char c) { return (char)std::tolower(c); });
+    return value;
+}
+
+static std::string trim(const std::string& value) {
+    size_t start = value.find_first_not_of(" \t");
+    if (start == std::string::npos) return "";
+    size_t end = value.find_last_not_of(" \t");
+    return value.substr(start, end - start + 1);
+}
+
+// Validate the status line and upgrade headers of the server's response
+HandshakeResponse parseHandshakeResponse(const std::string& response, const std::string& key) {
+    HandshakeResponse result;
+
+    size_t headerEnd = response.find("\r\n\r\n");
+    if (headerEnd == std::string::npos) {
+        if (response.size() > kMaxHandshakeResponseSize) {
+            result.status = HandshakeResponse::Status::Rejected;
+            result.error = "Handshake response too large";
+        }
+        return result;
+    }
+    result.headerLength = headerEnd + 4;
+    result.status = HandshakeResponse::Status::Rejected;
+
+    size_t lineEnd = response.find("\r\n");
+    std::string statusLine = response.substr(0, lineEnd);
+    if (statusLine.compare(0, 9, "HTTP/1.1 ") != 0 || statusLine.compare(9, 3, "101") != 0) {
+        result.error = "Unexpected status: " + statusLine;
+        return result;
+    }
+
+    bool upgrade = false;
+    bool connectionUpgrade = false;
+    std::string accept;
+
+    size_t pos = lineEnd + 2;
+    while (pos < headerEnd) {
+        size_t next = response.find("\r\n", pos);
+        std::string line = response.substr(pos, next - pos);
+        pos = next + 2;
+
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) continue;
+
+        std::string name = toLower(trim(line.substr(0, colon)));
+        std::string value = trim(line.substr(colon + 1));
+
+        if (name == "upgrade") {
+            upgrade = (toLower(value) == "websocket");
+        } else if (name == "connection") {
+            connectionUpgrade = (toLower(value).find("upgrade") != std::string::npos);
+        } else if (name == "sec-websocket-accept") {
+            accept = value;
+        } else if (name == "sec-websocket-protocol") {
+            result.protocol = value;
+        }
+    }
+
+    if (!upgrade || !connectionUpgrade) {
+        result.error = "Missing Upgrade/Connection headers";
+    } else if (accept != computeWebSocketAccept(key)) {
+        result.error = "Invalid Sec-WebSocket-Accept";
+    } else {
+        result.status = HandshakeResponse::Status::Accepted;
+    }
+    return result;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Client side of the RFC 6455 opening handshake
+
+// Outcome of feeding the bytes received so far to parseHandshakeResponse
+struct HandshakeResponse {
+    enum class Status {
+        Incomplete,     // header terminator not seen yet
+        Accepted,       // 101 with a valid Sec-WebSocket-Accept
+        Rejected        // anything else; see error
+    };
+
+    Status status = Status::Incomplete;
+    size_t headerLength = 0;    // bytes up to and including the blank line
+    std::string protocol;       // Sec-WebSocket-Protocol chosen by the server, if any
+    std::string error;
+};
+
+// Largest response header we are willing to buffer
+constexpr size_t kMaxHandshakeResponseSize = 8 * 1024;
+
+// Build the HTTP upgrade request. `protocols` is the comma-separated
+// Sec-WebSocket-Protocol offer; the header is omitted when empty.
+std::string buildHandshakeRequest(const std::string& host, const std::string& port,
+                                  const std::string& path, const std::string& key,
+                                  const std::string& protocols = std::string());
+
+// Parse the server's response once the full header block has arrived
+HandshakeResponse parseHandshakeResponse(const std::string& response, const std::string& key);
+
+// Sec-WebSocket-Accept value the server must send for `key`
+std::string computeWebSocketAccept(const std::string& key);
+
+// Standard base64 (with padding)
+std::string base64Encode(const std::string& input);
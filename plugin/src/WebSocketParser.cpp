@@ -0,0 +1,144 @@
+#include "WebSocketParser.h"
+
+// Minimum free space offered to each recv()
+static const size_t kMinReadSpace = 16 * 1024;
+
+WebSocketParser::WebSocketParser(size_t initialCapacity, size_t maxMessageSize)
+    : ring(initialCapacity), maxMessageSize(maxMessageSize), bytesNeeded(0),
+      inFragmentedMessage(false), fragmentedIsBinary(false) {
+}
+
+// Space for the next recv(): enough for the pending frame if its size is known
+char* WebSocketParser::prepareWrite(size_t& available) {
+    size_t minBytes = kMinReadSpace;
+    if (bytesNeeded > ring.size() && bytesNeeded - ring.size() > minBytes) {
+        minBytes = bytesNeeded - ring.size();
+    }
+    return ring.prepareWrite(minBytes, available);
+}
+
+void WebSocketParser::commitWrite(size_t bytes) {
+    ring.commitWrite(bytes);
+}
+
+// Decode every complete frame in the ring
+WebSocketParser::Result WebSocketParser::parse() {
+    for (;;) {
+        size_t buffered = ring.size();
+        if (buffered < 2) {
+            bytesNeeded = 2;
+            return Result::Ok;
+        }
+
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(ring.data());
+        bool fin = (p[0] & 0x80) != 0;
+        unsigned rsv = p[0] & 0x70;
+        WebSocketOpcode opcode = (WebSocketOpcode)(p[0] & 0x0F);
+        bool masked = (p[1] & 0x80) != 0;
+        std::uint64_t length = p[1] & 0x7F;
+        size_t headerSize = 2;
+
+        // No extensions are negotiated and servers must not mask
+        if (rsv != 0 || masked) {
+            return Result::ProtocolError;
+        }
+
+        if (length == 126) {
+            if (buffered < 4) {
+                bytesNeeded = 4;
+                return Result::Ok;
+            }
+            length = ((std::uint64_t)p[2] << 8) | p[3];
+            headerSize = 4;
+        } else if (length == 127) {
+            if (buffered < 10) {
+                bytesNeeded = 10;
+                return Result::Ok;
+            }
+            length = 0;
+            for (int i = 0; i < 8; ++i) {
+                length = (length << 8) | p[2 + i];
+            }
+            headerSize = 10;
+        }
+
+        bool isControl = ((std::uint8_t)opcode & 0x08) != 0;
+        if (isControl && (!fin || length > 125)) {
+            return Result::ProtocolError;
+        }
+        if (length > maxMessageSize ||
+            (inFragmentedMessage && !isControl && fragments.size() + length > maxMessageSize)) {
+            return Result::MessageTooBig;
+        }
+
+        size_t frameSize = headerSize + (size_t)length;
+        if (buffered < frameSize) {
+            bytesNeeded = frameSize;
+            return Result::Ok;
+        }
+
+        std::string_view payload(ring.data() + headerSize, (size_t)length);
+
+        switch (opcode) {
+            case WebSocketOpcode::Text:
+            case WebSocketOpcode::Binary:
+                if (inFragmentedMessage) {
+                    return Result::ProtocolError;  // new message before the last one finished
+                }
+                if (fin) {
+                    // Common case: hand out a view straight into the ring
+                    if (onMessage) {
+                        onMessage(payload, opcode == WebSocketOpcode::Binary);
+                    }
+                } else {
+                    inFragmentedMessage = true;
+                    fragmentedIsBinary = (opcode == WebSocketOpcode::Binary);
+                    fragments.assign(payload.data(), payload.size());
+                }
+                break;
+
+            case WebSocketOpcode::Continuation:
+                if (!inFragmentedMessage) {
+                    return Result::ProtocolError;
+                }
+                fragments.append(payload.data(), payload.size());
+                if (fin) {
+                    inFragmentedMessage = false;
+                    if (onMessage) {
+                        onMessage(std::string_view(fragments), fragmentedIsBinary);
+                    }
+                }
+                break;
+
+            case WebSocketOpcode::Close:
+            case WebSocketOpcode::Ping:
+            case WebSocketOpcode::Pong:
+                if (onControl) {
+                    onControl(opcode, payload);
+                }
+                break;
+
+            default:
+                return Result::ProtocolError;  // reserved opcode
+        }
+
+        ring.consume(frameSize);
+        bytesNeeded = 0;
+    }
+}
+
+// Forget buffered bytes and any half-assembled message
+void WebSocketParser::reset() {
+    ring.clear();
+    fragments.clear();
+    inFragmentedMessage = false;
+    bytesNeeded = 0;
+}
+
+void WebSocketParser::setMessageCallback(MessageCallback callback) {
+    onMessage = std::move(callback);
+}
+
+void WebSocketParser::setControlCallback(ControlCallback callback) {
+    onControl = std::move(callback);
+}
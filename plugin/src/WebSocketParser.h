@@ -0,0 +1,62 @@
+#pragma once
+
+#include "ByteRing.h"
+#include "WebSocketFrame.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+// Streaming RFC 6455 decoder for server->client traffic. Bytes from recv()
+// are written straight into the parser's ring; parse() then consumes every
+// complete frame, whatever the recv() boundaries were.
+//
+// Unfragmented messages are delivered as a string_view into the ring (no
+// copy). Fragmented messages are assembled in a reusable buffer. Control
+// frames (ping, pong, close) may arrive between fragments and are passed to
+// the control callback as soon as they are complete. Views are only valid
+// for the duration of the callback.
+class WebSocketParser {
+public:
+    enum class Result {
+        Ok,
+        ProtocolError,
+        MessageTooBig
+    };
+
+    using MessageCallback = std::function<void(std::string_view payload, bool isBinary)>;
+    using ControlCallback = std::function<void(WebSocketOpcode opcode, std::string_view payload)>;
+
+    explicit WebSocketParser(size_t initialCapacity = 64 * 1024,
+                             size_t maxMessageSize = 16 * 1024 * 1024);
+
+    // Receive side: get space for the next recv() and commit what it wrote
+    char* prepareWrite(size_t& available);
+    void commitWrite(size_t bytes);
+
+    // Decode all complete frames currently buffered
+    Result parse();
+
+    // Drop any buffered or partially assembled data (new connection)
+    void reset();
+
+    void setMessageCallback(MessageCallback callback);
+    void setControlCallback(ControlCallback callback);
+
+private:
+    ByteRing ring;
+    size_t maxMessageSize;
+    size_t bytesNeeded;        // size of the frame at the read cursor, once known
+
+    // Fragmented message being assembled
+    std::string fragments;
+    bool inFragmentedMessage;
+    bool fragmentedIsBinary;
+
+    MessageCallback onMessage;
+    ControlCallback onControl;
+
+    // Disable copying
+    WebSocketParser(const WebSocketParser&) = delete;
+    WebSocketParser& operator=(const WebSocketParser&) = delete;
+};
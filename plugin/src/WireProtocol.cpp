@@ -0,0 +1,43 @@
+#include "WireProtocol.h"
+
+// LEB128: seven bits per byte, high bit set on all but the last
+size_t writeVarint(char* out, std::uint64_t value) {
+    size_t length = 0;
+    while (value >= 0x80) {
+        out[length++] = (char)((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out[length++] = (char)value;
+    return length;
+}
+
+// Fixed header shared by every message type
+static size_t writeWireHeader(char* out, WireMessageType type, std::uint16_t sequence) {
+    out[0] = (char)kWireMagic;
+    out[1] = (char)kWireVersion;
+    out[2] = (char)type;
+    out[3] = 0;
+    out[4] = (char)(sequence & 0xFF);
+    out[5] = (char)(sequence >> 8);
+    return kWireHeaderSize;
+}
+
+size_t encodeStateMessage(char* out, std::uint16_t sequence, std::uint32_t stateId,
+                          std::uint64_t timestamp) {
+    size_t length = writeWireHeader(out, WireMessageType::State, sequence);
+    length += writeVarint(out + length, stateId);
+    length += writeVarint(out + length, timestamp);
+    return length;
+}
+
+size_t encodeEventMessage(char* out, std::uint16_t sequence, std::uint32_t eventId,
+                          std::uint64_t timestamp, std::int64_t value) {
+    // Zigzag keeps small negative values short
+    std::uint64_t zigzag = ((std::uint64_t)value << 1) ^ (std::uint64_t)(value >> 63);
+
+    size_t length = writeWireHeader(out, WireMessageType::Event, sequence);
+    length += writeVarint(out + length, eventId);
+    length += writeVarint(out + length, timestamp);
+    length += writeVarint(out + length, zigzag);
+    return length;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Plugin -> desktop message encodings, picked per connection through
+// Sec-WebSocket-Protocol. A server that selects no protocol, or
+// gamestate.json.v1, gets JSON state messages only, so existing desktop
+// apps keep working unchanged. Events (and perf stats) go only to a server
+// that selected gamestate.json.v2 or gamestate.bin.v1.
+//
+// Binary messages travel in WebSocket binary frames:
+//
+//   offset  size  field
+//   0       1     magic 'G' (0x47)
+//   1       1     version (1)
+//   2       1     message type (WireMessageType)
+//   3       1     flags (0, reserved)
+//   4       2     sequence number, little-endian, per connection, wraps
+//   6       ...   LEB128 varint fields:
+//                   State: state id, timestamp
+//                   Event: event id, timestamp, value (zigzag-encoded)
+//
+// Timestamps carry the same value as the JSON "timestamp" field. State ids
+// follow the GameState enum (0 inMenu, 1 inGame, 2 inReplay, 3 gamePaused,
+// 4 unknown). Event ids are WireEventId; the JSON form is
+// {"event": name, "value": v, "timestamp": t}. The desktop-side decoder is
+// backend/gameStateProtocol.js.
+
+// Sec-WebSocket-Protocol tokens
+constexpr const char* kBinaryWireProtocol = "gamestate.bin.v1";
+constexpr const char* kJsonWireProtocol = "gamestate.json.v1";
+constexpr const char* kJsonEventsWireProtocol = "gamestate.json.v2";
+
+enum class WireFormat : std::uint8_t {
+    Json,           // states only
+    Binary,
+    JsonEvents      // states, events and perf stats
+};
+
+enum class WireMessageType : std::uint8_t {
+    State = 1,
+    Event = 2
+};
+
+// Event ids; only append
+enum class WireEventId : std::uint32_t {
+    Phase = 1       // "phase", value = MatchPhase id (MatchPhase.h)
+};
+
+constexpr std::uint8_t kWireMagic = 0x47;
+constexpr std::uint8_t kWireVersion = 1;
+constexpr size_t kWireHeaderSize = 6;
+
+// Largest binary message (header plus three 10-byte varints)
+constexpr size_t kMaxWireMessageSize = kWireHeaderSize + 3 * 10;
+
+// LEB128 varint; `out` needs room for 10 bytes. Returns bytes written.
+size_t writeVarint(char* out, std::uint64_t value);
+
+// Encode a message into `out` (at least kMaxWireMessageSize bytes).
+// Return the number of bytes written.
+size_t encodeStateMessage(char* out, std::uint16_t sequence, std::uint32_t stateId,
+                          std::uint64_t timestamp);
+size_t encodeEventMessage(char* out, std::uint16_t sequence, std::uint32_t eventId,
+                          std::uint64_t timestamp, std::int64_t value);
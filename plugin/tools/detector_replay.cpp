@@ -0,0 +1,302 @@
+// Replays probe traces (ProbeTrace.h, recorded in game with
+// "gamestate_trace start" / "gamestate_trace stop") through
+// GameStateDetector as fast as it will go. Transitions go to stdout, one
+// line each, so two builds can be diffed; timing and allocation counts go
+// to stderr.
+//
+// Usage: detector_replay [--mode hooks|tick] [--interval-ms N] <trace>...
+//        detector_replay --synthetic <matches> [--save <trace>]
+//
+// --synthetic scripts matches (countdowns, goals, replays, a pause, the
+// podium) through the same recorder the plugin uses, for when no recorded
+// trace is at hand.
+
+#include "GameStateDetector.h"
+#include "LatencyHistogram.h"
+#include "ProbeTrace.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+// Heap allocations while countingAllocations is set
+static std::atomic<bool> countingAllocations(false);
+static std::atomic<std::uint64_t> allocationCount(0);
+
+void* operator new(std::size_t size) {
+    if (countingAllocations.load(std::memory_order_relaxed)) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+using ReplayClock = std::chrono::steady_clock;
+
+struct Transition {
+    std::uint64_t tick;
+    std::int64_t ms;
+    bool phase;
+    int value;
+};
+
+static const char* stateName(GameState state) {
+    switch (state) {
+        case GameState::inMenu: return "inMenu";
+        case GameState::inGame: return "inGame";
+        case GameState::inReplay: return "inReplay";
+        case GameState::gamePaused: return "gamePaused";
+        default: return "unknown";
+    }
+}
+
+// Scripted game for --synthetic: 60 ticks a second, readings set by hand
+class ScriptedGame : public GameProbe {
+public:
+    explicit ScriptedGame(std::int64_t startedAtMs) : recorder(*this, startedAtMs) {}
+
+    GameReading read() override { return reading; }
+
+    void run(double seconds) {
+        int ticks = (int)(seconds * 60.0);
+        for (int i = 0; i < ticks; ++i) {
+            nowMs += (i % 3 == 2) ? 16 : 17;
+            if (reading.phaseInputs.waitTimeRemaining > 0) {
+                reading.phaseInputs.waitTimeRemaining = 3 - (int)(i / 60);
+            }
+            recorder.beginTick(nowMs);
+        }
+    }
+
+    void event(GameEvent event, int value = 0) { recorder.recordEvent(event, value); }
+
+    GameReading reading;
+    ProbeTraceRecorder recorder;
+    std::int64_t nowMs = 0;
+};
+
+static void scriptMatch(ScriptedGame& game, int number) {
+    MatchPhaseInputs& in = game.reading.phaseInputs;
+    MatchInfo& match = game.reading.match;
+
+    game.reading = GameReading();
+    game.run(8.0);                          // menu
+    game.event(GameEvent::preLoadMap);
+    game.run(1.5);                          // loading screen
+
+    game.reading.inGame = true;
+    in.inMatch = true;
+    match = MatchInfo();
+    match.secondsRemaining = 300;
+    auto countdown = [&] {
+        in.roundActive = false;
+        in.ballHasBeenHit = false;
+        in.waitTimeRemaining = 3;
+        game.event(GameEvent::countdownBegin);
+        game.run(3.0);
+        in.waitTimeRemaining = 0;
+        in.roundActive = true;              // kickoff until the first touch
+        game.run(1.2);
+        in.ballHasBeenHit = true;
+    };
+    game.event(GameEvent::postLoadMap);
+    countdown();
+
+    for (int goal = 0; goal < 4; ++goal) {
+        game.run(45.0);
+        match.secondsRemaining -= 45;
+
+        if (goal == 1 && number % 2 == 0) {     // pause menu for a few seconds
+            in.paused = true;
+            game.event(GameEvent::pauseToggled);
+            game.run(4.0);
+            in.paused = false;
+            game.event(GameEvent::pauseToggled);
+            game.run(10.0);
+        }
+
+        (goal + number) % 2 ? ++match.blueScore : ++match.orangeScore;
+        in.roundActive = false;
+        game.run(2.5);                      // goal explosion
+        in.inReplay = true;
+        game.event(GameEvent::replayBegin, 1);
+        game.run(6.0);
+        in.inReplay = false;
+        game.event(GameEvent::replayEnd);
+        countdown();
+    }
+
+    // Tied at the buzzer every third match
+    if (number % 3 == 2 && match.blueScore == match.orangeScore) {
+        ++match.orangeScore;
+    }
+    game.run(60.0);
+    match.secondsRemaining = 0;
+    in.matchEnded = true;
+    in.roundActive = false;
+    game.event(GameEvent::matchEnded);
+    game.run(12.0);                         // podium and scoreboard
+
+    game.event(GameEvent::matchDestroyed);
+    game.event(GameEvent::preLoadMap);
+    game.reading = GameReading();
+    game.run(1.5);
+    game.event(GameEvent::postLoadMap);
+}
+
+static int synthesize(int matches, const std::string& savePath) {
+    ScriptedGame game(1790000000000LL);
+    for (int i = 0; i < matches; ++i) {
+        scriptMatch(game, i);
+    }
+    game.run(5.0);
+
+    if (!game.recorder.save(savePath)) {
+        std::fprintf(stderr, "cannot write %s\n", savePath.c_str());
+        return 1;
+    }
+    std::fprintf(stderr, "%s: %d matches, %llu ticks, %zu bytes\n", savePath.c_str(), matches,
+                 (unsigned long long)game.recorder.getTickCount(), game.recorder.getByteCount());
+    return 0;
+}
+
+static bool replay(const std::string& path, DetectionMode mode, int intervalMs) {
+    ProbeTrace trace;
+    std::string error;
+    if (!trace.load(path, error)) {
+        std::fprintf(stderr, "%s: %s\n", path.c_str(), error.c_str());
+        return false;
+    }
+
+    VirtualClock clock;
+    TraceProbe probe;
+    GameStateDetector detector(&probe, clock);
+
+    std::uint64_t tick = 0;
+    std::int64_t traceMs = 0;
+    std::vector<Transition> transitions;
+    transitions.reserve(1 << 16);
+    detector.setStateChangedCallback([&](GameState state) {
+        transitions.push_back({ tick, traceMs, false, (int)state });
+    });
+    detector.setPhaseChangedCallback([&](MatchPhase phase) {
+        transitions.push_back({ tick, traceMs, true, (int)phase });
+    });
+    detector.startDetection(mode, intervalMs);
+
+    // Time spent in the detector per tick, events included
+    LatencyHistogram tickCost;
+    std::uint64_t pendingNs = 0;
+    std::uint64_t detectorNs = 0;
+
+    allocationCount = 0;
+    countingAllocations = true;
+    auto wallStart = ReplayClock::now();
+
+    for (const ProbeTrace::Step& step : trace.getSteps()) {
+        if (step.record == ProbeTraceRecord::reading) {
+            probe.set(trace.getReading(step.value));
+            continue;
+        }
+
+        if (step.record == ProbeTraceRecord::tick) {
+            if (tick > 0) tickCost.record(pendingNs);
+            pendingNs = 0;
+            ++tick;
+            traceMs += step.value;
+            clock.advance(std::chrono::milliseconds(step.value));
+        }
+
+        auto start = ReplayClock::now();
+        if (step.record == ProbeTraceRecord::tick) {
+            detector.onTick();
+        } else {
+            detector.onGameEvent(step.event, step.value);
+        }
+        std::uint64_t ns = (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            ReplayClock::now() - start).count();
+        pendingNs += ns;
+        detectorNs += ns;
+    }
+    if (tick > 0) tickCost.record(pendingNs);
+
+    double wallMs = std::chrono::duration<double, std::milli>(ReplayClock::now() - wallStart).count();
+    countingAllocations = false;
+    std::uint64_t allocations = allocationCount.load();
+    detector.stopDetection();
+
+    std::printf("# %s\n", path.c_str());
+    for (const Transition& t : transitions) {
+        std::printf("%10.3f s  tick %8llu  %-6s %s\n", t.ms / 1000.0, (unsigned long long)t.tick,
+                    t.phase ? "phase" : "state",
+                    t.phase ? kMatchPhaseNames[(size_t)t.value] : stateName((GameState)t.value));
+    }
+
+    double traceSeconds = traceMs / 1000.0;
+    std::fprintf(stderr, "%s: %llu ticks (%.0f s of play), %zu transitions\n", path.c_str(),
+                 (unsigned long long)tick, traceSeconds, transitions.size());
+    std::fprintf(stderr, "  replay %.1f ms, %.0fx real time; detector %.1f ns/tick mean\n",
+                 wallMs, wallMs > 0 ? traceSeconds * 1000.0 / wallMs : 0.0,
+                 tick ? (double)detectorNs / tick : 0.0);
+    std::fprintf(stderr, "  per tick: p50 %llu ns, p99 %llu ns, p99.9 %llu ns, max %llu ns\n",
+                 (unsigned long long)tickCost.percentile(0.50), (unsigned long long)tickCost.percentile(0.99),
+                 (unsigned long long)tickCost.percentile(0.999), (unsigned long long)tickCost.getMax());
+    std::fprintf(stderr, "  allocations %llu (%.4f per tick)\n", (unsigned long long)allocations,
+                 tick ? (double)allocations / tick : 0.0);
+    for (const std::string& line : detector.describeHookCost()) {
+        std::fprintf(stderr, "  %s\n", line.c_str());
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    DetectionMode mode = DetectionMode::eventHooks;
+    int intervalMs = 1000;
+    int syntheticMatches = 0;
+    std::string savePath = "synthetic.gstrace";
+    std::vector<std::string> traces;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--mode" && i + 1 < argc) {
+            std::string name = argv[++i];
+            if (name == "tick") {
+                mode = DetectionMode::tickProbe;
+            } else if (name != "hooks") {
+                std::fprintf(stderr, "unsupported mode %s (hooks or tick; polling depends on thread timing)\n", name.c_str());
+                return 2;
+            }
+        } else if (arg == "--interval-ms" && i + 1 < argc) {
+            intervalMs = std::atoi(argv[++i]);
+        } else if (arg == "--synthetic" && i + 1 < argc) {
+            syntheticMatches = std::atoi(argv[++i]);
+        } else if (arg == "--save" && i + 1 < argc) {
+            savePath = argv[++i];
+        } else {
+            traces.push_back(arg);
+        }
+    }
+
+    if (syntheticMatches > 0) {
+        return synthesize(syntheticMatches, savePath);
+    }
+
+    if (traces.empty()) {
+        std::fprintf(stderr, "Usage: detector_replay [--mode hooks|tick] [--interval-ms N] <trace>...\n"
+                             "       detector_replay --synthetic <matches> [--save <trace>]\n");
+        return 2;
+    }
+
+    bool ok = true;
+    for (const std::string& path : traces) {
+        ok = replay(path, mode, intervalMs) && ok;
+    }
+    return ok ? 0 : 1;
+}
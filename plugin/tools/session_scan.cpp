@@ -0,0 +1,211 @@
+// Scans session recordings (.gsr) and prints one line per match: start,
+// length, final score, goals, overtime, frames and ball speed. Only the
+// event columns, the frame times and the ball velocity are decoded, so a
+// season of recordings scans in seconds.
+//
+// Usage: session_scan <file-or-directory>...
+
+#include "MatchPhase.h"
+#include "SessionReader.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+struct MatchSummary {
+    std::int64_t startMs = 0;
+    std::int64_t endMs = 0;
+    int blueScore = 0;
+    int orangeScore = 0;
+    int goals = 0;
+    bool overtime = false;
+    bool finished = false;      // reached the podium (not abandoned)
+    std::uint64_t frames = 0;
+    double ballSpeedSum = 0.0;
+    double ballMaxSpeed = 0.0;
+    std::uint64_t ballFrames = 0;
+};
+
+struct ScanTotals {
+    size_t files = 0;
+    size_t unreadable = 0;
+    size_t matches = 0;
+    std::uint64_t frames = 0;
+    std::uint64_t bytes = 0;
+};
+
+static bool isMatchPhase(MatchPhase phase) {
+    return phase != MatchPhase::menu && phase != MatchPhase::postGame && phase != MatchPhase::unknown;
+}
+
+static std::string formatTime(std::int64_t unixMs) {
+    std::time_t seconds = (std::time_t)(unixMs / 1000);
+    std::tm utc = {};
+#ifdef _WIN32
+    gmtime_s(&utc, &seconds);
+#else
+    gmtime_r(&seconds, &utc);
+#endif
+    char text[32];
+    std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &utc);
+    return text;
+}
+
+static void printMatch(size_t number, const MatchSummary& match) {
+    long long seconds = (match.endMs - match.startMs) / 1000;
+    double avgSpeed = match.ballFrames ? match.ballSpeedSum / match.ballFrames : 0.0;
+    std::printf("  match %-3zu %s  %2lld:%02lld  blue %d - %d orange  goals %-2d %s%s frames %-7llu ball max %4.0f avg %4.0f uu/s\n",
+                number, formatTime(match.startMs).c_str(), seconds / 60, seconds % 60,
+                match.blueScore, match.orangeScore, match.goals,
+                match.overtime ? "OT " : "   ", match.finished ? "        " : "(left)  ",
+                (unsigned long long)match.frames, match.ballMaxSpeed, avgSpeed);
+}
+
+// Split one recording into matches by its phase events
+static void scanFile(const std::string& path, ScanTotals& totals) {
+    SessionReader reader;
+    if (!reader.open(path)) {
+        std::printf("%s: not a session recording\n", path.c_str());
+        ++totals.unreadable;
+        return;
+    }
+    ++totals.files;
+    totals.bytes += reader.getFileSize();
+    std::printf("%s%s\n", path.c_str(), reader.hasFooter() ? "" : " (not closed, recovered)");
+
+    std::vector<MatchSummary> matches;
+    MatchSummary current;
+    bool inMatch = false;
+    int lastBlue = 0, lastOrange = 0;
+
+    std::vector<SessionEvent> events;
+    std::vector<std::int64_t> times, velocityX, velocityY, velocityZ, present;
+    const std::uint16_t velocityColumns[3] = {
+        sessionEntityColumn(kTelemetryBall, TelemetryField::velocityX),
+        sessionEntityColumn(kTelemetryBall, TelemetryField::velocityY),
+        sessionEntityColumn(kTelemetryBall, TelemetryField::velocityZ)
+    };
+
+    for (size_t chunk = 0; chunk < reader.getChunkCount(); ++chunk) {
+        const SessionChunkIndex& info = reader.getChunk(chunk);
+        reader.readEvents(chunk, events);
+
+        // Frames between events belong to whichever match is open at their time
+        bool haveFrames = info.frameCount > 0 && reader.readColumn(chunk, kSessionFrameTimeColumn, times);
+        bool haveBall = haveFrames && (info.entityMask & (1u << kTelemetryBall)) &&
+                        reader.readColumn(chunk, kSessionPresentColumn, present) &&
+                        reader.readColumn(chunk, velocityColumns[0], velocityX) &&
+                        reader.readColumn(chunk, velocityColumns[1], velocityY) &&
+                        reader.readColumn(chunk, velocityColumns[2], velocityZ);
+        size_t frame = 0;
+        size_t frameCount = haveFrames ? times.size() : 0;
+        totals.frames += frameCount;
+
+        auto consumeFramesUntil = [&](std::int64_t timeMs) {
+            for (; frame < frameCount && times[frame] < timeMs; ++frame) {
+                if (!inMatch) continue;
+                ++current.frames;
+                if (haveBall && (present[frame] & (1 << kTelemetryBall))) {
+                    double vx = velocityX[frame] / kTelemetryVelocityScale;
+                    double vy = velocityY[frame] / kTelemetryVelocityScale;
+                    double vz = velocityZ[frame] / kTelemetryVelocityScale;
+                    double speed = std::sqrt(vx * vx + vy * vy + vz * vz);
+                    current.ballSpeedSum += speed;
+                    current.ballMaxSpeed = std::max(current.ballMaxSpeed, speed);
+                    ++current.ballFrames;
+                }
+            }
+        };
+
+        for (const SessionEvent& event : events) {
+            consumeFramesUntil(event.timeMs);
+
+            if (event.kind == SessionEventKind::score) {
+                int blue = (int)(event.value >> 16);
+                int orange = (int)(event.value & 0xFFFF);
+                if (inMatch && (blue > lastBlue || orange > lastOrange)) {
+                    current.goals += std::max(0, blue - lastBlue) + std::max(0, orange - lastOrange);
+                }
+                lastBlue = blue;
+                lastOrange = orange;
+                if (inMatch) {
+                    current.blueScore = blue;
+                    current.orangeScore = orange;
+                }
+            } else if (event.kind == SessionEventKind::phase) {
+                MatchPhase phase = (MatchPhase)event.value;
+                if (!inMatch && isMatchPhase(phase)) {
+                    inMatch = true;
+                    current = MatchSummary();
+                    current.startMs = event.timeMs;
+                    lastBlue = lastOrange = 0;
+                } else if (inMatch && !isMatchPhase(phase) && phase != MatchPhase::unknown) {
+                    inMatch = false;
+                    current.endMs = event.timeMs;
+                    current.finished = phase == MatchPhase::postGame;
+                    matches.push_back(current);
+                }
+                if (inMatch && phase == MatchPhase::overtime) {
+                    current.overtime = true;
+                }
+            }
+        }
+        consumeFramesUntil(INT64_MAX);
+
+        if (inMatch) {
+            current.endMs = std::max(current.endMs, info.lastTimeMs);
+        }
+    }
+
+    // Recording stopped mid-match
+    if (inMatch) {
+        matches.push_back(current);
+    }
+
+    for (size_t i = 0; i < matches.size(); ++i) {
+        printMatch(i + 1, matches[i]);
+    }
+    totals.matches += matches.size();
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "Usage: %s <file-or-directory>...\n", argv[0]);
+        return 2;
+    }
+
+    // Directories are searched recursively for *.gsr, in name order
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i) {
+        std::error_code error;
+        if (fs::is_directory(argv[i], error)) {
+            for (const auto& entry : fs::recursive_directory_iterator(argv[i], error)) {
+                if (entry.is_regular_file() && entry.path().extension() == ".gsr") {
+                    paths.push_back(entry.path().string());
+                }
+            }
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+
+    auto start = std::chrono::steady_clock::now();
+    ScanTotals totals;
+    for (const std::string& path : paths) {
+        scanFile(path, totals);
+    }
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("\nScanned %zu files (%.1f MB), %zu matches, %llu frames in %.0f ms (%.0f MB/s)\n",
+                totals.files, totals.bytes / (1024.0 * 1024.0), totals.matches,
+                (unsigned long long)totals.frames, elapsedMs,
+                elapsedMs > 0 ? totals.bytes / (1024.0 * 1024.0) / (elapsedMs / 1000.0) : 0.0);
+    return totals.unreadable ? 1 : 0;
+}